@@ -44,6 +44,18 @@
  */
 #define ICLED_LED_COUNT     105
 
+/**
+ * @def ICLED_ROWS
+ * @brief LEDs per column, the pixel buffer is column-major (index = column * ICLED_ROWS + row).
+ */
+#define ICLED_ROWS          7
+
+/**
+ * @def ICLED_COLUMNS
+ * @brief Number of columns of the matrix.
+ */
+#define ICLED_COLUMNS       (ICLED_LED_COUNT / ICLED_ROWS)
+
 /**
  * @def ICLED_RESET_SLOTS
  * @brief Number of idle PWM slots to trigger the LED latch (>50µs).
@@ -84,6 +96,67 @@
 #define ICLED_PWM_0         13     // entspricht ca. 32% bei ARR = 39
 #define ICLED_PWM_1         26     // entspricht ca. 64% bei ARR = 39
 
+/**
+ * @def ICLED_OUTPUT_USART
+ * @brief 1 drives the LEDs from USART1 TX (PA9) instead of TIM1 CH1 (PA8).
+ *
+ * The USART sends 7-bit frames with inverted TX at ICLED_USART_BAUDRATE, one
+ * UART bit per third of an LED bit: the start bit is the high part every LED
+ * bit begins with and the stop bit the low part of the third bit of a frame,
+ * so a frame carries 3 LED bits and an LED takes 8 bytes instead of 48 in the
+ * PWM buffer. TIM1 stays free and the DMX512 receiver is switched off, it
+ * needs USART1 at 250 kbaud.
+ */
+#ifndef ICLED_OUTPUT_USART
+#define ICLED_OUTPUT_USART  0
+#endif
+
+/**
+ * @def ICLED_USART_BAUDRATE
+ * @brief UART bit rate of the USART output, three UART bits per LED bit.
+ *
+ * Rounded to the nearest divider with 8x oversampling (2.37 Mbaud at 32 MHz).
+ */
+#ifndef ICLED_USART_BAUDRATE
+#define ICLED_USART_BAUDRATE    2400000
+#endif
+
+/**
+ * @def ICLED_USART_KERNEL_HZ
+ * @brief USART1 kernel clock (PCLK2) the timing is checked against at compile time, see SystemClock_Config().
+ */
+#ifndef ICLED_USART_KERNEL_HZ
+#define ICLED_USART_KERNEL_HZ   32000000
+#endif
+
+/**
+ * @def ICLED_USART_LATCH_US
+ * @brief Idle time after the last byte left the DMA before the next frame may start.
+ *
+ * Includes the two UART frames still in the USART when the DMA completes.
+ */
+#define ICLED_USART_LATCH_US    250
+
+/**
+ * @def ICLED_USART_BUFFER_SIZE
+ * @brief Size of the USART output buffer, 8 UART frames per LED and no reset padding.
+ */
+#define ICLED_USART_BUFFER_SIZE (ICLED_LED_COUNT * 8)
+
+/**
+ * @name ICLED data input timing
+ * Windows of the ICLED datasheet the outputs have to hit (nanoseconds).
+ * @{
+ */
+#define ICLED_T0H_MIN_NS        200
+#define ICLED_T0H_MAX_NS        500
+#define ICLED_T1H_MIN_NS        550
+#define ICLED_T1H_MAX_NS        1000
+#define ICLED_BIT_PERIOD_MIN_NS 1000
+#define ICLED_BIT_PERIOD_MAX_NS 1600
+#define ICLED_LATCH_MIN_NS      200000
+/** @} */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -110,11 +183,93 @@ void ICLED_SetPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
  */
 void ICLED_Show(void);
 
+/**
+ * @brief Transfers a GRB buffer other than the pixel buffer to the LEDs.
+ *
+ * Used for frames that are computed from the pixel buffer (e.g. interpolation),
+ * the pixel buffer itself stays unchanged.
+ *
+ * @param grb ICLED_LED_COUNT entries of 3 bytes in GRB order.
+ */
+void ICLED_ShowBuffer(const uint8_t *grb);
+
 /**
  * @brief Turns off all LEDs.
  */
 void ICLED_Clear(void);
 
+/**
+ * @brief Returns the pixel buffer for direct (zero-copy) writes.
+ *
+ * The buffer holds ICLED_LED_COUNT entries of 3 bytes in GRB order.
+ * Call ICLED_Show() to apply the changes. A buffer scrolled with
+ * ICLED_ScrollColumns() is put back into index order first (one rotation).
+ *
+ * @return Pointer to the first byte of the pixel buffer.
+ */
+uint8_t *ICLED_GetBuffer(void);
+
+/**
+ * @brief Moves the content by whole columns without touching a pixel.
+ *
+ * The columns of the pixel buffer form a ring, this only moves its head;
+ * ICLED_SetPixel(), ICLED_GetColumn() and ICLED_Show() follow it. The columns
+ * that enter hold the ones that left on the other side, so a scroll step is
+ * this call plus drawing the new column.
+ *
+ * @param columns Columns to move, positive to the left (new columns enter at the right).
+ */
+void ICLED_ScrollColumns(int16_t columns);
+
+/**
+ * @brief Returns a column of the pixel buffer as shown on the matrix.
+ *
+ * @param column Column from the left (0 to ICLED_COLUMNS - 1).
+ * @return ICLED_ROWS entries of 3 bytes in GRB order, top row first, or NULL.
+ */
+uint8_t *ICLED_GetColumn(uint16_t column);
+
+/**
+ * @brief Returns the number of frames sent since ICLED_Init().
+ *
+ * @return Number of ICLED_Show() calls, wraps around at 2^32.
+ */
+uint32_t ICLED_GetFrameCount(void);
+
+/**
+ * @brief Checks whether a frame is on the wire.
+ *
+ * @param start_tick Receives the HAL tick of the transfer start, may be NULL.
+ * @return true from ICLED_Show() until the DMA reports transfer complete or an error.
+ */
+bool ICLED_IsBusy(uint32_t *start_tick);
+
+/**
+ * @brief Decodes the frame of the last ICLED_Show() from the PWM buffer.
+ *
+ * Returns exactly what went out on the wire, also for frames from
+ * ICLED_ShowBuffer(). Must not run concurrently with ICLED_Show().
+ *
+ * @param grb Destination for ICLED_LED_COUNT * 3 bytes.
+ * @return Frame count of the decoded frame (see ICLED_GetFrameCount()).
+ */
+uint32_t ICLED_ReadBack(uint8_t *grb);
+
+#if ICLED_OUTPUT_USART
+/**
+ * @brief Configures USART1 TX and DMA1 channel 4 for the LED output (ICLED_OUTPUT_USART).
+ *
+ * Called by ICLED_Init() and by the frame monitor after an incident. Stops
+ * in Error_Handler() if PCLK2 gives a timing outside the ICLED windows.
+ */
+void ICLED_USART_Setup(void);
+
+/**
+ * @brief DMA1 channel 4 interrupt handler, called from DMA1_Channel4_IRQHandler.
+ */
+void ICLED_USART_IRQHandler(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
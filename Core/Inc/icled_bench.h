@@ -0,0 +1,152 @@
+/**
+ * @file icled_bench.h
+ * @author MootSeeker
+ * @brief Frame pipeline benchmark with JSON lines output.
+ *
+ * Runs fixed scenarios (every demo effect, the stream decoders, a column
+ * scroll by moving the canvas and by moving a ring head, and compositing of 2, 4 and 8 layers at 105, 512 and 2048 LEDs)
+ * and reports per scenario one JSON line with the average render, encode
+ * and transmit start cycles per frame, the wire time, the achievable frame
+ * rate, the RAM high-water mark and the interrupt load.
+ *
+ * The same code runs on the target (DWT cycle counter, output on USART2) and
+ * in the host build (Host/bench, nanoseconds, output on stdout), the port
+ * passed to ICLED_Bench_Run() provides the clock and the output.
+ *
+ * The benchmark is only compiled with ICLED_BENCH=1, e.g. as preprocessor
+ * define of a separate build configuration.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_BENCH_H
+#define ICLED_BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def ICLED_BENCH
+ * @brief 1 builds the benchmark and lets main() run it once after start-up.
+ */
+#ifndef ICLED_BENCH
+#define ICLED_BENCH             0
+#endif
+
+/**
+ * @def ICLED_BENCH_FRAMES
+ * @brief Frames measured per scenario.
+ */
+#ifndef ICLED_BENCH_FRAMES
+#define ICLED_BENCH_FRAMES      100
+#endif
+
+/**
+ * @def ICLED_BENCH_MAX_LEDS
+ * @brief Largest canvas of the synthetic scenarios.
+ */
+#define ICLED_BENCH_MAX_LEDS    2048
+
+/**
+ * @def ICLED_BENCH_VERSION
+ * @brief Version of the scenario set and of the output format, bump it when either changes.
+ */
+#define ICLED_BENCH_VERSION     5
+
+/**
+ * @def ICLED_BENCH_ISR_ENTER
+ * @brief First statement of an interrupt handler, the benchmark adds up the time spent in handlers.
+ */
+/**
+ * @def ICLED_BENCH_ISR_EXIT
+ * @brief Last statement of an interrupt handler, pairs with ICLED_BENCH_ISR_ENTER().
+ */
+#if ICLED_BENCH
+#define ICLED_BENCH_ISR_ENTER()     ICLED_Bench_IsrEnter()
+#define ICLED_BENCH_ISR_EXIT()      ICLED_Bench_IsrExit()
+#else
+#define ICLED_BENCH_ISR_ENTER()
+#define ICLED_BENCH_ISR_EXIT()
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum ICLED_BenchMark
+ * @brief Points in ICLED_Show() the benchmark takes a time stamp at.
+ */
+typedef enum
+{
+    ICLED_BENCH_MARK_ENCODE = 0,    ///< Rendering done, the PWM encoding starts
+    ICLED_BENCH_MARK_TRANSMIT,      ///< Encoding done, the DMA is restarted
+    ICLED_BENCH_MARK_DONE,          ///< ICLED_Show() returns
+    ICLED_BENCH_MARK_COUNT
+} ICLED_BenchMark;
+
+/**
+ * @struct ICLED_BenchPort
+ * @brief Platform the benchmark runs on.
+ */
+typedef struct
+{
+    const char *target;                                 ///< Name in the output, e.g. "stm32l432"
+    uint32_t clock_hz;                                  ///< Frequency of cycles()
+    uint32_t (*cycles)(void);                           ///< Free-running counter, wraps at 32 bit
+    void (*write)(const char *line, uint16_t length);   ///< Sends one output line (with '\n')
+    uint32_t (*ram_used)(void);                         ///< RAM high-water mark in bytes, NULL if unknown
+    bool isr_hooks;                                     ///< The interrupt handlers call ICLED_BENCH_ISR_ENTER() / _EXIT(), false reports null
+} ICLED_BenchPort;
+
+/**
+ * @brief Runs all scenarios and writes one JSON line per scenario.
+ *
+ * Must be called after ICLED_Init() and ICLED_Stream_Init(). Takes a few
+ * seconds on the target, the matrix shows the frames of the LED scenarios.
+ *
+ * @param port Clock and output of the platform.
+ */
+void ICLED_Bench_Run(const ICLED_BenchPort *port);
+
+/**
+ * @brief Takes a time stamp, called from ICLED_Show() in the benchmark build.
+ *
+ * @param mark Point in the frame pipeline.
+ */
+void ICLED_Bench_Mark(ICLED_BenchMark mark);
+
+/**
+ * @brief Interrupt handler entered, only the outermost of nested handlers is timed.
+ */
+void ICLED_Bench_IsrEnter(void);
+
+/**
+ * @brief Interrupt handler left, adds its time to the running scenario.
+ */
+void ICLED_Bench_IsrExit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_BENCH_H */
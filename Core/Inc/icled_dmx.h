@@ -0,0 +1,139 @@
+/**
+ * @file icled_dmx.h
+ * @author MootSeeker
+ * @brief DMX512 receiver that drives the ICLED matrix from a lighting desk.
+ *
+ * USART1 (PA10, D0 on the Nucleo-32) receives the DMX512 line at 250 kbaud
+ * through an RS-485 transceiver. Every break re-arms a DMA capture of the
+ * start code and the slots up to the end of the configured footprint into
+ * one half of a double buffer. The mapped slots are shown as soon as the last
+ * needed slot arrived, so a frame is at most one DMX packet late.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_DMX_H
+#define ICLED_DMX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "icled.h"
+
+/**
+ * @def ICLED_DMX_SLOTS
+ * @brief Maximum number of slots in a DMX512 universe (without start code).
+ */
+#define ICLED_DMX_SLOTS         512
+
+/**
+ * @def ICLED_DMX_START_ADDRESS
+ * @brief Default DMX start address (1–512) of the first RGB slot.
+ */
+#ifndef ICLED_DMX_START_ADDRESS
+#define ICLED_DMX_START_ADDRESS 1
+#endif
+
+/**
+ * @def ICLED_DMX_SEGMENTS
+ * @brief Default number of RGB segments, the footprint is 3 slots per segment.
+ *
+ * ICLED_LED_COUNT maps one RGB triple per LED, 15 gives one per column (7 LEDs each).
+ */
+#ifndef ICLED_DMX_SEGMENTS
+#define ICLED_DMX_SEGMENTS      ICLED_LED_COUNT
+#endif
+
+/**
+ * @def ICLED_DMX_HOLD_MS
+ * @brief The input counts as active this long after the last frame (DMX loss of data is 1.25 s).
+ */
+#define ICLED_DMX_HOLD_MS       1250
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_DMXStats
+ * @brief Counters of the DMX receiver.
+ */
+typedef struct
+{
+    uint32_t breaks;        ///< Detected breaks (packets)
+    uint32_t frames;        ///< Shown frames
+    uint32_t ignored;       ///< Packets with a start code other than 0 (e.g. RDM, text)
+    uint32_t errors;        ///< Framing / noise errors inside a packet
+} ICLED_DMXStats;
+
+/**
+ * @brief Starts the DMX512 reception on USART1.
+ *
+ * Must be called after MX_USART1_UART_Init() and ICLED_Init(). Does nothing
+ * with ICLED_OUTPUT_USART, USART1 drives the LEDs then.
+ */
+void ICLED_DMX_Init(void);
+
+/**
+ * @brief Changes the slot mapping, takes effect with the next packet.
+ *
+ * The LEDs are split into @p segments equal runs (in LED index order), each
+ * segment takes 3 slots (R, G, B) starting at @p start_address.
+ *
+ * @param start_address First slot (1–512).
+ * @param segments      Number of RGB segments (1 to ICLED_LED_COUNT).
+ *
+ * @return true if the footprint fits into the universe, false otherwise.
+ */
+bool ICLED_DMX_SetMapping(uint16_t start_address, uint16_t segments);
+
+/**
+ * @brief Maps and shows a newly received frame.
+ *
+ * Call this from the main loop.
+ */
+void ICLED_DMX_Process(void);
+
+/**
+ * @brief Checks whether DMX frames are being received.
+ *
+ * @return true if a frame was shown within ICLED_DMX_HOLD_MS.
+ */
+bool ICLED_DMX_IsActive(void);
+
+/**
+ * @brief Copies the receiver counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_DMX_GetStats(ICLED_DMXStats *stats);
+
+/**
+ * @brief USART1 interrupt handler (break detection), called from USART1_IRQHandler.
+ */
+void ICLED_DMX_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_DMX_H */
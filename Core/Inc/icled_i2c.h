@@ -0,0 +1,173 @@
+/**
+ * @file icled_i2c.h
+ * @author MootSeeker
+ * @brief I2C slave register map to control the ICLED matrix from a host MCU.
+ *
+ * I2C1 listens as slave on ICLED_I2C_ADDRESS. A write starts with the register
+ * address followed by data bytes, a read returns the registers from the last
+ * written address on. The address increments with every byte in both
+ * directions, so a whole block (e.g. the pixel window) is one transfer.
+ * Both directions run on DMA, the CPU only sees the address match and the end
+ * of the transfer.
+ *
+ * The bytes of a write transfer are taken over at its STOP condition and
+ * applied together at the next frame boundary (ICLED_I2C_Process() in the main
+ * loop), so the effects never render a half written configuration. With
+ * ICLED_I2C_CONTROL_HOLD set, several transfers are collected and applied
+ * when the bit is cleared again. Reads return a snapshot taken at the address
+ * match, multi-byte counters are consistent.
+ *
+ * Pins (Nucleo-32): SCL = PB6 (D5), SDA = PB7 (D4), external pull-ups needed.
+ * Disconnect the solder bridges SB16/SB18 if A4/A5 are used.
+ *
+ * Register map (multi-byte values little endian):
+ *
+ * | Address | Name          | Access | Description                                  |
+ * |---------|---------------|--------|----------------------------------------------|
+ * | 0x00    | ID            | R      | ICLED_I2C_ID                                 |
+ * | 0x01    | VERSION       | R      | ICLED_I2C_VERSION                            |
+ * | 0x02    | CONTROL       | R/W    | ICLED_I2C_CONTROL_* bits                     |
+ * | 0x03    | EFFECT        | R/W    | Demo effect index                            |
+ * | 0x04    | BRIGHTNESS    | R/W    | Demo brightness, 0 = effect default          |
+ * | 0x05    | DELAY         | R/W    | uint16, demo frame delay in ms, 0 = default  |
+ * | 0x07    | DROP          | R/W    | LED index of a drop into the ripple effect   |
+ * | 0x08    | SEGMENT_START | R/W    | Segment written by window pixel 0            |
+ * | 0x09    | SEGMENTS      | R/W    | LEDs are split into this many segments       |
+ * | 0x0A    | LOAD          | R      | CPU load of the last second in %             |
+ * | 0x0B    | LOAD_PEAK     | R      | Highest load of the last 60 s in %           |
+ * | 0x0C    | HEADROOM      | R      | uint16, idle µs per frame, 0xFFFF = none     |
+ * | 0x10    | FRAMES        | R      | uint32, frames sent to the matrix            |
+ * | 0x14    | WRITES        | R      | uint32, applied write transfers              |
+ * | 0x18    | ERRORS        | R      | uint32, bus errors and dropped bytes         |
+ * | 0x1C    | UPTIME        | R      | uint32, milliseconds since reset             |
+ * | 0x20    | WINDOW        | R/W    | ICLED_I2C_WINDOW_PIXELS RGB triples          |
+ *
+ * In direct mode (ICLED_I2C_CONTROL_DIRECT) the demo effects stop and every
+ * applied write to the window sets segments SEGMENT_START.. and shows the
+ * frame. With SEGMENTS = 15 one window write fills all columns, with
+ * SEGMENTS = 105 (or 0) the window addresses single LEDs.
+ *
+ * At 400 kHz a full window write (50 bytes incl. address) takes ~1.3 ms.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_I2C_H
+#define ICLED_I2C_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def ICLED_I2C_ADDRESS
+ * @brief 7 bit slave address (must match the OwnAddress1 setting of MX_I2C1_Init()).
+ */
+#define ICLED_I2C_ADDRESS           0x42
+
+/**
+ * @def ICLED_I2C_ID
+ * @brief Value of the ID register.
+ */
+#define ICLED_I2C_ID                0x1C
+
+/**
+ * @def ICLED_I2C_VERSION
+ * @brief Value of the VERSION register, increments when the map changes.
+ */
+#define ICLED_I2C_VERSION           3
+
+/**
+ * @def ICLED_I2C_WINDOW_PIXELS
+ * @brief Number of RGB pixels in the window.
+ */
+#define ICLED_I2C_WINDOW_PIXELS     16
+
+#define ICLED_I2C_REG_ID            0x00
+#define ICLED_I2C_REG_VERSION       0x01
+#define ICLED_I2C_REG_CONTROL       0x02
+#define ICLED_I2C_REG_EFFECT        0x03
+#define ICLED_I2C_REG_BRIGHTNESS    0x04
+#define ICLED_I2C_REG_DELAY         0x05
+#define ICLED_I2C_REG_DROP          0x07
+#define ICLED_I2C_REG_SEGMENT_START 0x08
+#define ICLED_I2C_REG_SEGMENTS      0x09
+#define ICLED_I2C_REG_LOAD          0x0A
+#define ICLED_I2C_REG_LOAD_PEAK     0x0B
+#define ICLED_I2C_REG_HEADROOM      0x0C
+#define ICLED_I2C_REG_FRAMES        0x10
+#define ICLED_I2C_REG_WRITES        0x14
+#define ICLED_I2C_REG_ERRORS        0x18
+#define ICLED_I2C_REG_UPTIME        0x1C
+#define ICLED_I2C_REG_WINDOW        0x20
+#define ICLED_I2C_REG_COUNT         (ICLED_I2C_REG_WINDOW + ICLED_I2C_WINDOW_PIXELS * 3)
+
+#define ICLED_I2C_CONTROL_DIRECT    0x01    ///< Host draws through the window, the demos stop
+#define ICLED_I2C_CONTROL_HOLD      0x02    ///< Collect writes, apply them when the bit is cleared
+#define ICLED_I2C_CONTROL_CLEAR     0x80    ///< Turn all LEDs off (reads back as 0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_I2CStats
+ * @brief Counters of the I2C register map.
+ */
+typedef struct
+{
+    uint32_t writes;        ///< Applied write transfers
+    uint32_t errors;        ///< Bus errors and dropped bytes
+} ICLED_I2CStats;
+
+/**
+ * @brief Starts listening on I2C1.
+ *
+ * Must be called after MX_I2C1_Init() and ICLED_Init().
+ */
+void ICLED_I2C_Init(void);
+
+/**
+ * @brief Applies the registers written since the last call.
+ *
+ * Call this from the main loop, between two frames.
+ */
+void ICLED_I2C_Process(void);
+
+/**
+ * @brief Checks whether the host has taken over the matrix.
+ *
+ * @return true if ICLED_I2C_CONTROL_DIRECT is set.
+ */
+bool ICLED_I2C_IsActive(void);
+
+/**
+ * @brief Copies the counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_I2C_GetStats(ICLED_I2CStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_I2C_H */
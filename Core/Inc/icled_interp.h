@@ -0,0 +1,128 @@
+/**
+ * @file icled_interp.h
+ * @author MootSeeker
+ * @brief Frame interpolation between content frames at the LED output rate.
+ *
+ * Streamed content often arrives at 20-30 fps while the matrix can show
+ * ~294 fps. With ICLED_INTERP the frame inputs (USART2 stream, DMX, SPI)
+ * hand their frames to ICLED_Interp_Push() instead of showing them. The
+ * module keeps the previous and the next content frame and
+ * ICLED_Interp_Process() shows blended in-between frames whenever the LED
+ * output is free, so a fade takes one content frame period (measured from
+ * the arrival times) and the bandwidth on the wire stays the same.
+ *
+ * The blend is a fixed-point lerp with 8 bit weights, four channels per
+ * 32-bit word (SWAR, UXTB16 on the Cortex-M4). The output trails the content
+ * by one frame period; a frame after a pause of ICLED_INTERP_HOLD_MS or more
+ * is shown at once.
+ *
+ * With ICLED_INTERP_MOTION a horizontal shift by whole columns between two
+ * content frames (scrolling text) is detected and the in-between frames move
+ * the content by fractions of a column instead of cross-fading it.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_INTERP_H
+#define ICLED_INTERP_H
+
+#include <stdint.h>
+
+#include "icled.h"
+
+/**
+ * @def ICLED_INTERP
+ * @brief 1 interpolates the frame inputs, 0 shows every frame as it arrives.
+ */
+#ifndef ICLED_INTERP
+#define ICLED_INTERP                    0
+#endif
+
+/**
+ * @def ICLED_INTERP_MOTION
+ * @brief 1 moves scrolling content by fractions of a column instead of cross-fading it.
+ */
+#ifndef ICLED_INTERP_MOTION
+#define ICLED_INTERP_MOTION             0
+#endif
+
+/**
+ * @def ICLED_INTERP_HOLD_MS
+ * @brief A frame this long after the previous one is shown without interpolation.
+ */
+#define ICLED_INTERP_HOLD_MS            200
+
+/**
+ * @def ICLED_INTERP_MOTION_MAX
+ * @brief Largest detected shift in columns per content frame.
+ */
+#define ICLED_INTERP_MOTION_MAX         2
+
+/**
+ * @def ICLED_INTERP_MOTION_TOLERANCE
+ * @brief Mean difference per channel at which two shifted frames still count as the same content.
+ */
+#define ICLED_INTERP_MOTION_TOLERANCE   4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_InterpStats
+ * @brief Counters of the interpolation.
+ */
+typedef struct
+{
+    uint32_t keyframes;     ///< Content frames pushed
+    uint32_t frames;        ///< In-between frames shown
+    uint32_t moves;         ///< Content frames interpolated as a horizontal move
+    uint16_t period_ms;     ///< Measured content frame period, 0 before the second frame
+} ICLED_InterpStats;
+
+/**
+ * @brief The pixel buffer holds a new content frame.
+ *
+ * Called by the frame inputs instead of ICLED_Show(). Without ICLED_INTERP
+ * the frame is shown at once.
+ */
+void ICLED_Interp_Push(void);
+
+/**
+ * @brief Shows the next in-between frame once the LED output is free.
+ *
+ * Call this from the main loop.
+ */
+void ICLED_Interp_Process(void);
+
+/**
+ * @brief Copies the counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_Interp_GetStats(ICLED_InterpStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_INTERP_H */
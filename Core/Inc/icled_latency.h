@@ -0,0 +1,114 @@
+/**
+ * @file icled_latency.h
+ * @author MootSeeker
+ * @brief Input-to-photon latency of the frame inputs and the S2 button.
+ *
+ * Four DWT time stamps are taken per frame: the input (last byte of a USART2
+ * frame, SPI chip select rising edge, S2 button edge), render done (entry of
+ * ICLED_ShowBuffer()), DMA start and latch done (TIM1 DMA transfer complete,
+ * after the reset slots). Each latched frame that carries an input adds a
+ * sample to the histogram of its source in the telemetry block.
+ *
+ * An input is carried by the next frame that is rendered after it. A frame
+ * cut short by a newer one never latches, its inputs are carried over to the
+ * frame that replaced it, so dropped frames show up as longer latency.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_LATENCY_H
+#define ICLED_LATENCY_H
+
+#include <stdint.h>
+
+/**
+ * @def ICLED_LATENCY
+ * @brief 1 takes the time stamps and fills the latency part of the telemetry block.
+ */
+#ifndef ICLED_LATENCY
+#define ICLED_LATENCY               0
+#endif
+
+/**
+ * @def ICLED_LATENCY_BUCKETS
+ * @brief Histogram buckets per source.
+ */
+#define ICLED_LATENCY_BUCKETS       12
+
+/**
+ * @def ICLED_LATENCY_BUCKET_US
+ * @brief Upper bound of the first bucket, each further bucket doubles it (250 µs ... 256 ms and above).
+ */
+#define ICLED_LATENCY_BUCKET_US     250U
+
+/**
+ * @def ICLED_LATENCY_CYCLES_PER_US
+ * @brief Time stamp counts per microsecond.
+ */
+#ifndef ICLED_LATENCY_CYCLES_PER_US
+#define ICLED_LATENCY_CYCLES_PER_US ( SystemCoreClock / 1000000U )
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum ICLED_LatencySource
+ * @brief Inputs with their own histogram.
+ */
+typedef enum
+{
+    ICLED_LATENCY_STREAM = 0,   ///< Adalight, TPM2 and DDP frames on USART2
+    ICLED_LATENCY_SPI    = 1,   ///< SPI1 frames
+    ICLED_LATENCY_BUTTON = 2,   ///< S2 effect switch
+    ICLED_LATENCY_SOURCE_COUNT
+} ICLED_LatencySource;
+
+/**
+ * @brief Records the arrival of an input, interrupt safe.
+ *
+ * @param source Input source.
+ * @param cycles ICLED_TELEMETRY_CYCLES() at the arrival.
+ */
+void ICLED_Latency_Input(ICLED_LatencySource source, uint32_t cycles);
+
+/**
+ * @brief Render done, called by ICLED_ShowBuffer() before encoding.
+ */
+void ICLED_Latency_Render(void);
+
+/**
+ * @brief DMA start, called by ICLED_ShowBuffer() after the transfer was started.
+ */
+void ICLED_Latency_Start(void);
+
+/**
+ * @brief Latch done, called from the TIM1 DMA transfer complete interrupt.
+ */
+void ICLED_Latency_Latch(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_LATENCY_H */
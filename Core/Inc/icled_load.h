@@ -0,0 +1,122 @@
+/**
+ * @file icled_load.h
+ * @author MootSeeker
+ * @brief CPU load monitor based on idle-time accounting.
+ *
+ * Counts the core cycles (DWT CYCCNT) the main loop spends idle: waiting in
+ * HAL_Delay(), which this module replaces, and main loop passes that showed
+ * no frame while an input holds the matrix. Once per second the idle share
+ * is turned into a load sample:
+ *
+ * - load in % of the last second and the peak of the last ICLED_LOAD_WINDOW seconds,
+ * - idle time per shown frame (headroom: how much longer a frame could take),
+ * - a histogram of the samples in the window in ICLED_LOAD_BUCKETS steps.
+ *
+ * With ICLED_LOAD_SLEEP the idle time is spent in __WFI(), the next interrupt
+ * (at the latest the 1 ms SysTick) wakes the core. Interrupts that run while
+ * the core is idle count as idle time.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_LOAD_H
+#define ICLED_LOAD_H
+
+#include <stdint.h>
+
+/**
+ * @def ICLED_LOAD_SLEEP
+ * @brief 1 sleeps in __WFI() while idle, 0 keeps polling (lowest input latency).
+ */
+#ifndef ICLED_LOAD_SLEEP
+#define ICLED_LOAD_SLEEP    1
+#endif
+
+/**
+ * @def ICLED_LOAD_WINDOW
+ * @brief Number of one-second samples kept for the peak and the histogram.
+ */
+#define ICLED_LOAD_WINDOW   60
+
+/**
+ * @def ICLED_LOAD_BUCKETS
+ * @brief Histogram buckets, each covers 100 / ICLED_LOAD_BUCKETS percent.
+ */
+#define ICLED_LOAD_BUCKETS  10
+
+/**
+ * @def ICLED_LOAD_NO_FRAMES
+ * @brief Headroom reported for a second without frames.
+ */
+#define ICLED_LOAD_NO_FRAMES    UINT32_MAX
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_LoadStats
+ * @brief Load figures of the last second and of the window.
+ */
+typedef struct
+{
+    uint8_t load;                               ///< CPU load of the last second in %
+    uint8_t peak;                               ///< Highest load in the window in %
+    uint16_t fps;                               ///< Frames shown in the last second
+    uint32_t headroom_us;                       ///< Idle time per frame in µs, ICLED_LOAD_NO_FRAMES without frames
+    uint16_t samples;                           ///< Samples in the window (up to ICLED_LOAD_WINDOW)
+    uint16_t histogram[ICLED_LOAD_BUCKETS];     ///< Samples per load bucket, bucket 0 = 0–9 %
+} ICLED_LoadStats;
+
+/**
+ * @brief Starts the cycle counter and the first sample.
+ *
+ * Call this after ICLED_Init().
+ */
+void ICLED_Load_Init(void);
+
+/**
+ * @brief The current main loop pass had nothing to do.
+ *
+ * Counts the pass as idle and, with ICLED_LOAD_SLEEP, sleeps until the next interrupt.
+ */
+void ICLED_Load_Idle(void);
+
+/**
+ * @brief Closes the one-second sample when it is due.
+ *
+ * Call this at the end of every main loop pass.
+ */
+void ICLED_Load_Process(void);
+
+/**
+ * @brief Copies the load figures (safe to call from an interrupt).
+ *
+ * @param stats Destination for the figures.
+ */
+void ICLED_Load_GetStats(ICLED_LoadStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_LOAD_H */
@@ -0,0 +1,143 @@
+/**
+ * @file icled_mirror.h
+ * @author MootSeeker
+ * @brief Live mirror of the transmitted frames on USART2 TX.
+ *
+ * Sends what the matrix shows back out on the virtual COM port, so the
+ * content of a remote panel can be watched without a camera (Host/mirror).
+ * The frame is read back from the PWM buffer (ICLED_ReadBack()), so it is
+ * exactly what went out on the wire, whichever input or effect made it.
+ *
+ * Every packet looks like this, all fields are bytes:
+ *
+ *     'I' 'M' type seq len_lo len_hi payload[len] checksum
+ *
+ * - type 'K' (key frame): ICLED_LED_COUNT GRB pixels,
+ * - type 'D' (delta): runs of ( skip, count, count GRB pixels ) against the
+ *   previous packet; skip and count are pixels, a skip beyond 255 is sent
+ *   as ( 255, 0 ) runs first,
+ * - seq counts the packets, a receiver that sees a gap waits for the next
+ *   key frame,
+ * - checksum is the sum of type, seq, the length bytes and the payload.
+ *
+ * A frame without changes is not sent, a key frame goes out at least every
+ * ICLED_MIRROR_KEY_MS and whenever the delta would not be smaller.
+ *
+ * The mirror runs in the main loop and never waits: while the DMA still
+ * sends the previous packet, or the packets so far have used up the share
+ * of the line given by ICLED_MIRROR_SHARE, the frame waits and a newer one
+ * replaces it (counted as dropped in ICLED_MirrorStats). Once the line is
+ * free the latest frame is compared against the last one sent. ICLED_Show()
+ * is not touched at all.
+ *
+ * USART2 TX runs on DMA1 channel 7 (request 2), set up on register level
+ * next to the HAL UART that receives the stream on the same USART.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_MIRROR_H
+#define ICLED_MIRROR_H
+
+#include <stdint.h>
+
+#include "icled.h"
+
+/**
+ * @def ICLED_MIRROR
+ * @brief 1 sends the frames on USART2 TX.
+ */
+#ifndef ICLED_MIRROR
+#define ICLED_MIRROR                0
+#endif
+
+/**
+ * @def ICLED_MIRROR_DIVIDER
+ * @brief Mirrors every Nth frame at most.
+ */
+#ifndef ICLED_MIRROR_DIVIDER
+#define ICLED_MIRROR_DIVIDER        1
+#endif
+
+/**
+ * @def ICLED_MIRROR_SHARE
+ * @brief Percentage of the TX line time the mirror may use on average.
+ */
+#ifndef ICLED_MIRROR_SHARE
+#define ICLED_MIRROR_SHARE          50
+#endif
+
+/**
+ * @def ICLED_MIRROR_KEY_MS
+ * @brief Longest time between two key frames.
+ */
+#define ICLED_MIRROR_KEY_MS         1000
+
+/**
+ * @def ICLED_MIRROR_HEADER
+ * @brief Bytes before the payload ('I' 'M' type seq len_lo len_hi).
+ */
+#define ICLED_MIRROR_HEADER         6
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_MirrorStats
+ * @brief Counters of the mirror.
+ */
+typedef struct
+{
+    uint32_t keyframes;     ///< Key frames sent
+    uint32_t deltas;        ///< Delta packets sent
+    uint32_t unchanged;     ///< Frames equal to the last one sent, nothing to send
+    uint32_t dropped;       ///< Frames replaced by a newer one while the line was busy or rate limited
+    uint32_t bytes;         ///< Bytes handed to the DMA
+} ICLED_MirrorStats;
+
+/**
+ * @brief Sets up DMA1 channel 7 for USART2 TX.
+ *
+ * Call this after ICLED_Stream_Init(), which sets the baud rate.
+ */
+void ICLED_Mirror_Init(void);
+
+/**
+ * @brief Sends the latest frame if the line is free.
+ *
+ * Call this from the main loop.
+ */
+void ICLED_Mirror_Process(void);
+
+/**
+ * @brief Copies the counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_Mirror_GetStats(ICLED_MirrorStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_MIRROR_H */
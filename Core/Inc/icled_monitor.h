@@ -0,0 +1,114 @@
+/**
+ * @file icled_monitor.h
+ * @author MootSeeker
+ * @brief Frame deadline monitor and recovery of the LED output.
+ *
+ * Every frame that ICLED_Show() hands to the DMA has to reach transfer
+ * complete within ICLED_MONITOR_DEADLINE_MS. ICLED_Monitor_Process() checks
+ * this once per main loop pass and treats these cases as incidents:
+ *
+ * - deadline miss: the transfer complete interrupt did not come,
+ * - DMA error: the TIM1 DMA channel reported a transfer error,
+ * - start error: HAL_TIM_PWM_Start_DMA() refused to start,
+ * - stuck state: a transfer is pending but TIM1, its output or the DMA
+ *   channel is disabled.
+ *
+ * Each incident is counted in the telemetry block (icled_telemetry.h) and
+ * recovered without a reboot: TIM1 is reset, TIM1 CH1 and hdma_tim1_ch1 are
+ * initialised again by MX_TIM1_Init() and the current frame is sent again.
+ * With ICLED_OUTPUT_USART the same checks cover USART1 and DMA1 channel 4,
+ * a recovery resets USART1 and runs ICLED_USART_Setup().
+ *
+ * With ICLED_MONITOR_IWDG the independent watchdog runs as well. It is fed
+ * only while the output is healthy (no transfer pending or the pending one
+ * within its deadline) and fewer than ICLED_MONITOR_RETRIES recoveries in a
+ * row failed. A hung main loop or an output that recovery cannot fix ends in
+ * a watchdog reset (reset_flags in the telemetry block).
+ *
+ * The checks run in the main loop, so an incident is found after the pass
+ * that is running, at most one demo step (about 100 ms) later.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_MONITOR_H
+#define ICLED_MONITOR_H
+
+#include <stdint.h>
+
+#include "icled.h"
+
+/**
+ * @def ICLED_MONITOR_DEADLINE_MS
+ * @brief Time a frame may take from the DMA start to transfer complete.
+ *
+ * The wire time (1.25 µs per PWM slot, 3.4 ms for 105 LEDs) rounded down,
+ * plus 2 ms for the 1 ms tick resolution.
+ */
+#define ICLED_MONITOR_DEADLINE_MS   ((ICLED_BUFFER_SIZE * 5U / 4000U) + 2U)
+
+/**
+ * @def ICLED_MONITOR_RETRIES
+ * @brief Failed recoveries in a row after which the watchdog is no longer fed.
+ */
+#define ICLED_MONITOR_RETRIES       3
+
+/**
+ * @def ICLED_MONITOR_IWDG
+ * @brief 1 starts the independent watchdog in ICLED_Monitor_Init().
+ *
+ * Once started it cannot be stopped until the next reset. It is frozen while
+ * the core is halted by a debugger.
+ */
+#ifndef ICLED_MONITOR_IWDG
+#define ICLED_MONITOR_IWDG          0
+#endif
+
+/**
+ * @def ICLED_MONITOR_IWDG_MS
+ * @brief Watchdog timeout, longer than the longest main loop pass (1–4095 ms).
+ */
+#define ICLED_MONITOR_IWDG_MS       1000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Takes the current incident counters as reference and starts the watchdog.
+ *
+ * Call this after ICLED_Init() and ICLED_Telemetry_Init().
+ */
+void ICLED_Monitor_Init(void);
+
+/**
+ * @brief Checks the frame on the wire and recovers the output after an incident.
+ *
+ * Call this from the main loop.
+ */
+void ICLED_Monitor_Process(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_MONITOR_H */
@@ -0,0 +1,86 @@
+/**
+ * @file icled_pixfmt.h
+ * @author MootSeeker
+ * @brief Conversion of incoming pixel formats into the GRB pixel buffer.
+ *
+ * Hosts send RGB, BGR, RGBW or RGB565 while the LEDs take GRB. The kernels
+ * convert whole runs of pixels straight from the receive buffer into the
+ * pixel buffer, 4 pixels (12 to 16 input bytes) per iteration, with 32-bit
+ * loads and stores at any alignment:
+ *
+ * | Format | Bytes | Kernel                                                   |
+ * |--------|-------|----------------------------------------------------------|
+ * | GRB    | 3     | memcpy()                                                 |
+ * | RGB    | 3     | 3 words in, byte swaps within the words (REV16, PKHBT)   |
+ * | BGR    | 3     | 3 words in, byte rotation across the words               |
+ * | RGBW   | 4     | W added to R, G and B with per-byte saturation (UQADD8)  |
+ * | RGB565 | 2     | two pixels per word, 5/6 bit fields widened in parallel  |
+ *
+ * RGB565 is little endian (low byte first), as a PC or an MCU stores it.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_PIXFMT_H
+#define ICLED_PIXFMT_H
+
+#include <stdint.h>
+
+/**
+ * @enum ICLED_PixFmt
+ * @brief Pixel formats of incoming frames.
+ */
+typedef enum
+{
+    ICLED_PIXFMT_GRB,       ///< Native order of the LEDs
+    ICLED_PIXFMT_RGB,
+    ICLED_PIXFMT_BGR,
+    ICLED_PIXFMT_RGBW,      ///< White is added to all three colours
+    ICLED_PIXFMT_RGB565     ///< 16 bit, little endian
+} ICLED_PixFmt;
+
+/**
+ * @def ICLED_PIXFMT_BYTES
+ * @brief Bytes per pixel of a format.
+ */
+#define ICLED_PIXFMT_BYTES(format)  ( ( (format) == ICLED_PIXFMT_RGBW ) ? 4U : \
+                                      ( (format) == ICLED_PIXFMT_RGB565 ) ? 2U : 3U )
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Converts pixels into GRB.
+ *
+ * @param format Format of @p src.
+ * @param grb    Destination, 3 bytes per pixel, any alignment.
+ * @param src    Source pixels, ICLED_PIXFMT_BYTES( format ) bytes each, any alignment.
+ * @param pixels Number of pixels.
+ */
+void ICLED_PixFmt_Convert(ICLED_PixFmt format, uint8_t *grb, const uint8_t *src, uint16_t pixels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_PIXFMT_H */
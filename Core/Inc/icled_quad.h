@@ -0,0 +1,202 @@
+/**
+ * @file icled_quad.h
+ * @author MootSeeker
+ * @brief Four-lane LED output on the QUADSPI peripheral.
+ *
+ * Drives four LED chains at once from one DMA stream, without TIM1. Each
+ * QUADSPI clock puts one nibble on IO0 ... IO3, one bit per chain, so a
+ * chain gets one slot per clock and an LED bit is three slots (100 / 110,
+ * like the 3-bit SPI symbols of the Featherwing library):
+ *
+ *     nibble F, nibble d, nibble 0      d = bit of chain 0 ... 3 on IO0 ... IO3
+ *
+ * The encoder transposes the same colour byte of the four chains into eight
+ * such data nibbles at once, 12 bytes of QUADSPI data for a colour byte of
+ * the four chains: 9 bytes per LED, against 48 in the PWM buffer.
+ *
+ * Pins (AF10): IO0 = PB1 (chain 0), IO1 = PB0 (chain 1), IO2 = PA7 (chain 2),
+ * IO3 = PA6 (chain 3). CLK and NCS are not needed. PB0 and PA7 are the SPI
+ * frame input and the QUADSPI DMA request (DMA1 channel 5) is the one of the
+ * DMX512 receiver, both inputs are off with ICLED_QUAD.
+ *
+ * At 32 MHz and ICLED_QUAD_PRESCALER 12 a slot is 406 ns, a frame of 4 x 105
+ * LEDs takes 3.1 ms on the wire, as long as one chain of 105 LEDs on TIM1.
+ *
+ * With ICLED_QUAD_MIRROR the main loop repeats every new matrix frame on the
+ * four chains (ICLED_Quad_Process()); without it the chains only show what
+ * the application writes through ICLED_Quad_SetPixel() / ICLED_Quad_GetBuffer().
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_QUAD_H
+#define ICLED_QUAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "icled.h"
+
+/**
+ * @def ICLED_QUAD
+ * @brief 1 enables the four-lane output on QUADSPI.
+ */
+#ifndef ICLED_QUAD
+#define ICLED_QUAD                  0
+#endif
+
+/**
+ * @def ICLED_QUAD_CHAINS
+ * @brief Number of chains, one per QUADSPI data line.
+ */
+#define ICLED_QUAD_CHAINS           4
+
+/**
+ * @def ICLED_QUAD_LEDS
+ * @brief LEDs per chain.
+ */
+#ifndef ICLED_QUAD_LEDS
+#define ICLED_QUAD_LEDS             ICLED_LED_COUNT
+#endif
+
+/**
+ * @def ICLED_QUAD_PRESCALER
+ * @brief QUADSPI clock = HCLK / ( ICLED_QUAD_PRESCALER + 1 ), one slot per clock.
+ */
+#ifndef ICLED_QUAD_PRESCALER
+#define ICLED_QUAD_PRESCALER        12
+#endif
+
+/**
+ * @def ICLED_QUAD_KERNEL_HZ
+ * @brief HCLK the timing is checked against at compile time, see SystemClock_Config().
+ */
+#ifndef ICLED_QUAD_KERNEL_HZ
+#define ICLED_QUAD_KERNEL_HZ        32000000
+#endif
+
+/**
+ * @def ICLED_QUAD_MIRROR
+ * @brief 1 lets ICLED_Quad_Process() copy each new matrix frame into all four chains.
+ */
+#ifndef ICLED_QUAD_MIRROR
+#define ICLED_QUAD_MIRROR           1
+#endif
+
+/**
+ * @def ICLED_QUAD_LATCH_US
+ * @brief Idle time after the transfer complete before the next frame may start.
+ */
+#define ICLED_QUAD_LATCH_US         250
+
+/**
+ * @def ICLED_QUAD_BUFFER_SIZE
+ * @brief QUADSPI data per frame, 24 bits of 3 nibbles for each LED of the four chains.
+ */
+#define ICLED_QUAD_BUFFER_SIZE      ( ICLED_QUAD_LEDS * 3 * 12 )
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_QuadStats
+ * @brief Counters of the four-lane output.
+ */
+typedef struct
+{
+    uint32_t frames;            ///< Frames handed to the DMA
+    uint32_t completed;         ///< Frames the QUADSPI reported complete
+    uint32_t dropped;           ///< Frames cut short by the next ICLED_Quad_Show()
+    uint32_t errors;            ///< QUADSPI transfer errors
+    uint32_t encode_cycles;     ///< Cycles of the last transposition
+} ICLED_QuadStats;
+
+/**
+ * @brief Configures QUADSPI, its pins and DMA1 channel 5 and clears the four chains.
+ *
+ * Stops in Error_Handler() if HCLK gives a timing outside the ICLED windows.
+ * Does nothing without ICLED_QUAD.
+ */
+void ICLED_Quad_Init(void);
+
+/**
+ * @brief Sets the color of an LED of a chain.
+ *
+ * @param chain Chain (0 to ICLED_QUAD_CHAINS - 1), IO0 ... IO3.
+ * @param index LED of the chain (0 to ICLED_QUAD_LEDS - 1).
+ * @param r     Red component (0–255).
+ * @param g     Green component (0–255).
+ * @param b     Blue component (0–255).
+ */
+void ICLED_Quad_SetPixel(uint8_t chain, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Returns the pixel buffer of a chain for direct writes.
+ *
+ * @param chain Chain (0 to ICLED_QUAD_CHAINS - 1).
+ * @return ICLED_QUAD_LEDS entries of 3 bytes in GRB order, NULL without ICLED_QUAD.
+ */
+uint8_t *ICLED_Quad_GetBuffer(uint8_t chain);
+
+/**
+ * @brief Transposes the four chains into the QUADSPI buffer and sends them.
+ *
+ * A frame still in its latch time is waited for, one still on the wire is
+ * cut short (dropped).
+ */
+void ICLED_Quad_Show(void);
+
+/**
+ * @brief Repeats a new matrix frame on the four chains (ICLED_QUAD_MIRROR).
+ *
+ * Called from the main loop. Reads the matrix column by column as it is
+ * shown, so a scrolled pixel buffer is not rotated back. A frame arriving
+ * while the chains are busy is sent once they are free, the chains never
+ * cut a frame short. Does nothing without ICLED_QUAD or ICLED_QUAD_MIRROR.
+ */
+void ICLED_Quad_Process(void);
+
+/**
+ * @brief Checks whether a frame is on the wire or in its latch time.
+ *
+ * @return true from ICLED_Quad_Show() until ICLED_QUAD_LATCH_US after the transfer complete.
+ */
+bool ICLED_Quad_IsBusy(void);
+
+/**
+ * @brief Copies the counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_Quad_GetStats(ICLED_QuadStats *stats);
+
+/**
+ * @brief QUADSPI interrupt handler, called from QUADSPI_IRQHandler.
+ */
+void ICLED_Quad_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_QUAD_H */
@@ -0,0 +1,138 @@
+/**
+ * @file icled_ripple.h
+ * @author MootSeeker
+ * @brief Water ripples from an integer 2D wave equation.
+ *
+ * Two height fields, the current and the previous step, are advanced with the
+ * damped discrete wave equation
+ *
+ *     next = ( ( left + right + up + down ) >> 1 ) - previous
+ *     next = clamp( next - ( next >> ICLED_RIPPLE_DAMPING ) )
+ *
+ * and next overwrites previous in place. Heights are int16 rows clamped to
+ * 14 bits, so the neighbour sum never leaves 16 bits and two cells are
+ * processed side by side in a word (SADD16, SHADD16, SSUB16 and SSAT16 on
+ * the Cortex-M4). A border of one zero cell around the field keeps the
+ * kernel free of edge cases; waves reflect at the edges.
+ *
+ * The fields come from the caller, so one solver serves the 7x15 matrix as
+ * well as larger canvases, and a step costs the same per cell at any size.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_RIPPLE_H
+#define ICLED_RIPPLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def ICLED_RIPPLE_DAMPING
+ * @brief Each step takes 1 / 2^ICLED_RIPPLE_DAMPING of the height away, larger values ring longer.
+ */
+#ifndef ICLED_RIPPLE_DAMPING
+#define ICLED_RIPPLE_DAMPING        5
+#endif
+
+/**
+ * @def ICLED_RIPPLE_HEIGHT_MAX
+ * @brief Heights are clamped to -ICLED_RIPPLE_HEIGHT_MAX - 1 ... ICLED_RIPPLE_HEIGHT_MAX (14 bits).
+ */
+#define ICLED_RIPPLE_HEIGHT_MAX     8191
+
+/**
+ * @def ICLED_RIPPLE_CELLS
+ * @brief Cells of one height field for a canvas of @p width x @p rows, border included.
+ */
+#define ICLED_RIPPLE_CELLS(width, rows)     ( ( (width) + 2U ) * ( (rows) + 2U ) )
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_Ripple
+ * @brief State of one water surface.
+ */
+typedef struct
+{
+    int16_t *current;       ///< Heights of the last step, row-major with border
+    int16_t *previous;      ///< Heights of the step before, overwritten by the next one
+    uint16_t width;         ///< Columns of the canvas
+    uint16_t rows;          ///< Rows of the canvas
+    uint32_t seed;          ///< State of the random source of ICLED_Ripple_Rain()
+} ICLED_Ripple;
+
+/**
+ * @brief Sets up a calm surface.
+ *
+ * @param ripple  State to set up.
+ * @param fields  2 * ICLED_RIPPLE_CELLS( width, rows ) heights.
+ * @param width   Columns of the canvas.
+ * @param rows    Rows of the canvas.
+ */
+void ICLED_Ripple_Init(ICLED_Ripple *ripple, int16_t *fields, uint16_t width, uint16_t rows);
+
+/**
+ * @brief Drops a stone into the water.
+ *
+ * @param ripple   Surface.
+ * @param x        Column (0 to width - 1).
+ * @param y        Row (0 to rows - 1).
+ * @param strength Depth of the dent, up to ICLED_RIPPLE_HEIGHT_MAX.
+ */
+void ICLED_Ripple_Drop(ICLED_Ripple *ripple, uint16_t x, uint16_t y, int16_t strength);
+
+/**
+ * @brief Drops a stone at a random place, with a chance of @p chance / 256.
+ *
+ * Uses its own xorshift state (seeded by ICLED_Ripple_Init()), rand() of the
+ * other effects is not touched.
+ *
+ * @param ripple   Surface.
+ * @param chance   Chance of a drop per call in 1/256.
+ * @param strength Depth of the dent, see ICLED_Ripple_Drop().
+ * @return true if a drop fell.
+ */
+bool ICLED_Ripple_Rain(ICLED_Ripple *ripple, uint8_t chance, int16_t strength);
+
+/**
+ * @brief Advances the surface by one step.
+ */
+void ICLED_Ripple_Step(ICLED_Ripple *ripple);
+
+/**
+ * @brief Colours the surface through the water palette.
+ *
+ * @param ripple     Surface.
+ * @param grb        Destination, width * rows entries of 3 bytes in GRB order,
+ *                   column-major like the pixel buffer (index = x * rows + y).
+ * @param brightness Brightness of the brightest crest (0-255).
+ */
+void ICLED_Ripple_Render(const ICLED_Ripple *ripple, uint8_t *grb, uint8_t brightness);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_RIPPLE_H */
@@ -0,0 +1,122 @@
+/**
+ * @file icled_spi.h
+ * @author MootSeeker
+ * @brief SPI slave frame input for a host processor (e.g. a Linux SBC).
+ *
+ * SPI1 runs as receive-only slave (mode 0, MSB first, 8 bit) with hardware
+ * chip select. Each frame is one CS low phase of ICLED_SPI_FRAME_BYTES bytes
+ * in ICLED_SPI_FORMAT, captured by DMA into one of three buffers. The rising
+ * edge of CS hands the buffer over and re-arms the DMA into one that is
+ * neither waiting nor being read; the frame is shown on the next call of
+ * ICLED_SPI_Process() from the main loop.
+ *
+ * Pins (Nucleo-32): SCK = PA1 (A1), MOSI = PA7 (A6), CS = PB0 (D3).
+ *
+ * At 10 Mbit/s a 315 byte RGB frame takes 252 µs on the bus, the LED output
+ * (3.4 ms per frame) stays the limit at ~294 fps. Keep CS high for at least
+ * 10 µs between frames so the interrupt can re-arm the DMA.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_SPI_H
+#define ICLED_SPI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "icled.h"
+#include "icled_pixfmt.h"
+
+/**
+ * @def ICLED_SPI_FORMAT
+ * @brief Pixel format the host sends (an ICLED_PixFmt value).
+ */
+#ifndef ICLED_SPI_FORMAT
+#define ICLED_SPI_FORMAT        ICLED_PIXFMT_RGB
+#endif
+
+/**
+ * @def ICLED_SPI_FRAME_BYTES
+ * @brief Bytes per frame, one pixel per LED in LED index order.
+ */
+#define ICLED_SPI_FRAME_BYTES   (ICLED_LED_COUNT * ICLED_PIXFMT_BYTES(ICLED_SPI_FORMAT))
+
+/**
+ * @def ICLED_SPI_HOLD_MS
+ * @brief The input counts as active this long after the last shown frame.
+ */
+#define ICLED_SPI_HOLD_MS       1000
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_SPIStats
+ * @brief Counters of the SPI frame input.
+ */
+typedef struct
+{
+    uint32_t frames;        ///< Complete frames received
+    uint32_t shown;         ///< Frames shown (less than frames if the host is faster than the main loop)
+    uint32_t errors;        ///< CS phases with fewer bytes than a frame
+} ICLED_SPIStats;
+
+/**
+ * @brief Configures SPI1, its DMA and the chip select interrupt.
+ *
+ * Must be called after ICLED_Init().
+ */
+void ICLED_SPI_Init(void);
+
+/**
+ * @brief Shows the latest complete frame, if there is a new one.
+ *
+ * Call this from the main loop.
+ */
+void ICLED_SPI_Process(void);
+
+/**
+ * @brief Checks whether the host is sending frames.
+ *
+ * @return true if a frame was shown within ICLED_SPI_HOLD_MS.
+ */
+bool ICLED_SPI_IsActive(void);
+
+/**
+ * @brief Copies the counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_SPI_GetStats(ICLED_SPIStats *stats);
+
+/**
+ * @brief Chip select rising edge, called from EXTI0_IRQHandler.
+ */
+void ICLED_SPI_ChipSelectHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_SPI_H */
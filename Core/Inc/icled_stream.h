@@ -0,0 +1,170 @@
+/**
+ * @file icled_stream.h
+ * @author MootSeeker
+ * @brief Decoders for PC-side LED streaming protocols on USART2.
+ *
+ * Receives Adalight, TPM2 and DDP frames on the ST-LINK virtual COM port
+ * (USART2, RX via circular DMA). The protocol is detected per frame from its
+ * header bytes, pixel data is converted (icled_pixfmt.h) straight into the
+ * ICLED pixel buffer and ICLED_Show() is only called once a frame is complete.
+ * Adalight and TPM2 frames use ICLED_STREAM_FORMAT, DDP frames name their
+ * format in the header (RGB or RGBW, 8 bit).
+ *
+ * Throughput with 105 LEDs (8N1, 10 bit times per byte, calculated):
+ *
+ * | Baud rate | Adalight (321 B) | TPM2 (320 B) | DDP (325 B) |
+ * |-----------|------------------|--------------|-------------|
+ * |    115200 |         35.9 fps |     36.0 fps |    35.4 fps |
+ * |    230400 |         71.8 fps |     72.0 fps |    70.9 fps |
+ * |    460800 |        143.6 fps |    144.0 fps |   141.8 fps |
+ * |    921600 |        287.1 fps |    288.0 fps |   283.6 fps |
+ * |   1000000 |        311.5 fps |    312.5 fps |   307.7 fps |
+ * |   2000000 |        623.1 fps |    625.0 fps |   615.4 fps |
+ *
+ * The LED output itself needs ICLED_BUFFER_SIZE * 1.25 µs = 3.4 ms per frame
+ * (~294 fps), so from ~921600 baud on the matrix and not the UART is the limit.
+ * Use ICLED_Stream_GetStats() to measure the frame rate on the target.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_STREAM_H
+#define ICLED_STREAM_H
+
+#include "icled_pixfmt.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def ICLED_STREAM_BAUDRATE
+ * @brief Baud rate of USART2 while streaming (up to 2 Mbaud with the 16 MHz HSI).
+ */
+#ifndef ICLED_STREAM_BAUDRATE
+#define ICLED_STREAM_BAUDRATE   115200
+#endif
+
+/**
+ * @def ICLED_STREAM_RX_SIZE
+ * @brief Size of the circular DMA receive buffer in bytes.
+ */
+#define ICLED_STREAM_RX_SIZE    512
+
+/**
+ * @def ICLED_STREAM_TIMEOUT_MS
+ * @brief A frame that stalls longer than this is dropped and the decoder resyncs.
+ */
+#define ICLED_STREAM_TIMEOUT_MS 50
+
+/**
+ * @def ICLED_STREAM_HOLD_MS
+ * @brief The stream counts as active for this long after the last shown frame.
+ */
+#define ICLED_STREAM_HOLD_MS    2000
+
+/**
+ * @def ICLED_STREAM_FORMAT
+ * @brief Pixel format of Adalight and TPM2 frames (an ICLED_PixFmt value).
+ */
+#ifndef ICLED_STREAM_FORMAT
+#define ICLED_STREAM_FORMAT     ICLED_PIXFMT_RGB
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum ICLED_StreamProtocol
+ * @brief Supported streaming protocols.
+ */
+typedef enum
+{
+    ICLED_STREAM_ADALIGHT = 0,  ///< "Ada" + count + checksum, pixel data
+    ICLED_STREAM_TPM2     = 1,  ///< 0xC9 0xDA + size, pixel data, 0x36
+    ICLED_STREAM_DDP      = 2,  ///< 10/14 byte DDP header, RGB or RGBW data at offset
+    ICLED_STREAM_PROTOCOL_COUNT
+} ICLED_StreamProtocol;
+
+/**
+ * @struct ICLED_StreamStats
+ * @brief Counters of the stream decoders.
+ */
+typedef struct
+{
+    uint32_t bytes;                                 ///< Received bytes
+    uint32_t frames[ICLED_STREAM_PROTOCOL_COUNT];   ///< Shown frames per protocol
+    uint32_t errors;                                ///< Invalid headers, bad trailers and timeouts
+} ICLED_StreamStats;
+
+/**
+ * @brief Starts the circular DMA reception on USART2.
+ *
+ * Must be called after MX_USART2_UART_Init() and ICLED_Init().
+ * Sends "Ada\n" once so Adalight hosts waiting for the handshake can start.
+ */
+void ICLED_Stream_Init(void);
+
+/**
+ * @brief USART2 interrupt handler, called from USART2_IRQHandler().
+ *
+ * The interrupt is only enabled with ICLED_LATENCY (idle line detection).
+ */
+void ICLED_Stream_IRQHandler(void);
+
+/**
+ * @brief Decodes all bytes received since the last call.
+ *
+ * Call this from the main loop. Complete frames are shown immediately.
+ */
+void ICLED_Stream_Process(void);
+
+/**
+ * @brief Decodes bytes that did not arrive on USART2, e.g. from a benchmark.
+ *
+ * Shares the decoder state with ICLED_Stream_Process(), do not mix both
+ * while a host is streaming.
+ *
+ * @param data   Received bytes.
+ * @param length Number of bytes.
+ */
+void ICLED_Stream_Feed(const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Checks whether a host is currently streaming.
+ *
+ * @return true if a frame was shown within ICLED_STREAM_HOLD_MS.
+ */
+bool ICLED_Stream_IsActive(void);
+
+/**
+ * @brief Copies the decoder counters.
+ *
+ * @param stats Destination for the counters.
+ */
+void ICLED_Stream_GetStats(ICLED_StreamStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_STREAM_H */
@@ -0,0 +1,176 @@
+/**
+ * @file icled_telemetry.h
+ * @author MootSeeker
+ * @brief Memory-mapped telemetry block for debug probes and host tools.
+ *
+ * The block lives in its own linker section (.telemetry) at the start of
+ * SRAM2, ICLED_TELEMETRY_ADDRESS. A probe reads it while the firmware runs
+ * (e.g. `st-flash read telemetry.bin 0x10000000 512`, then
+ * `Host/icled_telemetry telemetry.bin`), nothing is sent over a UART and
+ * nothing in the firmware waits for a reader.
+ *
+ * All fields are independent little endian 32-bit words with one writer
+ * each, so a reader sees every field either before or after an update and
+ * no locks are needed. The LED output fields are written where they happen
+ * (ICLED_Show() and the TIM1 DMA interrupt); the input, CPU and RAM fields
+ * are mirrored from the module counters by ICLED_Telemetry_Process() once
+ * per main loop pass. Fields are only appended, ICLED_TELEMETRY_VERSION
+ * changes with every layout change.
+ *
+ * SRAM2 is not cleared by the start-up code and keeps its content over a
+ * reset, the boot counter and the reset flags use that.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the \"Software\"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ICLED_TELEMETRY_H
+#define ICLED_TELEMETRY_H
+
+#include <stdint.h>
+
+#include "icled_latency.h"
+
+/**
+ * @def ICLED_TELEMETRY_ADDRESS
+ * @brief Address of the block (start of SRAM2, see STM32L432KCUX_FLASH.ld).
+ */
+#define ICLED_TELEMETRY_ADDRESS     0x10000000UL
+
+/**
+ * @def ICLED_TELEMETRY_MAGIC
+ * @brief First word of a valid block, "ICLT" in memory.
+ */
+#define ICLED_TELEMETRY_MAGIC       0x544C4349UL
+
+/**
+ * @def ICLED_TELEMETRY_VERSION
+ * @brief Layout version, increments when fields are added.
+ */
+#define ICLED_TELEMETRY_VERSION     3
+
+/**
+ * @def ICLED_TELEMETRY_CYCLES
+ * @brief Cycle counter for the timing fields.
+ */
+#ifndef ICLED_TELEMETRY_CYCLES
+#define ICLED_TELEMETRY_CYCLES()    ( DWT->CYCCNT )
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct ICLED_TelemetryLatency
+ * @brief Input-to-photon latency of one input source, see icled_latency.h.
+ */
+typedef struct
+{
+    uint32_t samples;               ///< Latched frames that carried an input of this source
+    uint32_t last_us;               ///< Input to latch done of the last sample
+    uint32_t max_us;                ///< Longest input to latch done
+    uint32_t render_us;             ///< Last sample: input to render done
+    uint32_t start_us;              ///< Last sample: render done to DMA start
+    uint32_t histogram[ICLED_LATENCY_BUCKETS];  ///< Bucket b: below ICLED_LATENCY_BUCKET_US << b, the last one all longer
+} ICLED_TelemetryLatency;
+
+/**
+ * @struct ICLED_Telemetry
+ * @brief Layout of the telemetry block.
+ */
+typedef struct
+{
+    /* Header */
+    uint32_t magic;                 ///< ICLED_TELEMETRY_MAGIC once initialized
+    uint16_t version;               ///< ICLED_TELEMETRY_VERSION
+    uint16_t size;                  ///< sizeof( ICLED_Telemetry )
+    uint32_t boots;                 ///< Starts since power-up (kept over resets)
+    uint32_t reset_flags;           ///< RCC_CSR reset flags of the last start
+    uint32_t uptime_ms;             ///< HAL tick
+
+    /* LED output */
+    uint32_t frames;                ///< Frames started by ICLED_Show()
+    uint32_t frames_completed;      ///< Transfers that reached transfer complete
+    uint32_t frames_dropped;        ///< Frames started while the previous transfer was still running
+    uint32_t dma_errors;            ///< TIM1 DMA transfer errors
+    uint32_t encode_cycles;         ///< PWM encoding of the last frame
+    uint32_t encode_cycles_max;     ///< Longest PWM encoding
+    uint32_t transmit_cycles;       ///< DMA restart of the last frame
+
+    /* Inputs */
+    uint32_t uart_bytes;            ///< USART2 stream bytes
+    uint32_t uart_frames;           ///< Adalight, TPM2 and DDP frames shown
+    uint32_t uart_errors;           ///< Bad headers, checksums and trailers, timeouts
+    uint32_t dmx_packets;           ///< DMX breaks
+    uint32_t dmx_frames;            ///< DMX frames shown
+    uint32_t dmx_errors;            ///< DMX framing and noise errors
+    uint32_t spi_frames;            ///< Complete SPI frames
+    uint32_t spi_errors;            ///< Short SPI frames
+    uint32_t i2c_writes;            ///< Applied I2C write transfers
+    uint32_t i2c_errors;            ///< I2C bus errors and dropped bytes
+
+    /* CPU and RAM */
+    uint32_t cpu_load;              ///< CPU load of the last second in %
+    uint32_t headroom_us;           ///< Idle time per frame in µs
+    uint32_t ram_static;            ///< .data and .bss in bytes
+    uint32_t stack_hwm;             ///< Deepest stack use since start in bytes
+
+    /* Frame monitor (version 2) */
+    uint32_t start_errors;          ///< DMA starts refused by the HAL
+    uint32_t deadline_misses;       ///< Transfers without transfer complete by their deadline
+    uint32_t stuck_states;          ///< Transfers with the timer or the DMA channel found disabled
+    uint32_t recoveries;            ///< Reinitialisations of TIM1 CH1 and its DMA channel
+    uint32_t last_incident_ms;      ///< Uptime of the last incident
+
+    /* Input-to-photon latency (version 3) */
+    ICLED_TelemetryLatency latency[ICLED_LATENCY_SOURCE_COUNT];    ///< Indexed by ICLED_LatencySource
+} ICLED_Telemetry;
+
+/**
+ * @brief The telemetry block, written by the firmware only.
+ */
+extern volatile ICLED_Telemetry icled_telemetry;
+
+/**
+ * @brief Validates the block, counts the start and clears the counters.
+ *
+ * Call this first in the USER CODE 2 section of main(), before ICLED_Init().
+ */
+void ICLED_Telemetry_Init(void);
+
+/**
+ * @brief Mirrors the input, CPU and RAM figures into the block.
+ *
+ * Call this from the main loop.
+ */
+void ICLED_Telemetry_Process(void);
+
+/**
+ * @brief Deepest stack use since ICLED_Telemetry_Init() in bytes.
+ */
+uint32_t ICLED_Telemetry_StackHighWater(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICLED_TELEMETRY_H */
@@ -63,6 +63,8 @@ void Error_Handler(void);
 #define MCO_GPIO_Port GPIOA
 #define VCP_TX_Pin GPIO_PIN_2
 #define VCP_TX_GPIO_Port GPIOA
+#define DMX_RX_Pin GPIO_PIN_10
+#define DMX_RX_GPIO_Port GPIOA
 #define SWDIO_Pin GPIO_PIN_13
 #define SWDIO_GPIO_Port GPIOA
 #define SWCLK_Pin GPIO_PIN_14
@@ -73,6 +75,10 @@ void Error_Handler(void);
 #define LD3_GPIO_Port GPIOB
 #define S2_Pin GPIO_PIN_4
 #define S2_GPIO_Port GPIOB
+#define I2C_SCL_Pin GPIO_PIN_6
+#define I2C_SCL_GPIO_Port GPIOB
+#define I2C_SDA_Pin GPIO_PIN_7
+#define I2C_SDA_GPIO_Port GPIOB
 #define S2_EXTI_IRQn EXTI4_IRQn
 
 /* USER CODE BEGIN Private defines */
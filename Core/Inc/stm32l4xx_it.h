@@ -57,7 +57,18 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void EXTI4_IRQHandler(void);
 void DMA1_Channel2_IRQHandler(void);
+void DMA1_Channel5_IRQHandler(void);
+void DMA1_Channel6_IRQHandler(void);
+void I2C1_EV_IRQHandler(void);
+void I2C1_ER_IRQHandler(void);
+void USART1_IRQHandler(void);
+void DMA2_Channel6_IRQHandler(void);
+void DMA2_Channel7_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void EXTI0_IRQHandler(void);
+void USART2_IRQHandler(void);
+void DMA1_Channel4_IRQHandler(void);
+void QUADSPI_IRQHandler(void);
 
 /* USER CODE END EFP */
 
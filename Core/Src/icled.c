@@ -7,24 +7,115 @@
  * and create visual effects on a matrix of ICLEDs (e.g., Würth eiSos).
  * It relies on a hardware timer and DMA to generate correct PWM signal timing.
  *
+ * With ICLED_OUTPUT_USART the same bit stream comes from USART1 TX instead,
+ * three UART bits per LED bit. USART1 and its DMA channel are driven on
+ * register level, the HAL UART handle belongs to the DMX512 receiver.
+ *
  * @copyright (c) 2025 MootSeeker
  * @license MIT License
  *
  */
 
 #include "icled.h"
+#include "icled_bench.h"
+#include "icled_latency.h"
 
 #include "main.h"
 #include "tim.h"
+#include "icled_telemetry.h"
 
 #include <string.h>
 
+#if ICLED_OUTPUT_USART
+#define USART_DMA           DMA1_Channel4
+#define USART_DMA_REQUEST   2U      ///< USART1_TX on DMA1 channel 4 (CSELR C4S)
+
+/**
+ * @brief USARTDIV with 8x oversampling, the BRR value and the line time of @p slots UART bits in ns.
+ *
+ * 16x oversampling needs a divider of at least 16, which ends at 2 Mbaud with
+ * 32 MHz; OVER8 halves it and BRR takes USARTDIV[3:0] shifted right by one.
+ */
+#define USART_DIV( clock )          ( ( 2ULL * ( clock ) + ICLED_USART_BAUDRATE / 2U ) / ICLED_USART_BAUDRATE )
+#define USART_BRR( clock )          ( ( uint32_t )( ( USART_DIV( clock ) & 0xFFF0U ) | ( ( USART_DIV( clock ) & 0x000FU ) >> 1 ) ) )
+#define USART_NS( clock, slots )    ( ( slots ) * USART_DIV( clock ) * 1000000000ULL / ( 2ULL * ( clock ) ) )
+#define USART_DIV_MIN               16U
+
+#if USART_DIV( ICLED_USART_KERNEL_HZ ) < USART_DIV_MIN
+#error "ICLED_USART_BAUDRATE is too high for the USART kernel clock (USARTDIV < 16)"
+#endif
+
+#if ( USART_NS( ICLED_USART_KERNEL_HZ, 1 ) < ICLED_T0H_MIN_NS ) || ( USART_NS( ICLED_USART_KERNEL_HZ, 1 ) > ICLED_T0H_MAX_NS )
+#error "T0H of the USART output is out of the ICLED timing window"
+#endif
+
+#if ( USART_NS( ICLED_USART_KERNEL_HZ, 2 ) < ICLED_T1H_MIN_NS ) || ( USART_NS( ICLED_USART_KERNEL_HZ, 2 ) > ICLED_T1H_MAX_NS )
+#error "T1H of the USART output is out of the ICLED timing window"
+#endif
+
+#if ( USART_NS( ICLED_USART_KERNEL_HZ, 3 ) < ICLED_BIT_PERIOD_MIN_NS ) || ( USART_NS( ICLED_USART_KERNEL_HZ, 3 ) > ICLED_BIT_PERIOD_MAX_NS )
+#error "Bit period of the USART output is out of the ICLED timing window"
+#endif
+
+// the last two UART frames (9 bits each) leave the USART after the DMA transfer complete
+#if ( ICLED_USART_LATCH_US * 1000ULL ) < ( ICLED_LATCH_MIN_NS + USART_NS( ICLED_USART_KERNEL_HZ, 2 * 9 ) )
+#error "ICLED_USART_LATCH_US is too short for the latch"
+#endif
+
+/**
+ * @brief UART frame for the LED bits a, b and c.
+ *
+ * With TX and data inversion a frame goes out as start (high), d0 ... d6, stop (low),
+ * so the LED bits are 1 a 0, 1 b 0, 1 c 0 on the line: a, b and c in d0, d3 and d6,
+ * d2 and d5 always set.
+ */
+#define USART_FRAME( a, b, c )  ( 0x24U | ( a ) | ( ( b ) << 3 ) | ( ( c ) << 6 ) )
+
+/**
+ * @brief The two UART frames for 6 LED bits (MSB first), the first frame in the lower byte.
+ */
+#define USART_PAIR( v )         ( uint16_t )( USART_FRAME( ( ( v ) >> 5 ) & 1U, ( ( v ) >> 4 ) & 1U, ( ( v ) >> 3 ) & 1U ) | \
+                                              ( USART_FRAME( ( ( v ) >> 2 ) & 1U, ( ( v ) >> 1 ) & 1U, ( v ) & 1U ) << 8 ) )
+
+/**
+ * @brief UART frame pairs for every 6-bit group, four lookups per LED.
+ */
+static const uint16_t usart_lut[64] =
+{
+    USART_PAIR(  0 ), USART_PAIR(  1 ), USART_PAIR(  2 ), USART_PAIR(  3 ), USART_PAIR(  4 ), USART_PAIR(  5 ), USART_PAIR(  6 ), USART_PAIR(  7 ),
+    USART_PAIR(  8 ), USART_PAIR(  9 ), USART_PAIR( 10 ), USART_PAIR( 11 ), USART_PAIR( 12 ), USART_PAIR( 13 ), USART_PAIR( 14 ), USART_PAIR( 15 ),
+    USART_PAIR( 16 ), USART_PAIR( 17 ), USART_PAIR( 18 ), USART_PAIR( 19 ), USART_PAIR( 20 ), USART_PAIR( 21 ), USART_PAIR( 22 ), USART_PAIR( 23 ),
+    USART_PAIR( 24 ), USART_PAIR( 25 ), USART_PAIR( 26 ), USART_PAIR( 27 ), USART_PAIR( 28 ), USART_PAIR( 29 ), USART_PAIR( 30 ), USART_PAIR( 31 ),
+    USART_PAIR( 32 ), USART_PAIR( 33 ), USART_PAIR( 34 ), USART_PAIR( 35 ), USART_PAIR( 36 ), USART_PAIR( 37 ), USART_PAIR( 38 ), USART_PAIR( 39 ),
+    USART_PAIR( 40 ), USART_PAIR( 41 ), USART_PAIR( 42 ), USART_PAIR( 43 ), USART_PAIR( 44 ), USART_PAIR( 45 ), USART_PAIR( 46 ), USART_PAIR( 47 ),
+    USART_PAIR( 48 ), USART_PAIR( 49 ), USART_PAIR( 50 ), USART_PAIR( 51 ), USART_PAIR( 52 ), USART_PAIR( 53 ), USART_PAIR( 54 ), USART_PAIR( 55 ),
+    USART_PAIR( 56 ), USART_PAIR( 57 ), USART_PAIR( 58 ), USART_PAIR( 59 ), USART_PAIR( 60 ), USART_PAIR( 61 ), USART_PAIR( 62 ), USART_PAIR( 63 ),
+};
+
+/**
+ * @brief DMA buffer of the USART output, 8 UART frames per LED.
+ * The latch is idle time on the line (ICLED_USART_LATCH_US), so there is no reset padding.
+ */
+static uint8_t usart_buffer[ICLED_USART_BUFFER_SIZE];
+
+/**
+ * @brief Set by the DMA transfer complete, the frame stays busy until the latch time is over.
+ */
+static volatile bool latching;
+
+/**
+ * @brief Cycle counter at the DMA transfer complete and the latch time in cycles.
+ */
+static volatile uint32_t latch_cycles;
+static uint32_t latch_length;
+#else
 /**
  * @brief DMA PWM buffer that stores the bit-expanded signal for all LEDs.
  * Each bit is translated into a PWM compare value (ICLED_PWM_0 or ICLED_PWM_1),
  * followed by reset slots for latch timing.
  */
 static uint16_t pwm_buffer[ICLED_BUFFER_SIZE];
+#endif
 
 /**
  * @brief GRB pixel data buffer for all LEDs.
@@ -32,6 +123,189 @@ static uint16_t pwm_buffer[ICLED_BUFFER_SIZE];
  */
 static uint8_t led_data[ICLED_LED_COUNT][3];
 
+/**
+ * @brief First LED of the leftmost column in led_data, the columns form a ring.
+ */
+static uint16_t column_head;
+
+/**
+ * @brief Number of frames sent since ICLED_Init().
+ */
+static volatile uint32_t frame_count;
+
+/**
+ * @brief Set while the DMA sends a frame, cleared by the transfer complete interrupt.
+ */
+static volatile bool transfer_busy;
+
+/**
+ * @brief HAL tick of the last transfer start, the frame deadline counts from here.
+ */
+static volatile uint32_t transfer_tick;
+
+#if ICLED_OUTPUT_USART
+/**
+ * @brief The UART timing at a USART kernel clock hits the ICLED windows.
+ */
+static bool ICLED_USART_TimingFits( uint32_t clock )
+{
+    uint64_t t0h = USART_NS( clock, 1 );
+    uint64_t t1h = USART_NS( clock, 2 );
+    uint64_t period = USART_NS( clock, 3 );
+
+    return ( USART_DIV( clock ) >= USART_DIV_MIN ) &&
+           ( t0h >= ICLED_T0H_MIN_NS ) && ( t0h <= ICLED_T0H_MAX_NS ) &&
+           ( t1h >= ICLED_T1H_MIN_NS ) && ( t1h <= ICLED_T1H_MAX_NS ) &&
+           ( period >= ICLED_BIT_PERIOD_MIN_NS ) && ( period <= ICLED_BIT_PERIOD_MAX_NS );
+}
+
+/**
+ * @brief Starts the DMA transfer of the USART buffer.
+ */
+static void ICLED_StartTransfer( void )
+{
+    transfer_busy = true;
+    latching = false;
+    transfer_tick = HAL_GetTick( );
+
+    CLEAR_BIT( USART_DMA->CCR, DMA_CCR_EN );
+    DMA1->IFCR = DMA_IFCR_CGIF4;
+    USART_DMA->CMAR = ( uint32_t )( uintptr_t )usart_buffer;
+    USART_DMA->CNDTR = ICLED_USART_BUFFER_SIZE;
+    SET_BIT( USART_DMA->CCR, DMA_CCR_EN );
+}
+
+/**
+ * @brief Converts GRB bytes into UART frames, 3 bytes (one LED) into 8 frames.
+ */
+static uint32_t ICLED_Encode( uint32_t pos, const uint8_t *grb, uint16_t length )
+{
+    for( uint16_t i = 0; i + 3 <= length; i += 3 )
+    {
+        uint32_t bits = ( ( uint32_t )grb[i] << 16 ) | ( ( uint32_t )grb[i + 1] << 8 ) | grb[i + 2];
+        uint16_t pairs[4];
+
+        pairs[0] = usart_lut[bits >> 18];
+        pairs[1] = usart_lut[( bits >> 12 ) & 0x3FU];
+        pairs[2] = usart_lut[( bits >> 6 ) & 0x3FU];
+        pairs[3] = usart_lut[bits & 0x3FU];
+
+        // little endian: the lower byte of a pair, its first frame, goes out first
+        memcpy( &usart_buffer[pos], pairs, sizeof( pairs ) );
+        pos += sizeof( pairs );
+    }
+
+    return pos;
+}
+#else
+/**
+ * @brief Starts the DMA transfer of the PWM buffer.
+ */
+static void ICLED_StartTransfer( void )
+{
+    transfer_busy = true;
+    transfer_tick = HAL_GetTick( );
+
+    if( HAL_TIM_PWM_Start_DMA( &htim1, TIM_CHANNEL_1, ( uint32_t* )pwm_buffer, ICLED_BUFFER_SIZE ) != HAL_OK )
+    {
+        // the channel or the DMA is in a state the HAL refuses, the frame monitor recovers it
+        transfer_busy = false;
+        icled_telemetry.start_errors++;
+    }
+}
+
+/**
+ * @brief Converts GRB bytes into 8 PWM slots each (MSB first).
+ */
+static uint32_t ICLED_Encode( uint32_t pos, const uint8_t *grb, uint16_t length )
+{
+    for( uint16_t i = 0; i < length; i++ )
+    {
+        uint8_t val = grb[i];
+        for( int8_t bit = 7; bit >= 0; bit-- )
+        {
+            pwm_buffer[pos++] = (val & (1 << bit)) ? ICLED_PWM_1 : ICLED_PWM_0;
+        }
+    }
+
+    return pos;
+}
+#endif /* ICLED_OUTPUT_USART */
+
+/**
+ * @brief Encodes a frame that starts at LED @p head of @p grb (wrapping around) and sends it.
+ */
+static void ICLED_Transmit( const uint8_t *grb, uint16_t head )
+{
+    uint32_t pos = 0;
+    uint32_t start = ICLED_TELEMETRY_CYCLES( );
+
+#if ICLED_BENCH
+    ICLED_Bench_Mark( ICLED_BENCH_MARK_ENCODE );
+#endif
+
+#if ICLED_LATENCY
+    ICLED_Latency_Render( );
+#endif
+
+    // Convert each byte (G, R, B) into 8 PWM bits, the column ring from its head on
+    pos = ICLED_Encode( pos, &grb[head * 3], ( uint16_t )( ( ICLED_LED_COUNT - head ) * 3 ) );
+    pos = ICLED_Encode( pos, grb, ( uint16_t )( head * 3 ) );
+
+#if ICLED_OUTPUT_USART
+    ( void )pos;
+#else
+    // Add latch timing (reset pulse)
+    for( uint32_t i = 0; i < ICLED_RESET_SLOTS; i++ )
+    {
+        pwm_buffer[pos++] = 0;
+    }
+#endif
+
+#if ICLED_BENCH
+    ICLED_Bench_Mark( ICLED_BENCH_MARK_TRANSMIT );
+#endif
+
+    uint32_t encoded = ICLED_TELEMETRY_CYCLES( );
+
+#if ICLED_OUTPUT_USART
+    // the data is out, the rest of the latch is short: wait so the LEDs take the frames apart
+    while( latching && ICLED_IsBusy( NULL ) )
+    {
+    }
+#endif
+
+    if( transfer_busy )
+    {
+        // the restart cuts the running frame short
+        icled_telemetry.frames_dropped++;
+    }
+
+    // Restart DMA transmission with new data
+#if !ICLED_OUTPUT_USART
+    HAL_TIM_PWM_Stop_DMA( &htim1, TIM_CHANNEL_1 );
+#endif
+    ICLED_StartTransfer( );
+
+#if ICLED_LATENCY
+    ICLED_Latency_Start( );
+#endif
+
+    frame_count++;
+
+    icled_telemetry.frames = frame_count;
+    icled_telemetry.encode_cycles = encoded - start;
+    if( encoded - start > icled_telemetry.encode_cycles_max )
+    {
+        icled_telemetry.encode_cycles_max = encoded - start;
+    }
+    icled_telemetry.transmit_cycles = ICLED_TELEMETRY_CYCLES( ) - encoded;
+
+#if ICLED_BENCH
+    ICLED_Bench_Mark( ICLED_BENCH_MARK_DONE );
+#endif
+}
+
 /**
  * @brief Initializes the ICLED module.
  *
@@ -39,8 +313,11 @@ static uint8_t led_data[ICLED_LED_COUNT][3];
  */
 void ICLED_Init( void )
 {
+#if ICLED_OUTPUT_USART
+    ICLED_USART_Setup( );
+#endif
+
     ICLED_Clear( );
-    HAL_TIM_PWM_Start_DMA( &htim1, TIM_CHANNEL_1, ( uint32_t* )pwm_buffer, ICLED_BUFFER_SIZE );
 }
 
 /**
@@ -58,6 +335,10 @@ void ICLED_SetPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b)
 	/* Check if index is in range */
     if (index >= ICLED_LED_COUNT) return;
 
+    /* Column ring (ICLED_ScrollColumns) */
+    index += column_head;
+    if (index >= ICLED_LED_COUNT) index -= ICLED_LED_COUNT;
+
     /* Parse data */
     led_data[index][0] = g; // GRB!
     led_data[index][1] = r;
@@ -71,6 +352,8 @@ void ICLED_SetPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b)
  */
 void ICLED_Clear( void )
 {
+    column_head = 0;
+
     for( uint16_t i = 0; i < ICLED_LED_COUNT; i++ )
     {
         ICLED_SetPixel( i, 0, 0, 0 );
@@ -79,6 +362,57 @@ void ICLED_Clear( void )
     ICLED_Show( );
 }
 
+/**
+ * @brief Returns the GRB pixel buffer for direct writes.
+ *
+ * Used by the stream decoders to place received pixels without an extra copy.
+ */
+uint8_t *ICLED_GetBuffer( void )
+{
+    if( column_head != 0 )
+    {
+        // rotate by whole columns through a column of scratch, back into index order
+        uint8_t column[ICLED_ROWS][3];
+        uint16_t steps = column_head / ICLED_ROWS;
+
+        for( uint16_t s = 0; s < steps; s++ )
+        {
+            memcpy( column, led_data[0], sizeof( column ) );
+            memmove( led_data[0], led_data[ICLED_ROWS], sizeof( led_data ) - sizeof( column ) );
+            memcpy( led_data[ICLED_LED_COUNT - ICLED_ROWS], column, sizeof( column ) );
+        }
+
+        column_head = 0;
+    }
+
+    return &led_data[0][0];
+}
+
+/**
+ * @brief Moves the content by whole columns, O(1).
+ */
+void ICLED_ScrollColumns( int16_t columns )
+{
+    int16_t steps = columns % ICLED_COLUMNS;
+    if( steps < 0 ) steps += ICLED_COLUMNS;
+
+    column_head += ( uint16_t )steps * ICLED_ROWS;
+    if( column_head >= ICLED_LED_COUNT ) column_head -= ICLED_LED_COUNT;
+}
+
+/**
+ * @brief Returns a column of the pixel buffer as shown on the matrix.
+ */
+uint8_t *ICLED_GetColumn( uint16_t column )
+{
+    if( column >= ICLED_COLUMNS ) return NULL;
+
+    uint16_t index = column_head + column * ICLED_ROWS;
+    if( index >= ICLED_LED_COUNT ) index -= ICLED_LED_COUNT;
+
+    return led_data[index];
+}
+
 /**
  * @brief Updates the LED strip with current pixel values.
  *
@@ -87,28 +421,196 @@ void ICLED_Clear( void )
  */
 void ICLED_Show( void )
 {
-    uint32_t pos = 0;
+    ICLED_Transmit( &led_data[0][0], column_head );
+}
 
-    // Convert each byte (G, R, B) into 8 PWM bits (MSB first)
-    for( uint16_t i = 0; i < ICLED_LED_COUNT; i++ )
+/**
+ * @brief Transfers a GRB buffer other than the pixel buffer to the LEDs.
+ */
+void ICLED_ShowBuffer( const uint8_t *grb )
+{
+    ICLED_Transmit( grb, 0 );
+}
+
+/**
+ * @brief Returns the number of frames sent since ICLED_Init().
+ */
+uint32_t ICLED_GetFrameCount( void )
+{
+    return frame_count;
+}
+
+/**
+ * @brief Checks whether a frame is on the wire.
+ */
+bool ICLED_IsBusy( uint32_t *start_tick )
+{
+    if( start_tick != NULL )
+    {
+        *start_tick = transfer_tick;
+    }
+
+#if ICLED_OUTPUT_USART
+    // a wrap of the cycle counter cannot bring an expired latch back, it is cleared here
+    if( latching && ( ( ICLED_TELEMETRY_CYCLES( ) - latch_cycles ) >= latch_length ) )
+    {
+        latching = false;
+        transfer_busy = false;
+    }
+#endif
+
+    return transfer_busy;
+}
+
+#if ICLED_OUTPUT_USART
+/**
+ * @brief Decodes the frame of the last ICLED_Show() from the USART buffer.
+ */
+uint32_t ICLED_ReadBack( uint8_t *grb )
+{
+    const uint8_t *frame = usart_buffer;
+
+    for( uint16_t led = 0; led < ICLED_LED_COUNT; led++ )
     {
-        for( uint8_t c = 0; c < 3; c++ )
+        uint32_t bits = 0;
+        for( uint8_t f = 0; f < 8; f++, frame++ )
         {
-            uint8_t val = led_data[i][c];
-            for( int8_t bit = 7; bit >= 0; bit-- )
-            {
-                pwm_buffer[pos++] = (val & (1 << bit)) ? ICLED_PWM_1 : ICLED_PWM_0;
-            }
+            // d0, d3 and d6 of each frame
+            bits = ( bits << 3 ) | ( ( *frame & 0x01U ) << 2 ) | ( ( *frame >> 2 ) & 0x02U ) | ( ( *frame >> 6 ) & 0x01U );
         }
+
+        grb[led * 3 + 0] = ( uint8_t )( bits >> 16 );
+        grb[led * 3 + 1] = ( uint8_t )( bits >> 8 );
+        grb[led * 3 + 2] = ( uint8_t )bits;
     }
 
-    // Add latch timing (reset pulse)
-    for( uint32_t i = 0; i < ICLED_RESET_SLOTS; i++ )
+    return frame_count;
+}
+
+/**
+ * @brief Configures USART1 TX and DMA1 channel 4 for the LED output.
+ */
+void ICLED_USART_Setup( void )
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    // MX_USART1_UART_Init() selects PCLK2 as the USART1 kernel clock
+    uint32_t clock = HAL_RCC_GetPCLK2Freq( );
+    if( !ICLED_USART_TimingFits( clock ) )
     {
-        pwm_buffer[pos++] = 0;
+        Error_Handler( );
     }
 
-    // Restart DMA transmission with new data
-    HAL_TIM_PWM_Stop_DMA( &htim1, TIM_CHANNEL_1 );
-    HAL_TIM_PWM_Start_DMA( &htim1, TIM_CHANNEL_1, ( uint32_t* )pwm_buffer, ICLED_BUFFER_SIZE );
+    __HAL_RCC_USART1_CLK_ENABLE( );
+    __HAL_RCC_DMA1_CLK_ENABLE( );
+    __HAL_RCC_GPIOA_CLK_ENABLE( );
+
+    /* PA9 = USART1_TX, pulled low so the line idles low while the USART is off */
+    GPIO_InitStruct.Pin = GPIO_PIN_9;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF7_USART1;
+    HAL_GPIO_Init( GPIOA, &GPIO_InitStruct );
+
+    /* the DMX512 receiver is off, nothing else uses the USART1 interrupt */
+    HAL_NVIC_DisableIRQ( USART1_IRQn );
+
+    /* 7 data bits, 1 stop bit, 8x oversampling, transmitter only, TX and data inverted (CR2 only takes them with UE clear) */
+    CLEAR_BIT( USART1->CR1, USART_CR1_UE );
+    USART1->CR1 = USART_CR1_M1 | USART_CR1_OVER8 | USART_CR1_TE;
+    USART1->CR2 = USART_CR2_TXINV | USART_CR2_DATAINV;
+    USART1->CR3 = USART_CR3_DMAT;
+    USART1->BRR = USART_BRR( clock );
+    SET_BIT( USART1->CR1, USART_CR1_UE );
+
+    CLEAR_BIT( USART_DMA->CCR, DMA_CCR_EN );
+    MODIFY_REG( DMA1_CSELR->CSELR, DMA_CSELR_C4S, USART_DMA_REQUEST << DMA_CSELR_C4S_Pos );
+
+    // memory to peripheral, bytes, memory increment, high priority, transfer complete and error interrupts
+    USART_DMA->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PL_1 | DMA_CCR_TCIE | DMA_CCR_TEIE;
+    USART_DMA->CPAR = ( uint32_t )( uintptr_t )&USART1->TDR;
+
+    latch_length = SystemCoreClock / 1000000U * ICLED_USART_LATCH_US;
+    latching = false;
+
+    HAL_NVIC_SetPriority( DMA1_Channel4_IRQn, 1, 0 );
+    HAL_NVIC_EnableIRQ( DMA1_Channel4_IRQn );
+}
+
+/**
+ * @brief DMA1 channel 4: the last frame is in the USART, or a transfer error.
+ */
+void ICLED_USART_IRQHandler( void )
+{
+    uint32_t isr = DMA1->ISR;
+
+    if( isr & DMA_ISR_TEIF4 )
+    {
+        // the hardware has disabled the channel already
+        DMA1->IFCR = DMA_IFCR_CGIF4;
+        transfer_busy = false;
+        icled_telemetry.dma_errors++;
+        return;
+    }
+
+    if( isr & DMA_ISR_TCIF4 )
+    {
+        // the channel stays enabled with nothing left to do, a disabled one is stuck for the monitor
+        DMA1->IFCR = DMA_IFCR_CGIF4;
+        latch_cycles = ICLED_TELEMETRY_CYCLES( );
+        latching = true;
+        icled_telemetry.frames_completed++;
+
+#if ICLED_LATENCY
+        ICLED_Latency_Latch( );
+#endif
+    }
+}
+#else
+/**
+ * @brief Decodes the frame of the last ICLED_Show() from the PWM buffer.
+ */
+uint32_t ICLED_ReadBack( uint8_t *grb )
+{
+    const uint16_t *slot = pwm_buffer;
+
+    for( uint16_t i = 0; i < ICLED_LED_COUNT * 3; i++ )
+    {
+        uint8_t val = 0;
+        for( uint8_t bit = 0; bit < 8; bit++ )
+        {
+            val = ( uint8_t )( ( val << 1 ) | ( *slot++ == ICLED_PWM_1 ) );
+        }
+        grb[i] = val;
+    }
+
+    return frame_count;
+}
+
+/**
+ * @brief TIM1 DMA transfer complete: the frame and its reset slots are out.
+ */
+void HAL_TIM_PWM_PulseFinishedCallback( TIM_HandleTypeDef *htim )
+{
+    if( htim != &htim1 ) return;
+
+    transfer_busy = false;
+    icled_telemetry.frames_completed++;
+
+#if ICLED_LATENCY
+    ICLED_Latency_Latch( );
+#endif
+}
+
+/**
+ * @brief TIM1 DMA transfer error.
+ */
+void HAL_TIM_ErrorCallback( TIM_HandleTypeDef *htim )
+{
+    if( htim != &htim1 ) return;
+
+    transfer_busy = false;
+    icled_telemetry.dma_errors++;
 }
+#endif /* ICLED_OUTPUT_USART */
@@ -0,0 +1,617 @@
+/**
+ * @file icled_bench.c
+ * @author MootSeeker
+ * @brief Frame pipeline benchmark with JSON lines output.
+ *
+ * Effect and stream scenarios run the real pipeline: the effect (or the
+ * decoder) renders into the ICLED buffer and ICLED_Show() encodes and
+ * restarts the DMA, the marks in ICLED_Show() split the frame into render,
+ * encode and transmit start. The synthetic scenarios render into their own
+ * canvas of up to ICLED_BENCH_MAX_LEDS and encode it in chunks with the same
+ * loop as ICLED_Show(), without sending it.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_bench.h"
+
+#if ICLED_BENCH
+
+#include "icled.h"
+#include "icled_stream.h"
+#include "icled_pixfmt.h"
+#include "icled_ripple.h"
+#include "example_app.h"
+#include "main.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_ROWS          7                   ///< Column height, the scroll moves whole columns
+#define BENCH_CHUNK_LEDS    ICLED_LED_COUNT     ///< LEDs encoded per chunk of the synthetic canvas
+#define BENCH_RIPPLE_ROWS   16                  ///< Rows of the ripple canvases that are not a whole panel
+
+/**
+ * @brief Renders one frame of a scenario.
+ *
+ * @param leds   Canvas size.
+ * @param layers Number of layers (compositing only).
+ * @param n      Frame number.
+ */
+typedef void (*BenchFrame)( uint16_t leds, uint8_t layers, uint32_t n );
+
+/**
+ * @struct BenchScenario
+ * @brief One line of the output.
+ */
+typedef struct
+{
+    const char *name;
+    void (*prepare)( void );    ///< Called before the first frame, may be NULL
+    BenchFrame frame;
+    uint16_t leds;
+    uint8_t layers;
+} BenchScenario;
+
+static const ICLED_BenchPort *port;
+
+static uint32_t marks[ICLED_BENCH_MARK_COUNT];
+static uint8_t marked;      ///< Bit per ICLED_BenchMark taken in the current frame
+
+static uint8_t canvas[ICLED_BENCH_MAX_LEDS][3];
+static uint16_t bench_pwm[BENCH_CHUNK_LEDS * ICLED_BITS_PER_LED];
+static uint16_t *volatile bench_escape;     ///< Keeps the encoder output from being optimized away
+
+static uint8_t packet[ICLED_LED_COUNT * 3 + 16];
+static uint16_t packet_length;
+static uint16_t packet_payload;     ///< Offset of the first pixel byte in packet[]
+
+static volatile uint32_t isr_cycles;    ///< Cycles spent in interrupt handlers during the running scenario
+static volatile uint32_t isr_start;     ///< Entry of the outermost running handler
+static volatile uint8_t isr_depth;      ///< Nesting depth of the running handlers
+
+/**
+ * @brief Per frame times of the running scenario, reported as median.
+ */
+static uint32_t samples[ICLED_BENCH_MARK_COUNT][ICLED_BENCH_FRAMES];
+
+/**
+ * @brief Takes a time stamp, called from ICLED_Show() in the benchmark build.
+ */
+void ICLED_Bench_Mark( ICLED_BenchMark mark )
+{
+    if( ( port == NULL ) || ( mark >= ICLED_BENCH_MARK_COUNT ) ) return;
+
+    marks[mark] = port->cycles( );
+    marked |= ( uint8_t )( 1U << mark );
+}
+
+/**
+ * @brief Interrupt handler entered, only the outermost of nested handlers is timed.
+ */
+void ICLED_Bench_IsrEnter( void )
+{
+    if( port == NULL ) return;
+
+    // a nested handler completes before the outer one resumes, the depth is consistent again
+    if( isr_depth++ == 0 )
+    {
+        isr_start = port->cycles( );
+    }
+}
+
+/**
+ * @brief Interrupt handler left, adds its time to the running scenario.
+ */
+void ICLED_Bench_IsrExit( void )
+{
+    if( ( port == NULL ) || ( isr_depth == 0 ) ) return;
+
+    if( --isr_depth == 0 )
+    {
+        isr_cycles += port->cycles( ) - isr_start;
+    }
+}
+
+/**
+ * @brief Encodes @p count canvas LEDs from @p first on into bench_pwm[] at @p pos.
+ */
+static uint32_t Bench_EncodeRun( uint32_t pos, uint16_t first, uint16_t count )
+{
+    for( uint16_t i = first; i < first + count; i++ )
+    {
+        for( uint8_t c = 0; c < 3; c++ )
+        {
+            uint8_t val = canvas[i][c];
+            for( int8_t bit = 7; bit >= 0; bit-- )
+            {
+                bench_pwm[pos++] = (val & (1 << bit)) ? ICLED_PWM_1 : ICLED_PWM_0;
+            }
+        }
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Encodes the canvas in chunks, with the loop of ICLED_Show().
+ *
+ * @param leds Canvas size.
+ * @param head LED the canvas starts at, the columns form a ring like in ICLED_ScrollColumns().
+ */
+static void Bench_Encode( uint16_t leds, uint16_t head )
+{
+    uint16_t led = head;
+
+    ICLED_Bench_Mark( ICLED_BENCH_MARK_ENCODE );
+
+    for( uint16_t start = 0; start < leds; start += BENCH_CHUNK_LEDS )
+    {
+        uint16_t count = ( leds - start > BENCH_CHUNK_LEDS ) ? BENCH_CHUNK_LEDS : leds - start;
+        uint16_t before_wrap = ( count < leds - led ) ? count : leds - led;
+
+        // a chunk that crosses the end of the ring is encoded in two runs
+        uint32_t pos = Bench_EncodeRun( 0, led, before_wrap );
+        Bench_EncodeRun( pos, 0, count - before_wrap );
+
+        led = ( before_wrap < count ) ? count - before_wrap : led + count;
+    }
+
+    ICLED_Bench_Mark( ICLED_BENCH_MARK_TRANSMIT );
+    ICLED_Bench_Mark( ICLED_BENCH_MARK_DONE );
+}
+
+static void Bench_NightRide( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )leds; ( void )layers; ( void )n;
+    ICLED_NightRideDemo( 40, 0 );
+}
+
+static void Bench_ColorFade( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )leds; ( void )layers; ( void )n;
+    ICLED_KnightRiderColorFade( 40, 0 );
+}
+
+static void Bench_Starfield( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )leds; ( void )layers; ( void )n;
+    ICLED_StarfieldEffect( 20, 0 );
+}
+
+static void Bench_Snake( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )leds; ( void )layers; ( void )n;
+    ICLED_SnakePattern( 40, 0 );
+}
+
+static void Bench_RippleEffect( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )leds; ( void )layers; ( void )n;
+    ICLED_RippleEffect( 60, 0 );
+}
+
+/**
+ * @brief Builds one frame of the given protocol in packet[], RGB data a ramp.
+ */
+static void Bench_Packet( ICLED_StreamProtocol protocol )
+{
+    const uint16_t size = ICLED_LED_COUNT * 3;
+    uint16_t pos = 0;
+
+    switch( protocol )
+    {
+        case ICLED_STREAM_ADALIGHT:
+            packet[pos++] = 'A';
+            packet[pos++] = 'd';
+            packet[pos++] = 'a';
+            packet[pos++] = ( uint8_t )( ( ICLED_LED_COUNT - 1 ) >> 8 );
+            packet[pos++] = ( uint8_t )( ICLED_LED_COUNT - 1 );
+            packet[pos] = packet[pos - 2] ^ packet[pos - 1] ^ 0x55;
+            pos++;
+            break;
+
+        case ICLED_STREAM_TPM2:
+            packet[pos++] = 0xC9;
+            packet[pos++] = 0xDA;
+            packet[pos++] = ( uint8_t )( size >> 8 );
+            packet[pos++] = ( uint8_t )size;
+            break;
+
+        default:
+            // DDP v1 with PUSH, sequence 1, RGB8, display 1, offset 0
+            packet[pos++] = 0x41;
+            packet[pos++] = 0x01;
+            packet[pos++] = 0x0B;
+            packet[pos++] = 0x01;
+            packet[pos++] = 0;
+            packet[pos++] = 0;
+            packet[pos++] = 0;
+            packet[pos++] = 0;
+            packet[pos++] = ( uint8_t )( size >> 8 );
+            packet[pos++] = ( uint8_t )size;
+            break;
+    }
+
+    packet_payload = pos;
+    for( uint16_t i = 0; i < size; i++ )
+    {
+        packet[pos++] = ( uint8_t )i;
+    }
+
+    if( protocol == ICLED_STREAM_TPM2 )
+    {
+        packet[pos++] = 0x36;
+    }
+
+    packet_length = pos;
+}
+
+static void Bench_Adalight( void )
+{
+    Bench_Packet( ICLED_STREAM_ADALIGHT );
+}
+
+static void Bench_Tpm2( void )
+{
+    Bench_Packet( ICLED_STREAM_TPM2 );
+}
+
+static void Bench_Ddp( void )
+{
+    Bench_Packet( ICLED_STREAM_DDP );
+}
+
+/**
+ * @brief Decodes the prepared packet, the first pixel byte changes every frame.
+ */
+static void Bench_Stream( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )leds; ( void )layers;
+
+    packet[packet_payload] = ( uint8_t )n;
+    ICLED_Stream_Feed( packet, packet_length );
+}
+
+/**
+ * @brief Converts @p leds pixels of the given format, read from the canvas bytes, into the pixel buffer.
+ *
+ * The frame is converted in chunks of one pixel buffer like the synthetic
+ * canvases are encoded, nothing is encoded or sent.
+ */
+static void Bench_Convert( ICLED_PixFmt format, uint16_t leds )
+{
+    const uint8_t *src = canvas[0];
+    uint8_t *frame = ICLED_GetBuffer( );
+
+    for( uint16_t done = 0; done < leds; done += BENCH_CHUNK_LEDS )
+    {
+        uint16_t count = ( ( leds - done ) < BENCH_CHUNK_LEDS ) ? ( uint16_t )( leds - done ) : BENCH_CHUNK_LEDS;
+        ICLED_PixFmt_Convert( format, frame, &src[( uint32_t )done * ICLED_PIXFMT_BYTES( format )], count );
+    }
+}
+
+static void Bench_ConvertGRB( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )layers; ( void )n;
+    Bench_Convert( ICLED_PIXFMT_GRB, leds );
+}
+
+static void Bench_ConvertRGB( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )layers; ( void )n;
+    Bench_Convert( ICLED_PIXFMT_RGB, leds );
+}
+
+static void Bench_ConvertBGR( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )layers; ( void )n;
+    Bench_Convert( ICLED_PIXFMT_BGR, leds );
+}
+
+static void Bench_ConvertRGBW( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )layers; ( void )n;
+    Bench_Convert( ICLED_PIXFMT_RGBW, leds );
+}
+
+static void Bench_ConvertRGB565( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )layers; ( void )n;
+    Bench_Convert( ICLED_PIXFMT_RGB565, leds );
+}
+
+static void Bench_ClearCanvas( void )
+{
+    memset( canvas, 0, sizeof( canvas ) );
+}
+
+/**
+ * @brief Draws the column that enters at the right, starting at canvas LED @p first.
+ *
+ * The firmware has no font, the new column is a colour ramp instead of glyph data.
+ */
+static void Bench_ScrollColumn( uint16_t first, uint32_t n )
+{
+    for( uint16_t row = 0; row < BENCH_ROWS; row++ )
+    {
+        uint8_t *pixel = canvas[first + row];
+        pixel[0] = ( uint8_t )( n * 5 + row * 16 );
+        pixel[1] = ( uint8_t )( 255 - n * 3 );
+        pixel[2] = ( uint8_t )( row * 36 );
+    }
+}
+
+/**
+ * @brief Moves the canvas one column on and draws the new column.
+ */
+static void Bench_Scroll( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    ( void )layers;
+
+    memmove( canvas[0], canvas[BENCH_ROWS], ( size_t )( leds - BENCH_ROWS ) * 3 );
+    Bench_ScrollColumn( leds - BENCH_ROWS, n );
+
+    Bench_Encode( leds, 0 );
+}
+
+/**
+ * @brief The same scroll with the columns as a ring: the head moves on, the new column replaces the one that left.
+ */
+static void Bench_ScrollRing( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    static uint16_t head;
+
+    ( void )layers;
+
+    if( n == 0 ) head = 0;
+
+    Bench_ScrollColumn( head, n );
+    // a canvas that is not a whole number of columns leaves its last LEDs out of the ring
+    head = ( head + 2 * BENCH_ROWS <= leds ) ? head + BENCH_ROWS : 0;
+
+    Bench_Encode( leds, head );
+}
+
+/**
+ * @brief Blends @p layers moving ramps over each other, each with its own alpha.
+ */
+static void Bench_Composite( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    memset( canvas, 0, ( size_t )leds * 3 );
+
+    for( uint8_t l = 0; l < layers; l++ )
+    {
+        int32_t alpha = 64 + l * 24;
+        uint8_t phase = ( uint8_t )( n * ( l + 1 ) );
+
+        for( uint16_t i = 0; i < leds; i++ )
+        {
+            uint8_t v = ( uint8_t )( i * ( l + 3 ) + phase );
+            uint8_t src[3] = { v, ( uint8_t )( 255 - v ), ( uint8_t )( v ^ ( l * 37 ) ) };
+
+            for( uint8_t c = 0; c < 3; c++ )
+            {
+                canvas[i][c] = ( uint8_t )( canvas[i][c] + ( ( ( src[c] - canvas[i][c] ) * alpha ) >> 8 ) );
+            }
+        }
+    }
+
+    Bench_Encode( leds, 0 );
+}
+
+/**
+ * @brief Steps a ripple surface of @p leds cells with rain, colours it into the canvas and encodes it.
+ *
+ * 105 LEDs are the 15x7 panel, the larger canvases BENCH_RIPPLE_ROWS high.
+ */
+static void Bench_Ripple( uint16_t leds, uint8_t layers, uint32_t n )
+{
+    static ICLED_Ripple surface;
+    static int16_t fields[2 * ICLED_RIPPLE_CELLS( ICLED_BENCH_MAX_LEDS / BENCH_RIPPLE_ROWS, BENCH_RIPPLE_ROWS )];
+
+    ( void )layers;
+
+    if( n == 0 )
+    {
+        uint16_t rows = ( leds % ICLED_ROWS == 0 ) ? ICLED_ROWS : BENCH_RIPPLE_ROWS;
+        ICLED_Ripple_Init( &surface, fields, leds / rows, rows );
+    }
+
+    ICLED_Ripple_Rain( &surface, 64, 4096 );
+    ICLED_Ripple_Step( &surface );
+    ICLED_Ripple_Render( &surface, canvas[0], 60 );
+
+    Bench_Encode( leds, 0 );
+}
+
+static const BenchScenario scenarios[] =
+{
+    { "effect_nightride",   NULL,              Bench_NightRide,  ICLED_LED_COUNT, 0 },
+    { "effect_colorfade",   NULL,              Bench_ColorFade,  ICLED_LED_COUNT, 0 },
+    { "effect_starfield",   NULL,              Bench_Starfield,  ICLED_LED_COUNT, 0 },
+    { "effect_snake",       NULL,              Bench_Snake,      ICLED_LED_COUNT, 0 },
+    { "effect_ripple",      NULL,              Bench_RippleEffect, ICLED_LED_COUNT, 0 },
+    { "stream_adalight",    Bench_Adalight,    Bench_Stream,     ICLED_LED_COUNT, 0 },
+    { "stream_tpm2",        Bench_Tpm2,        Bench_Stream,     ICLED_LED_COUNT, 0 },
+    { "stream_ddp",         Bench_Ddp,         Bench_Stream,     ICLED_LED_COUNT, 0 },
+    { "convert_grb",        NULL,              Bench_ConvertGRB,    ICLED_LED_COUNT, 0 },
+    { "convert_grb",        NULL,              Bench_ConvertGRB,    1024, 0 },
+    { "convert_rgb",        NULL,              Bench_ConvertRGB,    ICLED_LED_COUNT, 0 },
+    { "convert_rgb",        NULL,              Bench_ConvertRGB,    1024, 0 },
+    { "convert_bgr",        NULL,              Bench_ConvertBGR,    ICLED_LED_COUNT, 0 },
+    { "convert_bgr",        NULL,              Bench_ConvertBGR,    1024, 0 },
+    { "convert_rgbw",       NULL,              Bench_ConvertRGBW,   ICLED_LED_COUNT, 0 },
+    { "convert_rgbw",       NULL,              Bench_ConvertRGBW,   1024, 0 },
+    { "convert_rgb565",     NULL,              Bench_ConvertRGB565, ICLED_LED_COUNT, 0 },
+    { "convert_rgb565",     NULL,              Bench_ConvertRGB565, 1024, 0 },
+    { "scroll",             Bench_ClearCanvas, Bench_Scroll,     105,  0 },
+    { "scroll",             Bench_ClearCanvas, Bench_Scroll,     512,  0 },
+    { "scroll",             Bench_ClearCanvas, Bench_Scroll,     2048, 0 },
+    { "scroll_ring",        Bench_ClearCanvas, Bench_ScrollRing, 105,  0 },
+    { "scroll_ring",        Bench_ClearCanvas, Bench_ScrollRing, 512,  0 },
+    { "scroll_ring",        Bench_ClearCanvas, Bench_ScrollRing, 2048, 0 },
+    { "composite",          NULL,              Bench_Composite,  105,  2 },
+    { "composite",          NULL,              Bench_Composite,  105,  4 },
+    { "composite",          NULL,              Bench_Composite,  105,  8 },
+    { "composite",          NULL,              Bench_Composite,  512,  2 },
+    { "composite",          NULL,              Bench_Composite,  512,  4 },
+    { "composite",          NULL,              Bench_Composite,  512,  8 },
+    { "composite",          NULL,              Bench_Composite,  2048, 2 },
+    { "composite",          NULL,              Bench_Composite,  2048, 4 },
+    { "composite",          NULL,              Bench_Composite,  2048, 8 },
+    { "ripple",             NULL,              Bench_Ripple,     105,  0 },
+    { "ripple",             NULL,              Bench_Ripple,     512,  0 },
+    { "ripple",             NULL,              Bench_Ripple,     2048, 0 },
+};
+
+/**
+ * @brief Median of @p count values, sorts them in place.
+ */
+static uint32_t Bench_Median( uint32_t *values, uint32_t count )
+{
+    for( uint32_t i = 1; i < count; i++ )
+    {
+        uint32_t value = values[i];
+        uint32_t j = i;
+        while( ( j > 0 ) && ( values[j - 1] > value ) )
+        {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+
+    return values[count / 2];
+}
+
+static void Bench_Write( char *line, int length, uint16_t size )
+{
+    if( length <= 0 ) return;
+    if( length >= size ) length = size - 1;
+
+    port->write( line, ( uint16_t )length );
+}
+
+/**
+ * @brief Runs one scenario and writes its line.
+ */
+static void Bench_Scenario( const BenchScenario *scenario )
+{
+    if( scenario->prepare != NULL )
+    {
+        scenario->prepare( );
+    }
+
+    // interrupt time of the frames themselves: TIM1 DMA, stream reception, SysTick, ...
+    __disable_irq( );
+    isr_cycles = 0;
+    __enable_irq( );
+    uint32_t run_start = port->cycles( );
+
+    for( uint32_t n = 0; n < ICLED_BENCH_FRAMES; n++ )
+    {
+        marked = 0;
+        uint32_t start = port->cycles( );
+        scenario->frame( scenario->leds, scenario->layers, n );
+        uint32_t end = port->cycles( );
+
+        if( marked == ( 1U << ICLED_BENCH_MARK_COUNT ) - 1 )
+        {
+            samples[0][n] = marks[ICLED_BENCH_MARK_ENCODE] - start;
+            samples[1][n] = marks[ICLED_BENCH_MARK_TRANSMIT] - marks[ICLED_BENCH_MARK_ENCODE];
+            samples[2][n] = marks[ICLED_BENCH_MARK_DONE] - marks[ICLED_BENCH_MARK_TRANSMIT];
+        }
+        else
+        {
+            samples[0][n] = end - start;
+            samples[1][n] = 0;
+            samples[2][n] = 0;
+        }
+    }
+
+    __disable_irq( );
+    uint32_t isr_total = isr_cycles;
+    __enable_irq( );
+    uint32_t run_elapsed = port->cycles( ) - run_start;
+
+    // the median keeps a stray interrupt or a preempted host process out of the numbers
+    uint32_t render = Bench_Median( samples[0], ICLED_BENCH_FRAMES );
+    uint32_t encode = Bench_Median( samples[1], ICLED_BENCH_FRAMES );
+    uint32_t transmit = Bench_Median( samples[2], ICLED_BENCH_FRAMES );
+    uint32_t frame = render + encode + transmit;
+
+    // one PWM slot is 1.25 µs, plus the reset slots
+    uint32_t wire_us = ( ( uint32_t )scenario->leds * ICLED_BITS_PER_LED + ICLED_RESET_SLOTS ) * 5 / 4;
+    uint32_t fps_wire = 10000000UL / wire_us;
+    uint32_t fps_cpu = ( frame > 0 ) ? ( uint32_t )( port->clock_hz * 10ULL / frame ) : UINT32_MAX;
+    uint32_t fps = ( fps_cpu < fps_wire ) ? fps_cpu : fps_wire;
+
+    char ram[12] = "null";
+    if( port->ram_used != NULL )
+    {
+        snprintf( ram, sizeof( ram ), "%lu", ( unsigned long )port->ram_used( ) );
+    }
+
+    // share of the frame loop spent in interrupt handlers, in 0.1 %
+    char isr[12] = "null";
+    if( port->isr_hooks && ( run_elapsed > 0 ) )
+    {
+        uint32_t load = ( uint32_t )( ( uint64_t )isr_total * 1000ULL / run_elapsed );
+        snprintf( isr, sizeof( isr ), "%lu.%lu", ( unsigned long )( load / 10 ), ( unsigned long )( load % 10 ) );
+    }
+
+    char line[320];
+    int length = snprintf( line, sizeof( line ),
+        "{\"bench\":\"icled\",\"v\":%d,\"target\":\"%s\",\"scenario\":\"%s\",\"leds\":%u,\"layers\":%u,"
+        "\"frames\":%d,\"clock_hz\":%lu,\"render_cyc\":%lu,\"encode_cyc\":%lu,\"transmit_cyc\":%lu,"
+        "\"wire_us\":%lu,\"fps\":%lu.%lu,\"limit\":\"%s\",\"ram_hwm\":%s,\"isr_load_pct\":%s}\n",
+        ICLED_BENCH_VERSION, port->target, scenario->name, scenario->leds, scenario->layers,
+        ICLED_BENCH_FRAMES, ( unsigned long )port->clock_hz,
+        ( unsigned long )render, ( unsigned long )encode, ( unsigned long )transmit, ( unsigned long )wire_us,
+        ( unsigned long )( fps / 10 ), ( unsigned long )( fps % 10 ), ( fps_cpu < fps_wire ) ? "cpu" : "wire",
+        ram, isr );
+
+    Bench_Write( line, length, sizeof( line ) );
+}
+
+/**
+ * @brief Runs all scenarios and writes one JSON line per scenario.
+ */
+void ICLED_Bench_Run( const ICLED_BenchPort *run_port )
+{
+    if( ( run_port == NULL ) || ( run_port->cycles == NULL ) || ( run_port->write == NULL ) || ( run_port->clock_hz == 0 ) )
+    {
+        return;
+    }
+
+    port = run_port;
+    bench_escape = bench_pwm;
+
+    uint8_t effect = example_app_get_effect( );
+    char line[160];
+    int length;
+
+    length = snprintf( line, sizeof( line ),
+        "{\"bench\":\"icled\",\"v\":%d,\"target\":\"%s\",\"clock_hz\":%lu,\"frames\":%d,\"scenarios\":%u}\n",
+        ICLED_BENCH_VERSION, port->target, ( unsigned long )port->clock_hz, ICLED_BENCH_FRAMES,
+        ( unsigned )( sizeof( scenarios ) / sizeof( scenarios[0] ) ) );
+    Bench_Write( line, length, sizeof( line ) );
+
+    for( uint16_t i = 0; i < sizeof( scenarios ) / sizeof( scenarios[0] ); i++ )
+    {
+        Bench_Scenario( &scenarios[i] );
+    }
+
+    length = snprintf( line, sizeof( line ), "{\"bench\":\"icled\",\"v\":%d,\"done\":true}\n", ICLED_BENCH_VERSION );
+    Bench_Write( line, length, sizeof( line ) );
+
+    example_app_set_effect( effect );
+    ICLED_Clear( );
+    port = NULL;
+}
+
+#endif /* ICLED_BENCH */
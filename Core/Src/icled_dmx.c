@@ -0,0 +1,263 @@
+/**
+ * @file icled_dmx.c
+ * @author MootSeeker
+ * @brief DMX512 receiver that drives the ICLED matrix from a lighting desk.
+ *
+ * A break shows up on the USART as a framing error with 0x00 data. The mark
+ * after break ends with the start bit of the start code, which the USART
+ * synchronises on, so every break simply re-arms the DMA for the next packet.
+ * The DMA only captures up to the last slot of the footprint; its transfer
+ * complete marks the frame ready. Shorter packets are completed by the next
+ * break. The rest of a packet is ignored (overrun detection is disabled).
+ * Of three buffers one captures, one waits and one is read by
+ * ICLED_DMX_Process(), so a burst of packets never lands in the one being read.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_dmx.h"
+#include "icled_interp.h"
+#include "icled_quad.h"
+
+#include "main.h"
+#include "usart.h"
+
+#include <string.h>
+
+#if ( ICLED_DMX_START_ADDRESS < 1 ) || ( ( ICLED_DMX_START_ADDRESS + 3 * ICLED_DMX_SEGMENTS - 1 ) > ICLED_DMX_SLOTS )
+#error "ICLED_DMX_START_ADDRESS / ICLED_DMX_SEGMENTS do not fit into a DMX universe"
+#endif
+
+#define DMX_BUFFERS         3
+
+extern DMA_HandleTypeDef hdma_usart1_rx;
+
+/**
+ * @brief Buffers for the captured packets, [0] is the start code, [n] slot n.
+ */
+static uint8_t dmx_buffer[DMX_BUFFERS][1 + ICLED_DMX_SLOTS];
+
+/**
+ * @brief Captured bytes (including start code) and mapping of each buffer.
+ */
+static uint16_t dmx_length[DMX_BUFFERS];
+static uint16_t dmx_start[DMX_BUFFERS];
+static uint16_t dmx_segments[DMX_BUFFERS];
+
+static volatile uint8_t capture_index;      ///< Buffer the DMA writes into
+static volatile int8_t ready_index = -1;    ///< Complete buffer waiting for ICLED_DMX_Process()
+static volatile int8_t in_use_index = -1;   ///< Buffer ICLED_DMX_Process() is reading
+static volatile bool capturing;             ///< DMA armed for the current packet
+static uint16_t capture_length;             ///< Bytes the DMA captures per packet
+
+static volatile uint16_t mapping_start = ICLED_DMX_START_ADDRESS;
+static volatile uint16_t mapping_segments = ICLED_DMX_SEGMENTS;
+
+static uint32_t last_frame_tick;
+static bool frame_shown;
+
+static volatile ICLED_DMXStats dmx_stats;
+
+/**
+ * @brief Hands the captured buffer over to ICLED_DMX_Process() and picks the next one.
+ *
+ * @param length Number of captured bytes including the start code.
+ */
+static void DMX_Complete( uint16_t length )
+{
+    uint8_t index = capture_index;
+
+    HAL_DMA_Abort( &hdma_usart1_rx );
+    capturing = false;
+
+    if( dmx_buffer[index][0] != 0x00 )
+    {
+        // alternate start codes (RDM, text packets, ...) carry no dimmer data
+        dmx_stats.ignored++;
+        return;
+    }
+
+    dmx_length[index] = length;
+    ready_index = ( int8_t )index;
+
+    // a ready buffer that was not taken yet is replaced, the one being read is skipped
+    uint8_t next = 0;
+    while( ( next == index ) || ( ( int8_t )next == in_use_index ) ) next++;
+    capture_index = next;
+}
+
+/**
+ * @brief DMA transfer complete: the last slot of the footprint arrived.
+ *
+ * @param hdma DMA handle (unused).
+ */
+static void DMX_DmaComplete( DMA_HandleTypeDef *hdma )
+{
+    ( void )hdma;
+
+    if( capturing )
+    {
+        DMX_Complete( capture_length );
+    }
+}
+
+/**
+ * @brief Arms the DMA for the packet following a break.
+ */
+static void DMX_Arm( void )
+{
+    uint8_t index = capture_index;
+
+    HAL_DMA_Abort( &hdma_usart1_rx );
+
+    // the mapping is latched per packet so ICLED_DMX_SetMapping() never tears a frame
+    dmx_start[index] = mapping_start;
+    dmx_segments[index] = mapping_segments;
+    capture_length = dmx_start[index] + 3 * dmx_segments[index];
+
+    if( HAL_DMA_Start_IT( &hdma_usart1_rx, ( uint32_t )&huart1.Instance->RDR, ( uint32_t )dmx_buffer[index], capture_length ) == HAL_OK )
+    {
+        capturing = true;
+    }
+}
+
+/**
+ * @brief Starts the DMX512 reception on USART1.
+ */
+void ICLED_DMX_Init( void )
+{
+#if ICLED_OUTPUT_USART || ICLED_QUAD
+    // USART1 drives the LEDs or DMA1 channel 5 feeds QUADSPI, the receiver stays off
+    ( void )DMX_DmaComplete;
+#else
+    hdma_usart1_rx.XferCpltCallback = DMX_DmaComplete;
+    hdma_usart1_rx.XferHalfCpltCallback = NULL;
+    hdma_usart1_rx.XferErrorCallback = NULL;
+
+    // Error interrupts (break = framing error) only fire with DMAR set, so it stays set
+    __HAL_UART_SEND_REQ( &huart1, UART_RXDATA_FLUSH_REQUEST );
+    __HAL_UART_CLEAR_FLAG( &huart1, UART_CLEAR_FEF | UART_CLEAR_NEF );
+    SET_BIT( huart1.Instance->CR3, USART_CR3_DMAR | USART_CR3_EIE );
+#endif
+}
+
+/**
+ * @brief USART1 interrupt handler (break detection).
+ */
+void ICLED_DMX_IRQHandler( void )
+{
+    uint32_t isr = huart1.Instance->ISR;
+
+    if( !( isr & ( USART_ISR_FE | USART_ISR_NE ) ) )
+    {
+        return;
+    }
+
+    // RXNE has to be cleared before the error flag to unmask the DMA request again
+    uint8_t data = ( uint8_t )huart1.Instance->RDR;
+    __HAL_UART_CLEAR_FLAG( &huart1, UART_CLEAR_FEF | UART_CLEAR_NEF );
+
+    if( ( isr & USART_ISR_FE ) && ( data == 0x00 ) )
+    {
+        // Break: finish a packet shorter than the footprint, then wait for the next start code
+        uint16_t received = capture_length - ( uint16_t )__HAL_DMA_GET_COUNTER( &hdma_usart1_rx );
+        if( capturing && ( received > 0 ) )
+        {
+            DMX_Complete( received );
+        }
+
+        dmx_stats.breaks++;
+        DMX_Arm( );
+    }
+    else
+    {
+        // corrupted slot, drop the packet and resync on the next break
+        dmx_stats.errors++;
+        HAL_DMA_Abort( &hdma_usart1_rx );
+        capturing = false;
+    }
+}
+
+/**
+ * @brief Changes the slot mapping, takes effect with the next packet.
+ */
+bool ICLED_DMX_SetMapping( uint16_t start_address, uint16_t segments )
+{
+    if( ( start_address < 1 ) || ( segments < 1 ) || ( segments > ICLED_LED_COUNT ) ) return false;
+    if( ( start_address + 3 * segments - 1 ) > ICLED_DMX_SLOTS ) return false;
+
+    __disable_irq( );
+    mapping_start = start_address;
+    mapping_segments = segments;
+    __enable_irq( );
+
+    return true;
+}
+
+/**
+ * @brief Maps a received frame onto the LEDs and shows it.
+ *
+ * Each segment covers an equal run of LEDs. The RGB slots are written in GRB
+ * order straight into the pixel buffer; slots missing in a short packet are 0.
+ */
+void ICLED_DMX_Process( void )
+{
+    __disable_irq( );
+    int8_t index = ready_index;
+    ready_index = -1;
+    in_use_index = index;
+    __enable_irq( );
+
+    if( index < 0 ) return;
+
+    const uint8_t *slots = dmx_buffer[index];
+    uint16_t length = dmx_length[index];
+    uint16_t slot = dmx_start[index];
+    uint16_t segments = dmx_segments[index];
+    uint16_t leds_per_segment = ( ICLED_LED_COUNT + segments - 1 ) / segments;
+    uint8_t *frame = ICLED_GetBuffer( );
+    uint16_t led = 0;
+
+    for( uint16_t s = 0; ( s < segments ) && ( led < ICLED_LED_COUNT ); s++, slot += 3 )
+    {
+        uint8_t r = ( slot     < length ) ? slots[slot]     : 0;
+        uint8_t g = ( slot + 1 < length ) ? slots[slot + 1] : 0;
+        uint8_t b = ( slot + 2 < length ) ? slots[slot + 2] : 0;
+
+        for( uint16_t n = 0; ( n < leds_per_segment ) && ( led < ICLED_LED_COUNT ); n++, led++ )
+        {
+            frame[led * 3 + 0] = g; // GRB!
+            frame[led * 3 + 1] = r;
+            frame[led * 3 + 2] = b;
+        }
+    }
+
+    // the receiver may capture into this buffer again
+    in_use_index = -1;
+
+    ICLED_Interp_Push( );
+
+    dmx_stats.frames++;
+    last_frame_tick = HAL_GetTick( );
+    frame_shown = true;
+}
+
+/**
+ * @brief Checks whether DMX frames are being received.
+ */
+bool ICLED_DMX_IsActive( void )
+{
+    return frame_shown && ( ( HAL_GetTick( ) - last_frame_tick ) < ICLED_DMX_HOLD_MS );
+}
+
+/**
+ * @brief Copies the receiver counters.
+ */
+void ICLED_DMX_GetStats( ICLED_DMXStats *stats )
+{
+    if( stats == NULL ) return;
+
+    memcpy( stats, ( const void * )&dmx_stats, sizeof( dmx_stats ) );
+}
@@ -0,0 +1,379 @@
+/**
+ * @file icled_i2c.c
+ * @author MootSeeker
+ * @brief I2C slave register map to control the ICLED matrix from a host MCU.
+ *
+ * Uses the HAL I2C driver in listen mode with the sequential DMA transfers.
+ * A write is received into rx_buffer and copied into the register map at its
+ * end (STOP, repeated start or NACK), ICLED_I2C_Process() applies the changed
+ * registers between two frames. A read sends a snapshot of the map.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_i2c.h"
+
+#include "i2c.h"
+#include "icled.h"
+#include "icled_load.h"
+#include "example_app.h"
+
+#include <string.h>
+
+#define I2C_DIRTY_CONTROL   0x01
+#define I2C_DIRTY_EFFECT    0x02
+#define I2C_DIRTY_PARAMS    0x04
+#define I2C_DIRTY_WINDOW    0x08
+#define I2C_DIRTY_DROP      0x10
+
+/**
+ * @brief Register map as written by the host.
+ */
+static uint8_t regs[ICLED_I2C_REG_COUNT];
+
+/**
+ * @brief Register address and data of a write transfer.
+ *
+ * One byte larger than the longest valid write, a full buffer means the
+ * master wrote past the end of the map.
+ */
+static uint8_t rx_buffer[ICLED_I2C_REG_COUNT + 2];
+
+/**
+ * @brief Snapshot of the register map for a read transfer.
+ */
+static uint8_t tx_buffer[ICLED_I2C_REG_COUNT];
+
+static volatile bool receiving;             ///< rx_buffer is being filled by the DMA
+static volatile uint8_t reg_pointer;        ///< Register of the next read
+static volatile uint8_t dirty;              ///< I2C_DIRTY_* of the registers not applied yet
+static volatile bool direct_mode;
+
+static volatile uint32_t write_count;
+static volatile uint32_t error_count;
+
+/**
+ * @brief Returns the I2C_DIRTY_* flag of a writable register, 0 for read-only registers.
+ */
+static uint8_t I2C_DirtyFlag( uint8_t reg )
+{
+    if( reg == ICLED_I2C_REG_CONTROL ) return I2C_DIRTY_CONTROL;
+    if( reg == ICLED_I2C_REG_EFFECT ) return I2C_DIRTY_EFFECT;
+    if( reg == ICLED_I2C_REG_DROP ) return I2C_DIRTY_DROP;
+
+    if( ( reg >= ICLED_I2C_REG_BRIGHTNESS ) && ( reg <= ICLED_I2C_REG_DELAY + 1 ) )
+    {
+        return I2C_DIRTY_PARAMS;
+    }
+
+    if( ( reg == ICLED_I2C_REG_SEGMENT_START ) || ( reg == ICLED_I2C_REG_SEGMENTS ) ||
+        ( ( reg >= ICLED_I2C_REG_WINDOW ) && ( reg < ICLED_I2C_REG_COUNT ) ) )
+    {
+        return I2C_DIRTY_WINDOW;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Stores a 32 bit value little endian.
+ */
+static void I2C_PutU32( uint8_t *dst, uint32_t value )
+{
+    dst[0] = ( uint8_t )( value );
+    dst[1] = ( uint8_t )( value >> 8 );
+    dst[2] = ( uint8_t )( value >> 16 );
+    dst[3] = ( uint8_t )( value >> 24 );
+}
+
+/**
+ * @brief Copies a finished write transfer into the register map.
+ *
+ * The first byte sets the register address, the data bytes follow with
+ * auto-increment. Writes to read-only registers are ignored.
+ */
+static void I2C_TakeWrite( void )
+{
+    if( !receiving ) return;
+    receiving = false;
+
+    uint16_t length = sizeof( rx_buffer ) - ( uint16_t )__HAL_DMA_GET_COUNTER( hi2c1.hdmarx );
+    if( length == 0 ) return;
+
+    uint16_t reg = rx_buffer[0];
+
+    for( uint16_t i = 1; i < length; i++, reg++ )
+    {
+        if( reg >= ICLED_I2C_REG_COUNT )
+        {
+            error_count++;
+            break;
+        }
+
+        uint8_t flag = I2C_DirtyFlag( ( uint8_t )reg );
+        if( flag == 0 ) continue;
+
+        regs[reg] = rx_buffer[i];
+        dirty |= flag;
+    }
+
+    reg_pointer = ( reg < ICLED_I2C_REG_COUNT ) ? ( uint8_t )reg : 0;
+
+    if( length > 1 )
+    {
+        write_count++;
+    }
+}
+
+/**
+ * @brief Takes the snapshot for a read, including the live counters.
+ */
+static void I2C_PrepareRead( void )
+{
+    memcpy( tx_buffer, regs, sizeof( tx_buffer ) );
+
+    if( !( dirty & I2C_DIRTY_EFFECT ) )
+    {
+        // S2 may have changed the effect in the meantime
+        tx_buffer[ICLED_I2C_REG_EFFECT] = example_app_get_effect( );
+    }
+
+    I2C_PutU32( &tx_buffer[ICLED_I2C_REG_FRAMES], ICLED_GetFrameCount( ) );
+    I2C_PutU32( &tx_buffer[ICLED_I2C_REG_WRITES], write_count );
+    I2C_PutU32( &tx_buffer[ICLED_I2C_REG_ERRORS], error_count );
+    I2C_PutU32( &tx_buffer[ICLED_I2C_REG_UPTIME], HAL_GetTick( ) );
+
+    ICLED_LoadStats load;
+    ICLED_Load_GetStats( &load );
+    uint16_t headroom = ( load.headroom_us < UINT16_MAX ) ? ( uint16_t )load.headroom_us : UINT16_MAX;
+    tx_buffer[ICLED_I2C_REG_LOAD] = load.load;
+    tx_buffer[ICLED_I2C_REG_LOAD_PEAK] = load.peak;
+    tx_buffer[ICLED_I2C_REG_HEADROOM] = ( uint8_t )headroom;
+    tx_buffer[ICLED_I2C_REG_HEADROOM + 1] = ( uint8_t )( headroom >> 8 );
+}
+
+/**
+ * @brief Starts listening on I2C1.
+ */
+void ICLED_I2C_Init( void )
+{
+    regs[ICLED_I2C_REG_ID] = ICLED_I2C_ID;
+    regs[ICLED_I2C_REG_VERSION] = ICLED_I2C_VERSION;
+    regs[ICLED_I2C_REG_EFFECT] = example_app_get_effect( );
+    regs[ICLED_I2C_REG_SEGMENTS] = ICLED_LED_COUNT;
+
+    if( HAL_I2C_EnableListen_IT( &hi2c1 ) != HAL_OK )
+    {
+        Error_Handler( );
+    }
+}
+
+/**
+ * @brief Address match: receive the register address and data, or send the map.
+ *
+ * @param hi2c              I2C handle.
+ * @param TransferDirection I2C_DIRECTION_TRANSMIT if the master writes.
+ * @param AddrMatchCode     Matched address (unused, only one address).
+ */
+void HAL_I2C_AddrCallback( I2C_HandleTypeDef *hi2c, uint8_t TransferDirection, uint16_t AddrMatchCode )
+{
+    ( void )AddrMatchCode;
+
+    if( hi2c->Instance != I2C1 ) return;
+
+    // a repeated start ends the preceding write, usually the register address of this read
+    I2C_TakeWrite( );
+
+    if( TransferDirection == I2C_DIRECTION_TRANSMIT )
+    {
+        receiving = true;
+        if( HAL_I2C_Slave_Seq_Receive_DMA( hi2c, rx_buffer, sizeof( rx_buffer ), I2C_FIRST_FRAME ) != HAL_OK )
+        {
+            receiving = false;
+            error_count++;
+        }
+    }
+    else
+    {
+        uint8_t reg = reg_pointer;
+
+        I2C_PrepareRead( );
+        if( HAL_I2C_Slave_Seq_Transmit_DMA( hi2c, &tx_buffer[reg], ICLED_I2C_REG_COUNT - reg, I2C_LAST_FRAME ) != HAL_OK )
+        {
+            error_count++;
+        }
+    }
+}
+
+/**
+ * @brief The master reads past the end of the map, continue at register 0.
+ *
+ * @param hi2c I2C handle.
+ */
+void HAL_I2C_SlaveTxCpltCallback( I2C_HandleTypeDef *hi2c )
+{
+    if( hi2c->Instance != I2C1 ) return;
+
+    HAL_I2C_Slave_Seq_Transmit_DMA( hi2c, tx_buffer, sizeof( tx_buffer ), I2C_LAST_FRAME );
+}
+
+/**
+ * @brief The master writes past the end of the map, keep the valid part and drop the rest.
+ *
+ * @param hi2c I2C handle.
+ */
+void HAL_I2C_SlaveRxCpltCallback( I2C_HandleTypeDef *hi2c )
+{
+    if( hi2c->Instance != I2C1 ) return;
+
+    I2C_TakeWrite( );
+    HAL_I2C_Slave_Seq_Receive_DMA( hi2c, rx_buffer, sizeof( rx_buffer ), I2C_NEXT_FRAME );
+}
+
+/**
+ * @brief STOP condition: take over the write and listen for the next transfer.
+ *
+ * @param hi2c I2C handle.
+ */
+void HAL_I2C_ListenCpltCallback( I2C_HandleTypeDef *hi2c )
+{
+    if( hi2c->Instance != I2C1 ) return;
+
+    I2C_TakeWrite( );
+    HAL_I2C_EnableListen_IT( hi2c );
+}
+
+/**
+ * @brief Transfer ended by NACK, an aborted DMA or a bus error.
+ *
+ * The master NACKs the last byte of every read and the HAL reports writes
+ * shorter than the buffer as NACK as well, both are normal ends.
+ *
+ * @param hi2c I2C handle.
+ */
+void HAL_I2C_ErrorCallback( I2C_HandleTypeDef *hi2c )
+{
+    if( hi2c->Instance != I2C1 ) return;
+
+    if( ( hi2c->ErrorCode & ~HAL_I2C_ERROR_AF ) != HAL_I2C_ERROR_NONE )
+    {
+        // drop a write that was disturbed on the bus
+        receiving = false;
+        error_count++;
+    }
+
+    I2C_TakeWrite( );
+
+    if( HAL_I2C_GetState( hi2c ) == HAL_I2C_STATE_READY )
+    {
+        HAL_I2C_EnableListen_IT( hi2c );
+    }
+}
+
+/**
+ * @brief Applies the registers written since the last call.
+ *
+ * Takes a snapshot of the map with the interrupts disabled, so all writes
+ * that ended before this point are applied together and none partially.
+ */
+void ICLED_I2C_Process( void )
+{
+    uint8_t snapshot[ICLED_I2C_REG_COUNT];
+
+    __disable_irq( );
+    uint8_t changes = dirty;
+    if( ( changes == 0 ) || ( regs[ICLED_I2C_REG_CONTROL] & ICLED_I2C_CONTROL_HOLD ) )
+    {
+        __enable_irq( );
+        return;
+    }
+    memcpy( snapshot, regs, sizeof( snapshot ) );
+    regs[ICLED_I2C_REG_CONTROL] &= ( uint8_t )~ICLED_I2C_CONTROL_CLEAR;
+    dirty = 0;
+    __enable_irq( );
+
+    uint8_t control = snapshot[ICLED_I2C_REG_CONTROL];
+    bool show = false;
+
+    if( changes & I2C_DIRTY_EFFECT )
+    {
+        if( !example_app_set_effect( snapshot[ICLED_I2C_REG_EFFECT] ) )
+        {
+            error_count++;
+        }
+    }
+
+    if( changes & I2C_DIRTY_PARAMS )
+    {
+        uint16_t delay = ( uint16_t )( snapshot[ICLED_I2C_REG_DELAY] | ( snapshot[ICLED_I2C_REG_DELAY + 1] << 8 ) );
+        example_app_set_params( snapshot[ICLED_I2C_REG_BRIGHTNESS], delay );
+    }
+
+    if( changes & I2C_DIRTY_DROP )
+    {
+        if( !example_app_drop( snapshot[ICLED_I2C_REG_DROP] ) )
+        {
+            error_count++;
+        }
+    }
+
+    direct_mode = ( control & ICLED_I2C_CONTROL_DIRECT ) != 0;
+
+    uint8_t *frame = ICLED_GetBuffer( );
+
+    if( control & ICLED_I2C_CONTROL_CLEAR )
+    {
+        memset( frame, 0, ICLED_LED_COUNT * 3 );
+        show = true;
+    }
+
+    if( direct_mode && ( changes & ( I2C_DIRTY_WINDOW | I2C_DIRTY_CONTROL ) ) )
+    {
+        uint16_t segments = snapshot[ICLED_I2C_REG_SEGMENTS];
+        if( ( segments == 0 ) || ( segments > ICLED_LED_COUNT ) ) segments = ICLED_LED_COUNT;
+
+        uint16_t leds_per_segment = ( ICLED_LED_COUNT + segments - 1 ) / segments;
+        const uint8_t *rgb = &snapshot[ICLED_I2C_REG_WINDOW];
+
+        for( uint16_t p = 0; p < ICLED_I2C_WINDOW_PIXELS; p++, rgb += 3 )
+        {
+            uint16_t segment = snapshot[ICLED_I2C_REG_SEGMENT_START] + p;
+            if( segment >= segments ) break;
+
+            uint16_t led = segment * leds_per_segment;
+            for( uint16_t n = 0; ( n < leds_per_segment ) && ( led < ICLED_LED_COUNT ); n++, led++ )
+            {
+                frame[led * 3 + 0] = rgb[1]; // GRB!
+                frame[led * 3 + 1] = rgb[0];
+                frame[led * 3 + 2] = rgb[2];
+            }
+        }
+        show = true;
+    }
+
+    if( show )
+    {
+        ICLED_Show( );
+    }
+}
+
+/**
+ * @brief Checks whether the host has taken over the matrix.
+ */
+bool ICLED_I2C_IsActive( void )
+{
+    return direct_mode;
+}
+
+/**
+ * @brief Copies the counters.
+ */
+void ICLED_I2C_GetStats( ICLED_I2CStats *stats )
+{
+    if( stats == NULL ) return;
+
+    stats->writes = write_count;
+    stats->errors = error_count;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file icled_interp.c
+ * @author MootSeeker
+ * @brief Frame interpolation between content frames at the LED output rate.
+ *
+ * A channel is blended as ( a * ( 256 - w ) + b * w ) >> 8, which never
+ * exceeds 16 bits. Two channels side by side in the halfwords of a word (as
+ * UXTB16 extracts them) are therefore scaled with one 32-bit multiply without
+ * a carry from the lower into the upper half, and a word of four channels
+ * takes two multiply-accumulate pairs.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_interp.h"
+
+#include "main.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INTERP_BYTES        ( ICLED_LED_COUNT * 3 )
+#define INTERP_COLUMN       ( ICLED_ROWS * 3 )      ///< Bytes per column
+#define INTERP_ONE          256U                    ///< Weight of the next frame alone
+
+#if defined( __ARM_FEATURE_DSP ) && ( __ARM_FEATURE_DSP == 1 )
+#define INTERP_EVEN( x )    __UXTB16( x )
+#define INTERP_ODD( x )     __UXTB16( __ROR( ( x ), 8 ) )
+#else
+#define INTERP_EVEN( x )    ( ( x ) & 0x00FF00FFU )
+#define INTERP_ODD( x )     ( ( ( x ) >> 8 ) & 0x00FF00FFU )
+#endif
+
+static ICLED_InterpStats interp_stats;
+
+#if ICLED_INTERP
+static uint8_t key_prev[INTERP_BYTES];      ///< Content frame the blend starts from
+static uint8_t key_next[INTERP_BYTES];      ///< Content frame the blend ends at
+static uint8_t blend[INTERP_BYTES];         ///< Frame on the LEDs
+
+static uint32_t next_tick;                  ///< Arrival of key_next
+static uint16_t weight = INTERP_ONE;        ///< Weight of the frame on the LEDs
+static bool running;
+
+#if ICLED_INTERP_MOTION
+static uint8_t strip[( ICLED_COLUMNS + ICLED_INTERP_MOTION_MAX ) * INTERP_COLUMN];
+static int8_t shift;                        ///< Columns the content moved from key_prev to key_next
+#endif
+
+/**
+ * @brief Blends four channels.
+ */
+static inline uint32_t Interp_LerpWord( uint32_t a, uint32_t b, uint32_t w )
+{
+    uint32_t inv = INTERP_ONE - w;
+    uint32_t even = INTERP_EVEN( a ) * inv + INTERP_EVEN( b ) * w;
+    uint32_t odd = INTERP_ODD( a ) * inv + INTERP_ODD( b ) * w;
+
+    // the result bytes are the upper bytes of each halfword
+    return ( ( even >> 8 ) & 0x00FF00FFU ) | ( odd & 0xFF00FF00U );
+}
+
+/**
+ * @brief Blends two byte arrays of any alignment.
+ */
+static void Interp_Lerp( uint8_t *out, const uint8_t *a, const uint8_t *b, uint16_t length, uint32_t w )
+{
+    uint16_t i = 0;
+
+    // memcpy() of a word is a single (unaligned) LDR/STR on the Cortex-M4
+    for( ; ( uint16_t )( i + 4 ) <= length; i += 4 )
+    {
+        uint32_t wa;
+        uint32_t wb;
+        memcpy( &wa, &a[i], 4 );
+        memcpy( &wb, &b[i], 4 );
+
+        uint32_t result = Interp_LerpWord( wa, wb, w );
+        memcpy( &out[i], &result, 4 );
+    }
+
+    for( ; i < length; i++ )
+    {
+        out[i] = ( uint8_t )( ( a[i] * ( INTERP_ONE - w ) + b[i] * w ) >> 8 );
+    }
+}
+
+#if ICLED_INTERP_MOTION
+/**
+ * @brief Finds the column shift that turns key_prev into key_next, 0 if there is none.
+ */
+static int8_t Interp_FindShift( void )
+{
+    uint32_t still = 0;
+    for( uint16_t i = 0; i < INTERP_BYTES; i++ )
+    {
+        still += ( uint32_t )abs( key_next[i] - key_prev[i] );
+    }
+
+    // nothing changed or a cut, neither is a move
+    if( still == 0 ) return 0;
+
+    int8_t best = 0;
+    uint32_t best_mean = UINT32_MAX;
+
+    for( int8_t k = -ICLED_INTERP_MOTION_MAX; k <= ICLED_INTERP_MOTION_MAX; k++ )
+    {
+        if( k == 0 ) continue;
+
+        // column c of the next frame against column c + k of the previous one
+        uint16_t first = ( k < 0 ) ? ( uint16_t )-k : 0;
+        uint16_t last = ( k > 0 ) ? ( uint16_t )( ICLED_COLUMNS - k ) : ICLED_COLUMNS;
+        uint32_t sum = 0;
+
+        for( uint16_t i = first * INTERP_COLUMN; i < last * INTERP_COLUMN; i++ )
+        {
+            sum += ( uint32_t )abs( key_next[i] - key_prev[i + k * INTERP_COLUMN] );
+        }
+
+        uint32_t mean = sum / ( ( last - first ) * INTERP_COLUMN );
+        if( mean < best_mean )
+        {
+            best_mean = mean;
+            best = k;
+        }
+    }
+
+    // the shifted frames have to match, and clearly better than the frames in place
+    if( ( best_mean > ICLED_INTERP_MOTION_TOLERANCE ) || ( best_mean * 4 * INTERP_BYTES >= still ) )
+    {
+        return 0;
+    }
+
+    return best;
+}
+
+/**
+ * @brief Lines up key_prev and the columns that enter with the move in strip[].
+ */
+static void Interp_BuildStrip( void )
+{
+    uint16_t entering = ( uint16_t )( ( shift < 0 ) ? -shift : shift ) * INTERP_COLUMN;
+
+    if( shift > 0 )
+    {
+        // content moves left, new columns enter at the right
+        memcpy( strip, key_prev, INTERP_BYTES );
+        memcpy( &strip[INTERP_BYTES], &key_next[INTERP_BYTES - entering], entering );
+    }
+    else
+    {
+        memcpy( strip, key_next, entering );
+        memcpy( &strip[entering], key_prev, INTERP_BYTES );
+    }
+}
+
+/**
+ * @brief Renders the move at the given weight, a column between two strip columns is blended.
+ */
+static void Interp_RenderMove( uint32_t w )
+{
+    uint32_t offset = ( shift < 0 ) ? ( uint32_t )-shift : 0;
+
+    for( uint16_t col = 0; col < ICLED_COLUMNS; col++ )
+    {
+        uint32_t position = ( col + offset ) * INTERP_ONE + ( uint32_t )( shift * ( int32_t )w );
+        const uint8_t *left = &strip[( position >> 8 ) * INTERP_COLUMN];
+        uint32_t fraction = position & ( INTERP_ONE - 1 );
+
+        if( fraction == 0 )
+        {
+            memcpy( &blend[col * INTERP_COLUMN], left, INTERP_COLUMN );
+        }
+        else
+        {
+            Interp_Lerp( &blend[col * INTERP_COLUMN], left, left + INTERP_COLUMN, INTERP_COLUMN, fraction );
+        }
+    }
+}
+#endif /* ICLED_INTERP_MOTION */
+#endif /* ICLED_INTERP */
+
+/**
+ * @brief The pixel buffer holds a new content frame.
+ */
+void ICLED_Interp_Push( void )
+{
+    interp_stats.keyframes++;
+
+#if ICLED_INTERP
+    const uint8_t *frame = ICLED_GetBuffer( );
+    uint32_t now = HAL_GetTick( );
+    uint32_t gap = now - next_tick;
+
+    next_tick = now;
+
+    if( !running || ( gap >= ICLED_INTERP_HOLD_MS ) )
+    {
+        // first frame or after a pause: nothing to blend from, show it now
+        memcpy( key_next, frame, INTERP_BYTES );
+        memcpy( blend, frame, INTERP_BYTES );
+        interp_stats.period_ms = 0;
+        weight = INTERP_ONE;
+        running = true;
+
+        ICLED_Show( );
+        return;
+    }
+
+    // the period follows the arrival times, smoothed over about four frames
+    interp_stats.period_ms = ( interp_stats.period_ms == 0 ) ? ( uint16_t )gap :
+                             ( uint16_t )( ( interp_stats.period_ms * 3U + gap + 2U ) / 4U );
+    if( interp_stats.period_ms == 0 ) interp_stats.period_ms = 1;
+
+#if ICLED_INTERP_MOTION
+    // whole frames, so the shift between them is exact
+    memcpy( key_prev, key_next, INTERP_BYTES );
+    memcpy( key_next, frame, INTERP_BYTES );
+
+    shift = Interp_FindShift( );
+    if( shift != 0 )
+    {
+        Interp_BuildStrip( );
+        interp_stats.moves++;
+    }
+#else
+    // start from what the LEDs show, a frame that comes early does not jump
+    memcpy( key_prev, blend, INTERP_BYTES );
+    memcpy( key_next, frame, INTERP_BYTES );
+#endif
+
+    weight = 0;
+#else
+    ICLED_Show( );
+#endif
+}
+
+/**
+ * @brief Shows the next in-between frame once the LED output is free.
+ */
+void ICLED_Interp_Process( void )
+{
+#if ICLED_INTERP
+    if( !running || ( weight >= INTERP_ONE ) || ICLED_IsBusy( NULL ) ) return;
+
+    uint32_t elapsed = HAL_GetTick( ) - next_tick;
+    uint32_t w = ( elapsed >= interp_stats.period_ms ) ? INTERP_ONE : elapsed * INTERP_ONE / interp_stats.period_ms;
+
+    if( w == weight ) return;
+    weight = ( uint16_t )w;
+
+    if( w == INTERP_ONE )
+    {
+        memcpy( blend, key_next, INTERP_BYTES );
+    }
+#if ICLED_INTERP_MOTION
+    else if( shift != 0 )
+    {
+        Interp_RenderMove( w );
+    }
+#endif
+    else
+    {
+        Interp_Lerp( blend, key_prev, key_next, INTERP_BYTES, w );
+    }
+
+    ICLED_ShowBuffer( blend );
+    interp_stats.frames++;
+#endif
+}
+
+/**
+ * @brief Copies the counters.
+ */
+void ICLED_Interp_GetStats( ICLED_InterpStats *stats )
+{
+    if( stats == NULL ) return;
+
+    memcpy( stats, &interp_stats, sizeof( interp_stats ) );
+}
@@ -0,0 +1,143 @@
+/**
+ * @file icled_latency.c
+ * @author MootSeeker
+ * @brief Input-to-photon latency of the frame inputs and the S2 button.
+ *
+ * The stamps of an input move with its frame: pending until the next render,
+ * staged while that frame is encoded (the previous one may still latch in the
+ * meantime), on the wire from the DMA start until transfer complete. Inputs
+ * and latches happen in interrupts, so the hand-overs in the main loop take
+ * place with interrupts disabled for a few cycles.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_latency.h"
+
+#include "main.h"
+#include "icled_telemetry.h"
+
+#include <stdbool.h>
+
+#if ICLED_LATENCY
+static volatile uint32_t input_cycles[ICLED_LATENCY_SOURCE_COUNT];  ///< Latest input not rendered yet
+static volatile bool input_pending[ICLED_LATENCY_SOURCE_COUNT];
+
+static uint32_t staged_cycles[ICLED_LATENCY_SOURCE_COUNT];          ///< Inputs of the frame being encoded
+static bool staged[ICLED_LATENCY_SOURCE_COUNT];
+static uint32_t staged_render;
+
+static uint32_t wire_cycles[ICLED_LATENCY_SOURCE_COUNT];            ///< Inputs of the frame on the wire
+static bool wire[ICLED_LATENCY_SOURCE_COUNT];
+static uint32_t wire_render;
+static uint32_t wire_start;
+
+/**
+ * @brief Adds one latched input to the figures of its source.
+ */
+static void Latency_Sample( volatile ICLED_TelemetryLatency *stats, uint32_t input, uint32_t latch )
+{
+    uint32_t us = ( latch - input ) / ICLED_LATENCY_CYCLES_PER_US;
+    uint32_t bucket = 0;
+
+    for( uint32_t rest = us / ICLED_LATENCY_BUCKET_US; ( rest > 0 ) && ( bucket < ICLED_LATENCY_BUCKETS - 1 ); rest >>= 1 )
+    {
+        bucket++;
+    }
+
+    stats->samples++;
+    stats->last_us = us;
+    if( us > stats->max_us ) stats->max_us = us;
+    stats->render_us = ( wire_render - input ) / ICLED_LATENCY_CYCLES_PER_US;
+    stats->start_us = ( wire_start - wire_render ) / ICLED_LATENCY_CYCLES_PER_US;
+    stats->histogram[bucket]++;
+}
+#endif /* ICLED_LATENCY */
+
+/**
+ * @brief Records the arrival of an input.
+ *
+ * Each source has a single writer (its interrupt or the stream decoder), so
+ * the stamp and the flag need no lock.
+ */
+void ICLED_Latency_Input( ICLED_LatencySource source, uint32_t cycles )
+{
+#if ICLED_LATENCY
+    if( source >= ICLED_LATENCY_SOURCE_COUNT ) return;
+
+    input_cycles[source] = cycles;
+    input_pending[source] = true;
+#else
+    ( void )source; ( void )cycles;
+#endif
+}
+
+/**
+ * @brief Render done: the pending inputs go with the frame about to be encoded.
+ */
+void ICLED_Latency_Render( void )
+{
+#if ICLED_LATENCY
+    staged_render = ICLED_TELEMETRY_CYCLES( );
+
+    __disable_irq( );
+    for( uint8_t s = 0; s < ICLED_LATENCY_SOURCE_COUNT; s++ )
+    {
+        if( input_pending[s] )
+        {
+            staged_cycles[s] = input_cycles[s];
+            staged[s] = true;
+            input_pending[s] = false;
+        }
+    }
+    __enable_irq( );
+#endif
+}
+
+/**
+ * @brief DMA start: the staged inputs are on the wire.
+ *
+ * Inputs of a frame that was cut short stay on the wire unless the new frame
+ * brings a newer input of the same source.
+ */
+void ICLED_Latency_Start( void )
+{
+#if ICLED_LATENCY
+    uint32_t now = ICLED_TELEMETRY_CYCLES( );
+
+    __disable_irq( );
+    for( uint8_t s = 0; s < ICLED_LATENCY_SOURCE_COUNT; s++ )
+    {
+        if( staged[s] )
+        {
+            wire_cycles[s] = staged_cycles[s];
+            wire[s] = true;
+            staged[s] = false;
+        }
+    }
+    wire_render = staged_render;
+    wire_start = now;
+    __enable_irq( );
+#endif
+}
+
+/**
+ * @brief Latch done: every input on the wire becomes a sample.
+ */
+void ICLED_Latency_Latch( void )
+{
+#if ICLED_LATENCY
+    uint32_t now = ICLED_TELEMETRY_CYCLES( );
+
+    for( uint8_t s = 0; s < ICLED_LATENCY_SOURCE_COUNT; s++ )
+    {
+        if( wire[s] )
+        {
+            Latency_Sample( &icled_telemetry.latency[s], wire_cycles[s], now );
+            wire[s] = false;
+        }
+    }
+#endif
+}
@@ -0,0 +1,160 @@
+/**
+ * @file icled_load.c
+ * @author MootSeeker
+ * @brief CPU load monitor based on idle-time accounting.
+ *
+ * HAL_Delay() is weak in the HAL, the version here waits the same way but
+ * counts the waiting cycles as idle and can sleep in between. All counting
+ * happens in the main loop context, the interrupt-safe results are written
+ * once per second.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_load.h"
+
+#include "icled.h"
+#include "main.h"
+
+#include <string.h>
+
+static uint32_t idle_cycles;        ///< Idle cycles of the running sample
+static uint32_t sample_cycles;      ///< CYCCNT at the start of the running sample
+static uint32_t sample_tick;        ///< HAL tick at the start of the running sample
+static uint32_t sample_frames;      ///< Frame count at the start of the running sample
+static uint32_t pass_cycles;        ///< CYCCNT at the start of the current main loop pass
+
+static uint8_t history[ICLED_LOAD_WINDOW];
+static uint16_t history_next;
+static uint16_t history_count;
+
+static volatile ICLED_LoadStats load_stats;
+
+/**
+ * @brief Waits like the HAL version and counts the time as idle.
+ */
+void HAL_Delay( uint32_t Delay )
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t tickstart = HAL_GetTick( );
+    uint32_t wait = Delay;
+
+    /* Add a period to guaranty minimum wait */
+    if( wait < HAL_MAX_DELAY )
+    {
+        wait += ( uint32_t )uwTickFreq;
+    }
+
+    while( ( HAL_GetTick( ) - tickstart ) < wait )
+    {
+#if ICLED_LOAD_SLEEP
+        __WFI( );
+#endif
+    }
+
+    idle_cycles += DWT->CYCCNT - start;
+}
+
+/**
+ * @brief Starts the cycle counter and the first sample.
+ */
+void ICLED_Load_Init( void )
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    idle_cycles = 0;
+    sample_cycles = pass_cycles = DWT->CYCCNT;
+    sample_tick = HAL_GetTick( );
+    sample_frames = ICLED_GetFrameCount( );
+
+    load_stats.headroom_us = ICLED_LOAD_NO_FRAMES;
+}
+
+/**
+ * @brief The current main loop pass had nothing to do.
+ */
+void ICLED_Load_Idle( void )
+{
+#if ICLED_LOAD_SLEEP
+    __WFI( );
+#endif
+
+    // the polling of this pass was idle as well
+    idle_cycles += DWT->CYCCNT - pass_cycles;
+    pass_cycles = DWT->CYCCNT;
+}
+
+/**
+ * @brief Turns the finished second into a sample.
+ */
+static void Load_Sample( uint32_t total )
+{
+    uint32_t frames = ICLED_GetFrameCount( ) - sample_frames;
+    uint32_t idle = ( idle_cycles < total ) ? idle_cycles : total;
+    uint8_t load = ( uint8_t )( 100U - ( uint32_t )( ( uint64_t )idle * 100U / total ) );
+
+    history[history_next] = load;
+    history_next = ( history_next + 1 ) % ICLED_LOAD_WINDOW;
+    if( history_count < ICLED_LOAD_WINDOW ) history_count++;
+
+    uint16_t histogram[ICLED_LOAD_BUCKETS] = {0};
+    uint8_t peak = 0;
+
+    for( uint16_t i = 0; i < history_count; i++ )
+    {
+        uint8_t bucket = history[i] * ICLED_LOAD_BUCKETS / 100;
+        histogram[( bucket < ICLED_LOAD_BUCKETS ) ? bucket : ICLED_LOAD_BUCKETS - 1]++;
+        if( history[i] > peak ) peak = history[i];
+    }
+
+    uint32_t headroom = ICLED_LOAD_NO_FRAMES;
+    if( frames > 0 )
+    {
+        headroom = ( uint32_t )( ( uint64_t )idle * 1000000U / SystemCoreClock / frames );
+    }
+
+    // readers may be interrupts (e.g. the I2C register snapshot)
+    __disable_irq( );
+    load_stats.load = load;
+    load_stats.peak = peak;
+    load_stats.fps = ( uint16_t )( ( frames < UINT16_MAX ) ? frames : UINT16_MAX );
+    load_stats.headroom_us = headroom;
+    load_stats.samples = history_count;
+    memcpy( ( void * )load_stats.histogram, histogram, sizeof( histogram ) );
+    __enable_irq( );
+}
+
+/**
+ * @brief Closes the one-second sample when it is due.
+ */
+void ICLED_Load_Process( void )
+{
+    uint32_t now = DWT->CYCCNT;
+
+    if( ( HAL_GetTick( ) - sample_tick ) >= 1000U )
+    {
+        Load_Sample( now - sample_cycles );
+
+        idle_cycles = 0;
+        sample_cycles = now;
+        sample_tick = HAL_GetTick( );
+        sample_frames = ICLED_GetFrameCount( );
+    }
+
+    pass_cycles = now;
+}
+
+/**
+ * @brief Copies the load figures.
+ */
+void ICLED_Load_GetStats( ICLED_LoadStats *stats )
+{
+    if( stats == NULL ) return;
+
+    __disable_irq( );
+    memcpy( stats, ( const void * )&load_stats, sizeof( load_stats ) );
+    __enable_irq( );
+}
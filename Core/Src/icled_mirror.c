@@ -0,0 +1,234 @@
+/**
+ * @file icled_mirror.c
+ * @author MootSeeker
+ * @brief Live mirror of the transmitted frames on USART2 TX.
+ *
+ * The HAL UART handle belongs to the stream receiver, so the TX channel is
+ * driven on register level: the packet is written to its buffer while the
+ * channel is idle, then CNDTR and EN start it. The channel is polled, it
+ * needs no interrupt.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_mirror.h"
+#include "icled_bench.h"
+
+#include "main.h"
+#include "usart.h"
+#include "icled_telemetry.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#if ICLED_MIRROR && ICLED_BENCH
+#error "ICLED_MIRROR and ICLED_BENCH both send on USART2 TX"
+#endif
+
+#if ( ICLED_MIRROR_SHARE < 1 ) || ( ICLED_MIRROR_SHARE > 100 )
+#error "ICLED_MIRROR_SHARE is a percentage (1 ... 100)"
+#endif
+
+#define MIRROR_BYTES        ( ICLED_LED_COUNT * 3 )
+#define MIRROR_DMA          DMA1_Channel7
+#define MIRROR_DMA_REQUEST  2U      ///< USART2_TX on DMA1 channel 7 (CSELR C7S)
+
+static ICLED_MirrorStats mirror_stats;
+
+#if ICLED_MIRROR
+static uint8_t current[MIRROR_BYTES];   ///< Frame to send
+static uint8_t sent[MIRROR_BYTES];      ///< Frame the receiver has after the last packet
+static uint8_t tx[ICLED_MIRROR_HEADER + MIRROR_BYTES + 1];
+
+static uint32_t sent_count;             ///< Frame count of the last frame sent
+static uint32_t key_tick;               ///< HAL tick of the last key frame
+static uint32_t send_cycles;            ///< Start of the last packet
+static uint32_t hold_cycles;            ///< Line time the last packet has to be followed by
+static uint32_t char_cycles;            ///< Cycles per character on the line
+static uint8_t seq;
+static bool started;
+
+/**
+ * @brief The channel still sends the previous packet.
+ */
+static bool Mirror_IsBusy( void )
+{
+    return READ_BIT( MIRROR_DMA->CCR, DMA_CCR_EN ) && ( MIRROR_DMA->CNDTR != 0U );
+}
+
+/**
+ * @brief The previous packets have used up the share of the line.
+ */
+static bool Mirror_IsLimited( void )
+{
+    if( hold_cycles == 0 ) return false;
+
+    if( ( ICLED_TELEMETRY_CYCLES( ) - send_cycles ) < hold_cycles ) return true;
+
+    // expired, a wrap of the cycle counter cannot bring it back
+    hold_cycles = 0;
+    return false;
+}
+
+/**
+ * @brief Runs of changed pixels against the last frame sent.
+ *
+ * @return Payload length, 0 without changes, MIRROR_BYTES or more if a key frame is not larger.
+ */
+static uint16_t Mirror_EncodeDelta( uint8_t *out )
+{
+    uint16_t length = 0;
+    uint16_t skip = 0;
+    uint16_t pixel = 0;
+
+    while( pixel < ICLED_LED_COUNT )
+    {
+        if( memcmp( &current[pixel * 3], &sent[pixel * 3], 3 ) == 0 )
+        {
+            skip++;
+            pixel++;
+            continue;
+        }
+
+        uint16_t count = 1;
+        while( ( pixel + count < ICLED_LED_COUNT ) && ( count < 255 ) &&
+               ( memcmp( &current[( pixel + count ) * 3], &sent[( pixel + count ) * 3], 3 ) != 0 ) )
+        {
+            count++;
+        }
+
+        for( ; skip > 255; skip -= 255 )
+        {
+            if( length + 2 >= MIRROR_BYTES ) return MIRROR_BYTES;
+            out[length++] = 255;
+            out[length++] = 0;
+        }
+
+        if( length + 2 + count * 3 >= MIRROR_BYTES ) return MIRROR_BYTES;
+
+        out[length++] = ( uint8_t )skip;
+        out[length++] = ( uint8_t )count;
+        memcpy( &out[length], &current[pixel * 3], count * 3 );
+        length += count * 3;
+
+        pixel += count;
+        skip = 0;
+    }
+
+    return length;
+}
+
+/**
+ * @brief Completes the packet in tx[] and starts the DMA.
+ */
+static void Mirror_Send( uint8_t type, uint16_t length )
+{
+    uint16_t total = ICLED_MIRROR_HEADER + length + 1;
+    uint8_t sum = 0;
+
+    tx[0] = 'I';
+    tx[1] = 'M';
+    tx[2] = type;
+    tx[3] = seq++;
+    tx[4] = ( uint8_t )length;
+    tx[5] = ( uint8_t )( length >> 8 );
+
+    for( uint16_t i = 2; i < ICLED_MIRROR_HEADER + length; i++ )
+    {
+        sum += tx[i];
+    }
+    tx[ICLED_MIRROR_HEADER + length] = sum;
+
+    CLEAR_BIT( MIRROR_DMA->CCR, DMA_CCR_EN );
+    DMA1->IFCR = DMA_IFCR_CGIF7;
+    MIRROR_DMA->CMAR = ( uint32_t )( uintptr_t )tx;
+    MIRROR_DMA->CNDTR = total;
+    SET_BIT( MIRROR_DMA->CCR, DMA_CCR_EN );
+
+    // the next packet waits until this one fits into the share of the line
+    send_cycles = ICLED_TELEMETRY_CYCLES( );
+    hold_cycles = total * char_cycles * 100U / ICLED_MIRROR_SHARE;
+
+    mirror_stats.bytes += total;
+}
+#endif /* ICLED_MIRROR */
+
+/**
+ * @brief Sets up DMA1 channel 7 for USART2 TX.
+ */
+void ICLED_Mirror_Init( void )
+{
+#if ICLED_MIRROR
+    char_cycles = SystemCoreClock * 10U / huart2.Init.BaudRate;
+
+    __HAL_RCC_DMA1_CLK_ENABLE( );
+
+    CLEAR_BIT( MIRROR_DMA->CCR, DMA_CCR_EN );
+    MODIFY_REG( DMA1_CSELR->CSELR, DMA_CSELR_C7S, MIRROR_DMA_REQUEST << DMA_CSELR_C7S_Pos );
+
+    // memory to peripheral, bytes, memory increment, no interrupts
+    MIRROR_DMA->CCR = DMA_CCR_DIR | DMA_CCR_MINC;
+    MIRROR_DMA->CPAR = ( uint32_t )( uintptr_t )&USART2->TDR;
+
+    SET_BIT( USART2->CR3, USART_CR3_DMAT );
+#endif
+}
+
+/**
+ * @brief Sends the latest frame if the line is free.
+ */
+void ICLED_Mirror_Process( void )
+{
+#if ICLED_MIRROR
+    uint32_t count = ICLED_GetFrameCount( );
+    bool key = !started || ( ( HAL_GetTick( ) - key_tick ) >= ICLED_MIRROR_KEY_MS );
+
+    if( !key && ( ( uint32_t )( count - sent_count ) < ICLED_MIRROR_DIVIDER ) ) return;
+
+    // the frame waits, a newer one replaces it until the line is free
+    if( Mirror_IsBusy( ) || Mirror_IsLimited( ) ) return;
+
+    count = ICLED_ReadBack( current );
+    if( started && ( ( uint32_t )( count - sent_count ) > ICLED_MIRROR_DIVIDER ) )
+    {
+        mirror_stats.dropped += count - sent_count - ICLED_MIRROR_DIVIDER;
+    }
+    sent_count = count;
+    started = true;
+
+    uint16_t length = key ? MIRROR_BYTES : Mirror_EncodeDelta( &tx[ICLED_MIRROR_HEADER] );
+
+    if( length == 0 )
+    {
+        mirror_stats.unchanged++;
+        return;
+    }
+
+    if( length >= MIRROR_BYTES )
+    {
+        memcpy( &tx[ICLED_MIRROR_HEADER], current, MIRROR_BYTES );
+        Mirror_Send( 'K', MIRROR_BYTES );
+        key_tick = HAL_GetTick( );
+        mirror_stats.keyframes++;
+    }
+    else
+    {
+        Mirror_Send( 'D', length );
+        mirror_stats.deltas++;
+    }
+
+    memcpy( sent, current, MIRROR_BYTES );
+#endif
+}
+
+/**
+ * @brief Copies the counters.
+ */
+void ICLED_Mirror_GetStats( ICLED_MirrorStats *stats )
+{
+    if( stats == NULL ) return;
+
+    memcpy( stats, &mirror_stats, sizeof( mirror_stats ) );
+}
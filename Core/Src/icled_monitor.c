@@ -0,0 +1,180 @@
+/**
+ * @file icled_monitor.c
+ * @author MootSeeker
+ * @brief Frame deadline monitor and recovery of the LED output.
+ *
+ * The DMA error and start error counters of the telemetry block are written
+ * by icled.c, the monitor only compares them with the values it has seen. The
+ * IWDG HAL driver is not part of this project, so the watchdog is set up on
+ * register level.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_monitor.h"
+
+#include "icled_telemetry.h"
+#include "main.h"
+#include "tim.h"
+
+#define MONITOR_IWDG_KEY_START      0xCCCCU
+#define MONITOR_IWDG_KEY_ACCESS     0x5555U
+#define MONITOR_IWDG_KEY_RELOAD     0xAAAAU
+
+extern DMA_HandleTypeDef hdma_tim1_ch1;     // tim.c
+
+static uint32_t seen_dma_errors;    ///< dma_errors already handled
+static uint32_t seen_start_errors;  ///< start_errors already handled
+static uint32_t seen_completed;     ///< frames_completed at the last check
+static uint8_t failed_recoveries;   ///< Recoveries in a row without a completed frame since
+
+/**
+ * @brief Starts the IWDG with a 1 kHz counter clock (LSI 32 kHz / 32).
+ */
+static void Monitor_StartWatchdog( void )
+{
+#if ICLED_MONITOR_IWDG
+    SET_BIT( DBGMCU->APB1FZR1, DBGMCU_APB1FZR1_DBG_IWDG_STOP );
+
+    IWDG->KR = MONITOR_IWDG_KEY_START;
+    IWDG->KR = MONITOR_IWDG_KEY_ACCESS;
+    IWDG->PR = IWDG_PR_PR_1 | IWDG_PR_PR_0;     // divider 32
+    IWDG->RLR = ICLED_MONITOR_IWDG_MS;
+
+    while( IWDG->SR != 0U )
+    {
+        // prescaler and reload value take a few LSI cycles to update
+    }
+
+    IWDG->KR = MONITOR_IWDG_KEY_RELOAD;
+#endif
+}
+
+#if ICLED_OUTPUT_USART
+/**
+ * @brief A transfer is pending but the hardware that should run it is switched off.
+ */
+static bool Monitor_IsStuck( void )
+{
+    // the DMA channel stays enabled through the latch after the transfer complete
+    return !READ_BIT( USART1->CR1, USART_CR1_UE ) || !READ_BIT( USART1->CR1, USART_CR1_TE ) ||
+           !READ_BIT( USART1->CR3, USART_CR3_DMAT ) || !READ_BIT( DMA1_Channel4->CCR, DMA_CCR_EN );
+}
+
+/**
+ * @brief Resets USART1, sets up the LED output on it again and resends the frame.
+ */
+static void Monitor_Recover( void )
+{
+    CLEAR_BIT( DMA1_Channel4->CCR, DMA_CCR_EN );
+
+    __HAL_RCC_USART1_FORCE_RESET( );
+    __HAL_RCC_USART1_RELEASE_RESET( );
+
+    ICLED_USART_Setup( );
+
+    icled_telemetry.recoveries++;
+
+    ICLED_Show( );
+}
+#else
+/**
+ * @brief A transfer is pending but the hardware that should run it is switched off.
+ */
+static bool Monitor_IsStuck( void )
+{
+    return !READ_BIT( TIM1->CR1, TIM_CR1_CEN ) || !READ_BIT( TIM1->BDTR, TIM_BDTR_MOE ) ||
+           !READ_BIT( TIM1->CCER, TIM_CCER_CC1E ) || !READ_BIT( TIM1->DIER, TIM_DIER_CC1DE ) ||
+           !READ_BIT( hdma_tim1_ch1.Instance->CCR, DMA_CCR_EN );
+}
+
+/**
+ * @brief Resets TIM1, initialises TIM1 CH1 and its DMA channel again and resends the frame.
+ */
+static void Monitor_Recover( void )
+{
+    HAL_TIM_PWM_Stop_DMA( &htim1, TIM_CHANNEL_1 );
+    HAL_TIM_PWM_DeInit( &htim1 );
+    HAL_TIM_Base_DeInit( &htim1 );     // MspDeInit: TIM1 clock off, hdma_tim1_ch1 deinitialised
+
+    // clears a break, a latched output disable and everything else the registers may hold
+    __HAL_RCC_TIM1_FORCE_RESET( );
+    __HAL_RCC_TIM1_RELEASE_RESET( );
+
+    MX_TIM1_Init( );    // MspInit links and initialises hdma_tim1_ch1 again
+
+    icled_telemetry.recoveries++;
+
+    ICLED_Show( );
+}
+#endif /* ICLED_OUTPUT_USART */
+
+/**
+ * @brief Takes the current incident counters as reference and starts the watchdog.
+ */
+void ICLED_Monitor_Init( void )
+{
+    seen_dma_errors = icled_telemetry.dma_errors;
+    seen_start_errors = icled_telemetry.start_errors;
+    seen_completed = icled_telemetry.frames_completed;
+    failed_recoveries = 0;
+
+    Monitor_StartWatchdog( );
+}
+
+/**
+ * @brief Checks the frame on the wire and recovers the output after an incident.
+ */
+void ICLED_Monitor_Process( void )
+{
+    uint32_t start;
+    bool busy = ICLED_IsBusy( &start );
+    bool incident = false;
+
+    // read the counters after the busy flag, an error sets both in the same interrupt
+    uint32_t dma_errors = icled_telemetry.dma_errors;
+    uint32_t start_errors = icled_telemetry.start_errors;
+    uint32_t completed = icled_telemetry.frames_completed;
+
+    if( completed != seen_completed )
+    {
+        seen_completed = completed;
+        failed_recoveries = 0;
+    }
+
+    if( ( dma_errors != seen_dma_errors ) || ( start_errors != seen_start_errors ) )
+    {
+        // counted by icled.c already
+        seen_dma_errors = dma_errors;
+        seen_start_errors = start_errors;
+        incident = true;
+    }
+    else if( busy && ( ( HAL_GetTick( ) - start ) > ICLED_MONITOR_DEADLINE_MS ) )
+    {
+        icled_telemetry.deadline_misses++;
+        incident = true;
+    }
+    else if( busy && Monitor_IsStuck( ) )
+    {
+        icled_telemetry.stuck_states++;
+        incident = true;
+    }
+
+    if( incident )
+    {
+        icled_telemetry.last_incident_ms = HAL_GetTick( );
+
+        if( failed_recoveries < UINT8_MAX ) failed_recoveries++;
+        Monitor_Recover( );
+    }
+
+#if ICLED_MONITOR_IWDG
+    // a recovery that does not bring frames back lets the watchdog reset the MCU
+    if( failed_recoveries < ICLED_MONITOR_RETRIES )
+    {
+        IWDG->KR = MONITOR_IWDG_KEY_RELOAD;
+    }
+#endif
+}
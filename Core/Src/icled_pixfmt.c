@@ -0,0 +1,226 @@
+/**
+ * @file icled_pixfmt.c
+ * @author MootSeeker
+ * @brief Conversion of incoming pixel formats into the GRB pixel buffer.
+ *
+ * Four pixels of 3 bytes are exactly three words, so the 3-byte kernels
+ * load three words, rearrange the bytes with shifts and masks (one ORR with
+ * a shifted operand each on the Cortex-M4) and store three words. RGBW and
+ * RGB565 are first brought into the same three RGB words. The words are
+ * loaded and stored with memcpy(), a single unaligned LDR/STR on the M4.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_pixfmt.h"
+
+#include "main.h"
+
+#include <string.h>
+
+#if defined( __ARM_FEATURE_DSP ) && ( __ARM_FEATURE_DSP == 1 )
+#define PIXFMT_SWAP_LOW( x )        __REV16( x )
+#define PIXFMT_PACK( lo, hi )       __PKHBT( ( lo ), ( hi ), 0 )
+#define PIXFMT_ADD_SAT( a, b )      __UQADD8( ( a ), ( b ) )
+#else
+#define PIXFMT_SWAP_LOW( x )        ( ( ( ( x ) >> 8 ) & 0x00FF00FFU ) | ( ( ( x ) << 8 ) & 0xFF00FF00U ) )
+#define PIXFMT_PACK( lo, hi )       ( ( ( lo ) & 0x0000FFFFU ) | ( ( hi ) & 0xFFFF0000U ) )
+#define PIXFMT_ADD_SAT( a, b )      PixFmt_AddSat( ( a ), ( b ) )
+
+/**
+ * @brief Adds the bytes of two words, each sum saturates at 255.
+ */
+static inline uint32_t PixFmt_AddSat( uint32_t a, uint32_t b )
+{
+    uint32_t low = ( a & 0x7F7F7F7FU ) + ( b & 0x7F7F7F7FU );
+    uint32_t sum = low ^ ( ( a ^ b ) & 0x80808080U );
+    uint32_t carry = ( ( a & b ) | ( ( a | b ) & low ) ) & 0x80808080U;
+
+    return sum | ( ( carry >> 7 ) * 0xFFU );
+}
+#endif
+
+/**
+ * @brief Loads a word from any alignment.
+ */
+static inline uint32_t PixFmt_Load( const uint8_t *src )
+{
+    uint32_t word;
+    memcpy( &word, src, 4 );
+    return word;
+}
+
+/**
+ * @brief Stores three words to any alignment.
+ */
+static inline void PixFmt_Store( uint8_t *dst, uint32_t o0, uint32_t o1, uint32_t o2 )
+{
+    memcpy( &dst[0], &o0, 4 );
+    memcpy( &dst[4], &o1, 4 );
+    memcpy( &dst[8], &o2, 4 );
+}
+
+/**
+ * @brief Converts four RGB pixels in three words to GRB.
+ *
+ * R0 G0 B0 R1 | G1 B1 R2 G2 | B2 R3 G3 B3  ->  G0 R0 B0 G1 | R1 B1 G2 R2 | B2 G3 R3 B3
+ */
+static inline void PixFmt_StoreRGB( uint8_t *dst, uint32_t w0, uint32_t w1, uint32_t w2 )
+{
+    uint32_t o0 = PIXFMT_PACK( PIXFMT_SWAP_LOW( w0 ), ( w0 & 0x00FF0000U ) | ( w1 << 24 ) );
+    uint32_t o1 = ( w0 >> 24 ) | ( w1 & 0x0000FF00U ) | ( ( w1 >> 8 ) & 0x00FF0000U ) | ( ( w1 << 8 ) & 0xFF000000U );
+    uint32_t o2 = ( w2 & 0xFF0000FFU ) | ( ( w2 >> 8 ) & 0x0000FF00U ) | ( ( w2 << 8 ) & 0x00FF0000U );
+
+    PixFmt_Store( dst, o0, o1, o2 );
+}
+
+static void PixFmt_RGB( uint8_t *grb, const uint8_t *src, uint16_t pixels )
+{
+    for( ; pixels >= 4; pixels -= 4, src += 12, grb += 12 )
+    {
+        PixFmt_StoreRGB( grb, PixFmt_Load( &src[0] ), PixFmt_Load( &src[4] ), PixFmt_Load( &src[8] ) );
+    }
+
+    for( ; pixels > 0; pixels--, src += 3, grb += 3 )
+    {
+        grb[0] = src[1];
+        grb[1] = src[0];
+        grb[2] = src[2];
+    }
+}
+
+/**
+ * @brief B0 G0 R0 B1 | G1 R1 B2 G2 | R2 B3 G3 R3  ->  G0 R0 B0 G1 | R1 B1 G2 R2 | B2 G3 R3 B3
+ */
+static void PixFmt_BGR( uint8_t *grb, const uint8_t *src, uint16_t pixels )
+{
+    for( ; pixels >= 4; pixels -= 4, src += 12, grb += 12 )
+    {
+        uint32_t w0 = PixFmt_Load( &src[0] );
+        uint32_t w1 = PixFmt_Load( &src[4] );
+        uint32_t w2 = PixFmt_Load( &src[8] );
+
+        uint32_t o0 = ( ( w0 >> 8 ) & 0x0000FFFFU ) | ( ( w0 & 0xFFU ) << 16 ) | ( w1 << 24 );
+        uint32_t o1 = ( ( w1 >> 8 ) & 0x00FF00FFU ) | ( ( w0 >> 16 ) & 0x0000FF00U ) | ( w2 << 24 );
+        uint32_t o2 = ( ( w1 >> 16 ) & 0xFFU ) | ( ( w2 >> 8 ) & 0x00FFFF00U ) | ( ( w2 << 16 ) & 0xFF000000U );
+
+        PixFmt_Store( grb, o0, o1, o2 );
+    }
+
+    for( ; pixels > 0; pixels--, src += 3, grb += 3 )
+    {
+        grb[0] = src[1];
+        grb[1] = src[2];
+        grb[2] = src[0];
+    }
+}
+
+/**
+ * @brief One RGBW pixel as RGB in the lower three bytes, W added to each colour.
+ */
+static inline uint32_t PixFmt_WhiteToRGB( uint32_t rgbw )
+{
+    return PIXFMT_ADD_SAT( rgbw & 0x00FFFFFFU, ( rgbw >> 24 ) * 0x00010101U );
+}
+
+static void PixFmt_RGBW( uint8_t *grb, const uint8_t *src, uint16_t pixels )
+{
+    for( ; pixels >= 4; pixels -= 4, src += 16, grb += 12 )
+    {
+        uint32_t p0 = PixFmt_WhiteToRGB( PixFmt_Load( &src[0] ) );
+        uint32_t p1 = PixFmt_WhiteToRGB( PixFmt_Load( &src[4] ) );
+        uint32_t p2 = PixFmt_WhiteToRGB( PixFmt_Load( &src[8] ) );
+        uint32_t p3 = PixFmt_WhiteToRGB( PixFmt_Load( &src[12] ) );
+
+        // four 3-byte pixels packed into three words, then the RGB kernel
+        PixFmt_StoreRGB( grb, p0 | ( p1 << 24 ), ( p1 >> 8 ) | ( p2 << 16 ), ( p2 >> 16 ) | ( p3 << 8 ) );
+    }
+
+    for( ; pixels > 0; pixels--, src += 4, grb += 3 )
+    {
+        uint32_t p = PixFmt_WhiteToRGB( PixFmt_Load( src ) );
+
+        grb[0] = ( uint8_t )( p >> 8 );
+        grb[1] = ( uint8_t )p;
+        grb[2] = ( uint8_t )( p >> 16 );
+    }
+}
+
+/**
+ * @brief Widens the two pixels of a word into G and R bytes ([G0 R0 G1 R1]) and B halfwords ([B0 0 B1 0]).
+ *
+ * Each pixel stays in its halfword, a 5 or 6 bit field is widened by repeating
+ * its top bits, so 0 stays 0 and the maximum becomes 255.
+ */
+static inline uint32_t PixFmt_Widen565( uint32_t w, uint32_t *blue )
+{
+    uint32_t r = ( w >> 11 ) & 0x001F001FU;
+    uint32_t g = ( w >> 5 ) & 0x003F003FU;
+    uint32_t b = w & 0x001F001FU;
+
+    // the right shifts would move the low bits of the upper pixel into the lower one
+    *blue = ( b << 3 ) | ( ( b >> 2 ) & 0x00070007U );
+
+    return ( ( g << 2 ) | ( ( g >> 4 ) & 0x00030003U ) ) | ( ( ( r << 3 ) | ( ( r >> 2 ) & 0x00070007U ) ) << 8 );
+}
+
+static void PixFmt_RGB565( uint8_t *grb, const uint8_t *src, uint16_t pixels )
+{
+    for( ; pixels >= 4; pixels -= 4, src += 8, grb += 12 )
+    {
+        uint32_t ba;
+        uint32_t bb;
+        uint32_t ga = PixFmt_Widen565( PixFmt_Load( &src[0] ), &ba );
+        uint32_t gb = PixFmt_Widen565( PixFmt_Load( &src[4] ), &bb );
+
+        uint32_t o0 = ( ga & 0x0000FFFFU ) | ( ( ba << 16 ) & 0x00FF0000U ) | ( ( ga << 8 ) & 0xFF000000U );
+        uint32_t o1 = PIXFMT_PACK( ( ga >> 24 ) | ( ( ba >> 8 ) & 0x0000FF00U ), gb << 16 );
+        uint32_t o2 = ( bb & 0xFFU ) | ( ( gb >> 8 ) & 0x00FFFF00U ) | ( ( bb << 8 ) & 0xFF000000U );
+
+        PixFmt_Store( grb, o0, o1, o2 );
+    }
+
+    for( ; pixels > 0; pixels--, src += 2, grb += 3 )
+    {
+        uint32_t b;
+        uint32_t gr = PixFmt_Widen565( ( uint32_t )src[0] | ( ( uint32_t )src[1] << 8 ), &b );
+
+        grb[0] = ( uint8_t )gr;
+        grb[1] = ( uint8_t )( gr >> 8 );
+        grb[2] = ( uint8_t )b;
+    }
+}
+
+/**
+ * @brief Converts pixels into GRB.
+ */
+void ICLED_PixFmt_Convert( ICLED_PixFmt format, uint8_t *grb, const uint8_t *src, uint16_t pixels )
+{
+    if( ( grb == NULL ) || ( src == NULL ) ) return;
+
+    switch( format )
+    {
+        case ICLED_PIXFMT_RGB:
+            PixFmt_RGB( grb, src, pixels );
+            break;
+
+        case ICLED_PIXFMT_BGR:
+            PixFmt_BGR( grb, src, pixels );
+            break;
+
+        case ICLED_PIXFMT_RGBW:
+            PixFmt_RGBW( grb, src, pixels );
+            break;
+
+        case ICLED_PIXFMT_RGB565:
+            PixFmt_RGB565( grb, src, pixels );
+            break;
+
+        case ICLED_PIXFMT_GRB:
+        default:
+            memcpy( grb, src, ( size_t )pixels * 3U );
+            break;
+    }
+}
@@ -0,0 +1,387 @@
+/**
+ * @file icled_quad.c
+ * @author MootSeeker
+ * @brief Four-lane LED output on the QUADSPI peripheral.
+ *
+ * The QSPI HAL driver is not part of this project, so QUADSPI and its DMA
+ * channel are configured on register level. The transfer is an indirect
+ * write without instruction, address or dummy phase, only data on four
+ * lines. The lines idle low through their pull-downs, the latch is idle time
+ * after the transfer complete interrupt.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_quad.h"
+
+#include "main.h"
+#include "icled_telemetry.h"
+
+#include <string.h>
+
+#define QUAD_DMA            DMA1_Channel5
+#define QUAD_DMA_REQUEST    5U      ///< QUADSPI on DMA1 channel 5 (CSELR C5S)
+
+/**
+ * @brief Line time of @p slots QUADSPI clocks in ns at an HCLK.
+ */
+#define QUAD_NS( clock, slots )     ( ( slots ) * ( ICLED_QUAD_PRESCALER + 1ULL ) * 1000000000ULL / ( clock ) )
+
+#if ICLED_QUAD
+#if ( ICLED_QUAD_PRESCALER < 0 ) || ( ICLED_QUAD_PRESCALER > 255 )
+#error "ICLED_QUAD_PRESCALER is the 8-bit QUADSPI prescaler (0 ... 255)"
+#endif
+
+#if ( QUAD_NS( ICLED_QUAD_KERNEL_HZ, 1 ) < ICLED_T0H_MIN_NS ) || ( QUAD_NS( ICLED_QUAD_KERNEL_HZ, 1 ) > ICLED_T0H_MAX_NS )
+#error "T0H of the QUADSPI output is out of the ICLED timing window"
+#endif
+
+#if ( QUAD_NS( ICLED_QUAD_KERNEL_HZ, 2 ) < ICLED_T1H_MIN_NS ) || ( QUAD_NS( ICLED_QUAD_KERNEL_HZ, 2 ) > ICLED_T1H_MAX_NS )
+#error "T1H of the QUADSPI output is out of the ICLED timing window"
+#endif
+
+#if ( QUAD_NS( ICLED_QUAD_KERNEL_HZ, 3 ) < ICLED_BIT_PERIOD_MIN_NS ) || ( QUAD_NS( ICLED_QUAD_KERNEL_HZ, 3 ) > ICLED_BIT_PERIOD_MAX_NS )
+#error "Bit period of the QUADSPI output is out of the ICLED timing window"
+#endif
+
+#if ( ICLED_QUAD_LATCH_US * 1000ULL ) < ICLED_LATCH_MIN_NS
+#error "ICLED_QUAD_LATCH_US is too short for the latch"
+#endif
+#endif /* ICLED_QUAD */
+
+static volatile ICLED_QuadStats quad_stats;
+
+#if ICLED_QUAD
+/**
+ * @brief GRB pixel data of the four chains, [chain][LED][0] = G, [1] = R, [2] = B.
+ */
+static uint8_t quad_data[ICLED_QUAD_CHAINS][ICLED_QUAD_LEDS][3];
+
+/**
+ * @brief QUADSPI data of a frame, words for the 32-bit DMA.
+ */
+static uint32_t quad_buffer[ICLED_QUAD_BUFFER_SIZE / 4];
+
+static volatile bool transfer_busy;     ///< Frame on the wire or in its latch time
+static volatile bool latching;          ///< Set by the transfer complete, the latch time runs
+static volatile uint32_t latch_cycles;  ///< Cycle counter at the transfer complete
+static uint32_t latch_length;           ///< Latch time in cycles
+
+#if ICLED_QUAD_MIRROR
+static uint32_t mirrored_frame;         ///< Matrix frame count the chains show
+#endif
+
+/**
+ * @brief The QUADSPI timing at an HCLK hits the ICLED windows.
+ */
+static bool Quad_TimingFits( uint32_t clock )
+{
+    uint64_t t0h = QUAD_NS( clock, 1 );
+    uint64_t t1h = QUAD_NS( clock, 2 );
+    uint64_t period = QUAD_NS( clock, 3 );
+
+    return ( t0h >= ICLED_T0H_MIN_NS ) && ( t0h <= ICLED_T0H_MAX_NS ) &&
+           ( t1h >= ICLED_T1H_MIN_NS ) && ( t1h <= ICLED_T1H_MAX_NS ) &&
+           ( period >= ICLED_BIT_PERIOD_MIN_NS ) && ( period <= ICLED_BIT_PERIOD_MAX_NS );
+}
+
+/**
+ * @brief Moves bit k of a byte to bit 4 * k, so each bit gets a nibble of its own.
+ */
+static inline uint32_t Quad_Spread( uint32_t x )
+{
+    x = ( x | ( x << 12 ) ) & 0x000F000FU;
+    x = ( x | ( x << 6 ) ) & 0x03030303U;
+    x = ( x | ( x << 3 ) ) & 0x11111111U;
+
+    return x;
+}
+
+/**
+ * @brief Transposes the four chains into QUADSPI data.
+ *
+ * Per colour byte the four chains give eight data nibbles (bit 7 first),
+ * each LED bit is the nibbles F d 0. Two LED bits fit into three bytes:
+ *
+ *     F d7 | 0 F | d6 0 | F d5 | 0 F | d4 0 | ...
+ *
+ * The 0 F bytes are the same for every frame and written once in ICLED_Quad_Init().
+ */
+static void Quad_Encode( void )
+{
+    const uint8_t *c0 = quad_data[0][0];
+    const uint8_t *c1 = quad_data[1][0];
+    const uint8_t *c2 = quad_data[2][0];
+    const uint8_t *c3 = quad_data[3][0];
+    uint8_t *out = ( uint8_t * )quad_buffer;
+
+    for( uint16_t i = 0; i < ICLED_QUAD_LEDS * 3; i++, out += 12 )
+    {
+        // nibble k holds bit k of chain 0 ... 3 in its bits 0 ... 3 (IO0 ... IO3)
+        uint32_t d = Quad_Spread( c0[i] ) | ( Quad_Spread( c1[i] ) << 1 ) |
+                     ( Quad_Spread( c2[i] ) << 2 ) | ( Quad_Spread( c3[i] ) << 3 );
+
+        out[0]  = ( uint8_t )( 0xF0U | ( d >> 28 ) );
+        out[2]  = ( uint8_t )( ( d >> 20 ) & 0xF0U );
+        out[3]  = ( uint8_t )( 0xF0U | ( ( d >> 20 ) & 0x0FU ) );
+        out[5]  = ( uint8_t )( ( d >> 12 ) & 0xF0U );
+        out[6]  = ( uint8_t )( 0xF0U | ( ( d >> 12 ) & 0x0FU ) );
+        out[8]  = ( uint8_t )( ( d >> 4 ) & 0xF0U );
+        out[9]  = ( uint8_t )( 0xF0U | ( ( d >> 4 ) & 0x0FU ) );
+        out[11] = ( uint8_t )( ( d << 4 ) & 0xF0U );
+    }
+}
+
+/**
+ * @brief Stops a running transfer.
+ */
+static void Quad_Abort( void )
+{
+    SET_BIT( QUADSPI->CR, QUADSPI_CR_ABORT );
+    while( READ_BIT( QUADSPI->CR, QUADSPI_CR_ABORT ) )
+    {
+        // cleared by the hardware once the FIFO is flushed
+    }
+
+    CLEAR_BIT( QUAD_DMA->CCR, DMA_CCR_EN );
+}
+
+/**
+ * @brief Starts the indirect write of the QUADSPI buffer.
+ */
+static void Quad_Start( void )
+{
+    transfer_busy = true;
+    latching = false;
+
+    QUADSPI->FCR = QUADSPI_FCR_CTCF | QUADSPI_FCR_CTEF;
+
+    CLEAR_BIT( QUAD_DMA->CCR, DMA_CCR_EN );
+    DMA1->IFCR = DMA_IFCR_CGIF5;
+    QUAD_DMA->CMAR = ( uint32_t )( uintptr_t )quad_buffer;
+    QUAD_DMA->CNDTR = ICLED_QUAD_BUFFER_SIZE / 4;
+    SET_BIT( QUAD_DMA->CCR, DMA_CCR_EN );
+
+    // indirect write, data on four lines only; the DMA keeps the FIFO filled
+    QUADSPI->DLR = ICLED_QUAD_BUFFER_SIZE - 1U;
+    QUADSPI->CCR = QUADSPI_CCR_DMODE_1 | QUADSPI_CCR_DMODE_0;
+}
+#endif /* ICLED_QUAD */
+
+/**
+ * @brief Configures QUADSPI, its pins and DMA1 channel 5.
+ */
+void ICLED_Quad_Init( void )
+{
+#if ICLED_QUAD
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    if( !Quad_TimingFits( HAL_RCC_GetHCLKFreq( ) ) )
+    {
+        Error_Handler( );
+    }
+
+    __HAL_RCC_QSPI_CLK_ENABLE( );
+    __HAL_RCC_DMA1_CLK_ENABLE( );
+    __HAL_RCC_GPIOA_CLK_ENABLE( );
+    __HAL_RCC_GPIOB_CLK_ENABLE( );
+
+    /* PB1 = IO0, PB0 = IO1, PA7 = IO2, PA6 = IO3, pulled low between the transfers */
+    GPIO_InitStruct.Pin = GPIO_PIN_0 | GPIO_PIN_1;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF10_QUADSPI;
+    HAL_GPIO_Init( GPIOB, &GPIO_InitStruct );
+
+    GPIO_InitStruct.Pin = GPIO_PIN_6 | GPIO_PIN_7;
+    HAL_GPIO_Init( GPIOA, &GPIO_InitStruct );
+
+    __HAL_RCC_QSPI_FORCE_RESET( );
+    __HAL_RCC_QSPI_RELEASE_RESET( );
+
+    /* the largest flash size, no address is sent anyway; clock idles low (mode 0) */
+    QUADSPI->DCR = 31U << QUADSPI_DCR_FSIZE_Pos;
+
+    /* DMA request with 4 free FIFO bytes (one word), transfer complete and error interrupts */
+    QUADSPI->CR = ( ( uint32_t )ICLED_QUAD_PRESCALER << QUADSPI_CR_PRESCALER_Pos ) | ( 3U << QUADSPI_CR_FTHRES_Pos ) |
+                  QUADSPI_CR_DMAEN | QUADSPI_CR_TCIE | QUADSPI_CR_TEIE;
+    SET_BIT( QUADSPI->CR, QUADSPI_CR_EN );
+
+    /* the channel of the DMX512 receiver (USART1 RX), which is off in this build */
+    CLEAR_BIT( QUAD_DMA->CCR, DMA_CCR_EN );
+    MODIFY_REG( DMA1_CSELR->CSELR, DMA_CSELR_C5S, QUAD_DMA_REQUEST << DMA_CSELR_C5S_Pos );
+
+    // memory to peripheral, words, memory increment, high priority, no interrupts
+    QUAD_DMA->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PL_1;
+    QUAD_DMA->CPAR = ( uint32_t )( uintptr_t )&QUADSPI->DR;
+
+    latch_length = SystemCoreClock / 1000000U * ICLED_QUAD_LATCH_US;
+
+    // the middle byte of every three is 0 F (end of one LED bit, start of the next)
+    uint8_t *out = ( uint8_t * )quad_buffer;
+    for( uint32_t i = 1; i < ICLED_QUAD_BUFFER_SIZE; i += 3 )
+    {
+        out[i] = 0x0FU;
+    }
+
+    HAL_NVIC_SetPriority( QUADSPI_IRQn, 1, 0 );
+    HAL_NVIC_EnableIRQ( QUADSPI_IRQn );
+
+    memset( quad_data, 0, sizeof( quad_data ) );
+    ICLED_Quad_Show( );
+#endif
+}
+
+/**
+ * @brief Sets the color of an LED of a chain (GRB order in the buffer).
+ */
+void ICLED_Quad_SetPixel( uint8_t chain, uint16_t index, uint8_t r, uint8_t g, uint8_t b )
+{
+#if ICLED_QUAD
+    if( ( chain >= ICLED_QUAD_CHAINS ) || ( index >= ICLED_QUAD_LEDS ) ) return;
+
+    quad_data[chain][index][0] = g;
+    quad_data[chain][index][1] = r;
+    quad_data[chain][index][2] = b;
+#else
+    ( void )chain;
+    ( void )index;
+    ( void )r;
+    ( void )g;
+    ( void )b;
+#endif
+}
+
+/**
+ * @brief Returns the pixel buffer of a chain.
+ */
+uint8_t *ICLED_Quad_GetBuffer( uint8_t chain )
+{
+#if ICLED_QUAD
+    if( chain >= ICLED_QUAD_CHAINS ) return NULL;
+
+    return quad_data[chain][0];
+#else
+    ( void )chain;
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Transposes the four chains and sends them.
+ */
+void ICLED_Quad_Show( void )
+{
+#if ICLED_QUAD
+    // the data is out, the rest of the latch is short: wait so the LEDs take the frames apart
+    while( latching && ICLED_Quad_IsBusy( ) )
+    {
+    }
+
+    if( transfer_busy )
+    {
+        // the restart cuts the running frame short
+        Quad_Abort( );
+        quad_stats.dropped++;
+    }
+
+    uint32_t start = ICLED_TELEMETRY_CYCLES( );
+    Quad_Encode( );
+    quad_stats.encode_cycles = ICLED_TELEMETRY_CYCLES( ) - start;
+
+    Quad_Start( );
+    quad_stats.frames++;
+#endif
+}
+
+/**
+ * @brief Repeats a new matrix frame on the four chains.
+ */
+void ICLED_Quad_Process( void )
+{
+#if ICLED_QUAD && ICLED_QUAD_MIRROR
+    uint32_t frame = ICLED_GetFrameCount( );
+
+    if( ( frame == mirrored_frame ) || ICLED_Quad_IsBusy( ) ) return;
+
+    const uint16_t leds = ( ICLED_QUAD_LEDS < ICLED_LED_COUNT ) ? ICLED_QUAD_LEDS : ICLED_LED_COUNT;
+    uint8_t *chain = quad_data[0][0];
+
+    // GetColumn() follows the scroll ring, GetBuffer() would rotate it back every frame
+    for( uint16_t led = 0; led < leds; led += ICLED_ROWS )
+    {
+        uint16_t count = ( leds - led < ICLED_ROWS ) ? leds - led : ICLED_ROWS;
+        memcpy( &chain[led * 3], ICLED_GetColumn( led / ICLED_ROWS ), ( size_t )count * 3 );
+    }
+
+    for( uint8_t c = 1; c < ICLED_QUAD_CHAINS; c++ )
+    {
+        memcpy( quad_data[c][0], chain, ( size_t )leds * 3 );
+    }
+
+    mirrored_frame = frame;
+    ICLED_Quad_Show( );
+#endif
+}
+
+/**
+ * @brief Checks whether a frame is on the wire or in its latch time.
+ */
+bool ICLED_Quad_IsBusy( void )
+{
+#if ICLED_QUAD
+    // a wrap of the cycle counter cannot bring an expired latch back, it is cleared here
+    if( latching && ( ( ICLED_TELEMETRY_CYCLES( ) - latch_cycles ) >= latch_length ) )
+    {
+        latching = false;
+        transfer_busy = false;
+    }
+
+    return transfer_busy;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Copies the counters.
+ */
+void ICLED_Quad_GetStats( ICLED_QuadStats *stats )
+{
+    if( stats == NULL ) return;
+
+    // the interrupt counts completions and errors, the copy must not tear
+    __disable_irq( );
+    memcpy( stats, ( const void * )&quad_stats, sizeof( quad_stats ) );
+    __enable_irq( );
+}
+
+/**
+ * @brief QUADSPI interrupt: the last nibble is out, or a transfer error.
+ */
+void ICLED_Quad_IRQHandler( void )
+{
+#if ICLED_QUAD
+    uint32_t sr = QUADSPI->SR;
+
+    if( sr & QUADSPI_SR_TEF )
+    {
+        QUADSPI->FCR = QUADSPI_FCR_CTEF;
+        CLEAR_BIT( QUAD_DMA->CCR, DMA_CCR_EN );
+        transfer_busy = false;
+        quad_stats.errors++;
+        return;
+    }
+
+    if( sr & QUADSPI_SR_TCF )
+    {
+        QUADSPI->FCR = QUADSPI_FCR_CTCF;
+        latch_cycles = ICLED_TELEMETRY_CYCLES( );
+        latching = true;
+        quad_stats.completed++;
+    }
+#endif
+}
@@ -0,0 +1,251 @@
+/**
+ * @file icled_ripple.c
+ * @author MootSeeker
+ * @brief Water ripples from an integer 2D wave equation.
+ *
+ * A row of the next step only reads the rows above and below of the current
+ * field and the same row of the previous one, which it replaces cell by cell.
+ * On the Cortex-M4 two cells are one word: the neighbour sums are SADD16, the
+ * halving SHADD16 and the damping shift a chain of SHADD16 with 0, so the
+ * packed path gives exactly the result of the plain C loop, which the host
+ * compilers vectorise on their own.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_ripple.h"
+
+#include "main.h"
+
+#include <string.h>
+
+#define RIPPLE_MIN          ( -ICLED_RIPPLE_HEIGHT_MAX - 1 )
+#define RIPPLE_SHIFT        4           ///< Heights per palette step, the outer quarter of the range is clipped
+#define RIPPLE_SEED         0x9E3779B9U
+
+#if defined( __ARM_FEATURE_DSP ) && ( __ARM_FEATURE_DSP == 1 )
+#define RIPPLE_PACKED       1
+#endif
+
+/**
+ * @brief Colours of the water palette at full brightness, R G B at heights -256 ... 255 (>> RIPPLE_SHIFT).
+ */
+typedef struct
+{
+    int16_t level;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} RippleStop;
+
+static const RippleStop stops[] =
+{
+    { -256,   0,   0,  24 },    // deep trough
+    {  -64,   0,   8,  64 },
+    {    0,   0,  24, 110 },    // calm water
+    {   64,   0, 120, 200 },
+    {  160,  60, 220, 255 },
+    {  255, 255, 255, 255 },    // crest
+};
+
+static uint8_t palette[512][3];         ///< GRB per height >> RIPPLE_SHIFT, offset by 256
+static int16_t palette_brightness = -1; ///< Brightness the palette was built for, -1 = not built
+
+/**
+ * @brief Clamps a height to 14 bits.
+ */
+static inline int16_t Ripple_Clamp( int32_t height )
+{
+    if( height > ICLED_RIPPLE_HEIGHT_MAX ) return ICLED_RIPPLE_HEIGHT_MAX;
+    if( height < RIPPLE_MIN ) return RIPPLE_MIN;
+
+    return ( int16_t )height;
+}
+
+#if RIPPLE_PACKED
+/**
+ * @brief Loads two heights from any alignment.
+ */
+static inline uint32_t Ripple_Load( const int16_t *cells )
+{
+    uint32_t word;
+    memcpy( &word, cells, 4 );
+    return word;
+}
+#endif
+
+/**
+ * @brief Computes one row of the next step over the same row of the previous one.
+ *
+ * @param next  First cell of the row in the previous field, overwritten.
+ * @param up    First cell of the row above in the current field.
+ * @param mid   First cell of the same row in the current field, mid[-1] and mid[width] are border.
+ * @param down  First cell of the row below in the current field.
+ * @param width Cells of the row.
+ */
+static void Ripple_Row( int16_t *next, const int16_t *up, const int16_t *mid, const int16_t *down, uint16_t width )
+{
+    uint16_t x = 0;
+
+#if RIPPLE_PACKED
+    for( ; ( uint16_t )( x + 2 ) <= width; x += 2 )
+    {
+        uint32_t sum = __SHADD16( __SADD16( Ripple_Load( &mid[x - 1] ), Ripple_Load( &mid[x + 1] ) ),
+                                  __SADD16( Ripple_Load( &up[x] ), Ripple_Load( &down[x] ) ) );
+        uint32_t wave = __SSUB16( sum, Ripple_Load( &next[x] ) );
+        uint32_t loss = wave;
+
+        // per-halfword arithmetic shift: each SHADD16 with 0 halves both lanes
+        for( uint8_t k = 0; k < ICLED_RIPPLE_DAMPING; k++ )
+        {
+            loss = __SHADD16( loss, 0U );
+        }
+
+        uint32_t result = __SSAT16( __SSUB16( wave, loss ), 14 );
+        memcpy( &next[x], &result, 4 );
+    }
+#endif
+
+    for( ; x < width; x++ )
+    {
+        int32_t wave = ( ( mid[x - 1] + mid[x + 1] + up[x] + down[x] ) >> 1 ) - next[x];
+
+        next[x] = Ripple_Clamp( wave - ( wave >> ICLED_RIPPLE_DAMPING ) );
+    }
+}
+
+/**
+ * @brief Builds the palette for a brightness, linear between the stops.
+ */
+static void Ripple_BuildPalette( uint8_t brightness )
+{
+    uint8_t stop = 0;
+
+    for( int16_t level = -256; level < 256; level++ )
+    {
+        while( level > stops[stop + 1].level ) stop++;
+
+        const RippleStop *a = &stops[stop];
+        const RippleStop *b = &stops[stop + 1];
+        int32_t span = b->level - a->level;
+        int32_t t = level - a->level;
+        uint8_t *grb = palette[level + 256];
+
+        grb[0] = ( uint8_t )( ( ( a->g + ( ( b->g - a->g ) * t ) / span ) * brightness ) / 255 );
+        grb[1] = ( uint8_t )( ( ( a->r + ( ( b->r - a->r ) * t ) / span ) * brightness ) / 255 );
+        grb[2] = ( uint8_t )( ( ( a->b + ( ( b->b - a->b ) * t ) / span ) * brightness ) / 255 );
+    }
+
+    palette_brightness = brightness;
+}
+
+/**
+ * @brief Sets up a calm surface.
+ */
+void ICLED_Ripple_Init( ICLED_Ripple *ripple, int16_t *fields, uint16_t width, uint16_t rows )
+{
+    if( ( ripple == NULL ) || ( fields == NULL ) ) return;
+
+    memset( fields, 0, 2 * ICLED_RIPPLE_CELLS( width, rows ) * sizeof( int16_t ) );
+
+    ripple->current = fields;
+    ripple->previous = &fields[ICLED_RIPPLE_CELLS( width, rows )];
+    ripple->width = width;
+    ripple->rows = rows;
+    ripple->seed = RIPPLE_SEED;
+}
+
+/**
+ * @brief Drops a stone: a dent of @p strength with half as deep a rim.
+ */
+void ICLED_Ripple_Drop( ICLED_Ripple *ripple, uint16_t x, uint16_t y, int16_t strength )
+{
+    if( ( ripple == NULL ) || ( x >= ripple->width ) || ( y >= ripple->rows ) ) return;
+
+    uint16_t stride = ripple->width + 2;
+    int16_t *cell = &ripple->current[( y + 1 ) * stride + x + 1];
+
+    // the rim stays inside the canvas, the border cells are always 0
+    cell[0] = Ripple_Clamp( cell[0] - strength );
+    if( x > 0 ) cell[-1] = Ripple_Clamp( cell[-1] - strength / 2 );
+    if( x + 1 < ripple->width ) cell[1] = Ripple_Clamp( cell[1] - strength / 2 );
+    if( y > 0 ) cell[-stride] = Ripple_Clamp( cell[-stride] - strength / 2 );
+    if( y + 1 < ripple->rows ) cell[stride] = Ripple_Clamp( cell[stride] - strength / 2 );
+}
+
+/**
+ * @brief Drops a stone at a random place, with a chance of @p chance / 256.
+ */
+bool ICLED_Ripple_Rain( ICLED_Ripple *ripple, uint8_t chance, int16_t strength )
+{
+    if( ripple == NULL ) return false;
+
+    // xorshift32
+    uint32_t seed = ripple->seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    ripple->seed = seed;
+
+    if( ( seed & 0xFFU ) >= chance ) return false;
+
+    ICLED_Ripple_Drop( ripple, ( uint16_t )( ( seed >> 8 ) % ripple->width ), ( uint16_t )( ( seed >> 20 ) % ripple->rows ), strength );
+    return true;
+}
+
+/**
+ * @brief Advances the surface by one step and swaps the fields.
+ */
+void ICLED_Ripple_Step( ICLED_Ripple *ripple )
+{
+    if( ripple == NULL ) return;
+
+    uint16_t stride = ripple->width + 2;
+    const int16_t *current = ripple->current;
+    int16_t *previous = ripple->previous;
+
+    for( uint16_t y = 1; y <= ripple->rows; y++ )
+    {
+        uint32_t row = ( uint32_t )y * stride + 1;
+
+        Ripple_Row( &previous[row], &current[row - stride], &current[row], &current[row + stride], ripple->width );
+    }
+
+    ripple->previous = ripple->current;
+    ripple->current = previous;
+}
+
+/**
+ * @brief Colours the surface through the water palette, column-major GRB.
+ */
+void ICLED_Ripple_Render( const ICLED_Ripple *ripple, uint8_t *grb, uint8_t brightness )
+{
+    if( ( ripple == NULL ) || ( grb == NULL ) ) return;
+
+    if( palette_brightness != brightness )
+    {
+        Ripple_BuildPalette( brightness );
+    }
+
+    uint16_t stride = ripple->width + 2;
+
+    for( uint16_t x = 0; x < ripple->width; x++ )
+    {
+        const int16_t *cell = &ripple->current[stride + x + 1];
+
+        for( uint16_t y = 0; y < ripple->rows; y++, cell += stride, grb += 3 )
+        {
+            int16_t level = ( int16_t )( *cell >> RIPPLE_SHIFT );
+            if( level > 255 ) level = 255;
+            if( level < -256 ) level = -256;
+
+            const uint8_t *color = palette[level + 256];
+
+            grb[0] = color[0];
+            grb[1] = color[1];
+            grb[2] = color[2];
+        }
+    }
+}
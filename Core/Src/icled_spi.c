@@ -0,0 +1,213 @@
+/**
+ * @file icled_spi.c
+ * @author MootSeeker
+ * @brief SPI slave frame input for a host processor (e.g. a Linux SBC).
+ *
+ * The SPI HAL driver is not part of this project, so SPI1 is configured on
+ * register level. The DMA (DMA2 channel 3, DMA1 channel 2 is taken by TIM1)
+ * uses the HAL DMA driver. PB0 is the hardware NSS of SPI1 and at the same
+ * time drives EXTI0 on its rising edge, which closes the frame.
+ * Of three buffers one captures, one waits and one is converted by
+ * ICLED_SPI_Process(), so a burst of frames never lands in the one being read.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_spi.h"
+#include "icled_interp.h"
+#include "icled_quad.h"
+
+#include "main.h"
+#include "icled_telemetry.h"
+
+#include <string.h>
+
+#define SPI_CS_Pin          GPIO_PIN_0
+#define SPI_CS_GPIO_Port    GPIOB
+
+#define SPI_BUFFERS         3
+
+/**
+ * @brief DMA handle for SPI1_RX.
+ */
+static DMA_HandleTypeDef hdma_spi1_rx;
+
+/**
+ * @brief Buffers for the received frames.
+ */
+static uint8_t spi_buffer[SPI_BUFFERS][ICLED_SPI_FRAME_BYTES];
+
+static volatile uint8_t capture_index;      ///< Buffer the DMA writes into
+static volatile int8_t ready_index = -1;    ///< Complete buffer waiting for ICLED_SPI_Process()
+static volatile int8_t in_use_index = -1;   ///< Buffer ICLED_SPI_Process() is converting
+
+static uint32_t last_frame_tick;
+static bool frame_shown;
+
+static volatile ICLED_SPIStats spi_stats;
+
+/**
+ * @brief Empties the SPI receive FIFO and clears an overrun.
+ */
+static void SPI_Flush( void )
+{
+    while( SPI1->SR & SPI_SR_FRLVL )
+    {
+        ( void )*( volatile uint8_t * )&SPI1->DR;
+    }
+    ( void )SPI1->SR;   // DR read followed by SR read clears OVR
+}
+
+/**
+ * @brief Arms the DMA for the next frame into the capture buffer.
+ */
+static void SPI_Arm( void )
+{
+    HAL_DMA_Abort( &hdma_spi1_rx );
+
+    // restart the slave so a broken frame cannot shift the bit counter of the next one
+    CLEAR_BIT( SPI1->CR1, SPI_CR1_SPE );
+    SPI_Flush( );
+
+    HAL_DMA_Start( &hdma_spi1_rx, ( uint32_t )&SPI1->DR, ( uint32_t )spi_buffer[capture_index], ICLED_SPI_FRAME_BYTES );
+
+    SET_BIT( SPI1->CR1, SPI_CR1_SPE );
+}
+
+/**
+ * @brief Configures SPI1, its DMA and the chip select interrupt.
+ */
+void ICLED_SPI_Init( void )
+{
+#if ICLED_QUAD
+    // PA7 and PB0 carry QUADSPI IO2 / IO1 of the four-lane output, the receiver stays off
+    return;
+#endif
+
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    __HAL_RCC_SPI1_CLK_ENABLE( );
+    __HAL_RCC_DMA2_CLK_ENABLE( );
+    __HAL_RCC_SYSCFG_CLK_ENABLE( );
+    __HAL_RCC_GPIOA_CLK_ENABLE( );
+    __HAL_RCC_GPIOB_CLK_ENABLE( );
+
+    /* PA1 = SPI1_SCK, PA7 = SPI1_MOSI, PB0 = SPI1_NSS */
+    GPIO_InitStruct.Pin = GPIO_PIN_1 | GPIO_PIN_7;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
+    HAL_GPIO_Init( GPIOA, &GPIO_InitStruct );
+
+    GPIO_InitStruct.Pin = SPI_CS_Pin;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init( SPI_CS_GPIO_Port, &GPIO_InitStruct );
+
+    /* The EXTI sees the pin through the input path, which stays active in alternate function mode */
+    MODIFY_REG( SYSCFG->EXTICR[0], SYSCFG_EXTICR1_EXTI0, SYSCFG_EXTICR1_EXTI0_PB );
+    SET_BIT( EXTI->RTSR1, EXTI_RTSR1_RT0 );
+    CLEAR_BIT( EXTI->FTSR1, EXTI_FTSR1_FT0 );
+    SET_BIT( EXTI->IMR1, EXTI_IMR1_IM0 );
+
+    hdma_spi1_rx.Instance = DMA2_Channel3;
+    hdma_spi1_rx.Init.Request = DMA_REQUEST_4;
+    hdma_spi1_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_spi1_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi1_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi1_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi1_rx.Init.Mode = DMA_NORMAL;
+    hdma_spi1_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    if( HAL_DMA_Init( &hdma_spi1_rx ) != HAL_OK )
+    {
+        Error_Handler( );
+    }
+
+    /* Slave, receive only, mode 0, MSB first, hardware NSS, 8 bit with RXNE at 1/4 FIFO */
+    SPI1->CR1 = SPI_CR1_RXONLY;
+    SPI1->CR2 = ( 7U << SPI_CR2_DS_Pos ) | SPI_CR2_FRXTH | SPI_CR2_RXDMAEN;
+
+    SPI_Arm( );
+
+    HAL_NVIC_SetPriority( EXTI0_IRQn, 1, 0 );
+    HAL_NVIC_EnableIRQ( EXTI0_IRQn );
+}
+
+/**
+ * @brief Chip select went high: close the frame and pick the next capture buffer.
+ */
+void ICLED_SPI_ChipSelectHandler( void )
+{
+    uint16_t received = ICLED_SPI_FRAME_BYTES - ( uint16_t )__HAL_DMA_GET_COUNTER( &hdma_spi1_rx );
+
+    if( received == ICLED_SPI_FRAME_BYTES )
+    {
+        uint8_t index = capture_index;
+        ready_index = ( int8_t )index;
+
+        // a ready buffer that was not taken yet is replaced, the one being converted is skipped
+        uint8_t next = 0;
+        while( ( next == index ) || ( ( int8_t )next == in_use_index ) ) next++;
+        capture_index = next;
+        spi_stats.frames++;
+
+#if ICLED_LATENCY
+        ICLED_Latency_Input( ICLED_LATENCY_SPI, ICLED_TELEMETRY_CYCLES( ) );
+#endif
+    }
+    else if( received > 0 )
+    {
+        spi_stats.errors++;
+    }
+
+    SPI_Arm( );
+}
+
+/**
+ * @brief Shows the latest complete frame, if there is a new one.
+ *
+ * The frame is converted into the GRB pixel buffer. Frames that arrive in
+ * the meantime go into the two other buffers.
+ */
+void ICLED_SPI_Process( void )
+{
+    __disable_irq( );
+    int8_t index = ready_index;
+    ready_index = -1;
+    in_use_index = index;
+    __enable_irq( );
+
+    if( index < 0 ) return;
+
+    ICLED_PixFmt_Convert( ICLED_SPI_FORMAT, ICLED_GetBuffer( ), spi_buffer[index], ICLED_LED_COUNT );
+
+    // the DMA may capture into this buffer again
+    in_use_index = -1;
+
+    ICLED_Interp_Push( );
+
+    spi_stats.shown++;
+    last_frame_tick = HAL_GetTick( );
+    frame_shown = true;
+}
+
+/**
+ * @brief Checks whether the host is sending frames.
+ */
+bool ICLED_SPI_IsActive( void )
+{
+    return frame_shown && ( ( HAL_GetTick( ) - last_frame_tick ) < ICLED_SPI_HOLD_MS );
+}
+
+/**
+ * @brief Copies the counters.
+ */
+void ICLED_SPI_GetStats( ICLED_SPIStats *stats )
+{
+    if( stats == NULL ) return;
+
+    memcpy( stats, ( const void * )&spi_stats, sizeof( spi_stats ) );
+}
@@ -0,0 +1,576 @@
+/**
+ * @file icled_stream.c
+ * @author MootSeeker
+ * @brief Decoders for PC-side LED streaming protocols on USART2.
+ *
+ * USART2 receives into a circular DMA buffer. ICLED_Stream_Process() walks the
+ * new bytes through a small state machine: the first header byte selects the
+ * protocol, whole pixels of the payload are converted directly from the receive
+ * buffer into the ICLED pixel buffer and the frame is shown when its last byte
+ * (and trailer, if any) arrived. Only a pixel split by the end of the buffer
+ * (or of a DDP packet) is collected byte by byte.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_stream.h"
+#include "icled.h"
+#include "icled_interp.h"
+
+#include "main.h"
+#include "usart.h"
+#include "icled_telemetry.h"
+
+#include <string.h>
+
+/**
+ * @def ICLED_STREAM_FRAME_BYTES
+ * @brief Number of pixel bytes the matrix can take.
+ */
+#define ICLED_STREAM_FRAME_BYTES    (ICLED_LED_COUNT * 3)
+
+/**
+ * @brief Protocol constants.
+ */
+#define TPM2_START          0xC9
+#define TPM2_TYPE_DATA      0xDA
+#define TPM2_END            0x36
+
+#define DDP_VERSION_MASK    0xC0
+#define DDP_VERSION_1       0x40
+#define DDP_FLAG_TIMECODE   0x10
+#define DDP_FLAG_QUERY      0x08
+#define DDP_FLAG_PUSH       0x01
+#define DDP_ID_DISPLAY      1
+#define DDP_TYPE_UNDEFINED  0x00
+#define DDP_TYPE_RGB8       0x0B
+#define DDP_TYPE_RGBW8      0x1B
+
+#define ADALIGHT_HEADER_LEN 6
+#define TPM2_HEADER_LEN     4
+#define DDP_HEADER_LEN      10
+#define DDP_TC_HEADER_LEN   14
+
+/**
+ * @brief Time stamp counts per byte on the line (8N1, 10 bit times).
+ */
+#define STREAM_CHAR_CYCLES  ( ICLED_LATENCY_CYCLES_PER_US * 10000000U / ICLED_STREAM_BAUDRATE )
+
+/**
+ * @enum StreamState
+ * @brief State of the byte decoder.
+ */
+typedef enum
+{
+    STREAM_SYNC,        ///< Waiting for the first header byte
+    STREAM_HEADER,      ///< Collecting the header
+    STREAM_PAYLOAD,     ///< Writing pixel data
+    STREAM_TRAILER      ///< Waiting for the TPM2 end byte
+} StreamState;
+
+/**
+ * @brief Circular DMA receive buffer.
+ */
+static uint8_t rx_buffer[ICLED_STREAM_RX_SIZE];
+
+/**
+ * @brief Read position in rx_buffer.
+ */
+static uint16_t rx_tail;
+
+static StreamState state = STREAM_SYNC;
+static ICLED_StreamProtocol protocol;
+static uint8_t header[DDP_TC_HEADER_LEN];
+static uint8_t header_len;
+static uint8_t header_needed;
+
+static uint8_t *frame;          ///< ICLED pixel buffer (GRB)
+static uint16_t pixel;          ///< Byte offset of the current pixel in frame
+static ICLED_PixFmt format;     ///< Format of the payload
+static uint8_t pixel_bytes;     ///< Bytes per pixel of the payload
+static uint8_t pending[4];      ///< Bytes of a pixel split between two runs
+static uint8_t part;            ///< Bytes of the current pixel received so far
+static uint32_t payload_left;   ///< Payload bytes still to come
+static bool show_on_complete;   ///< Whether the frame is shown once the payload is done
+
+static uint32_t last_byte_tick;
+static uint32_t last_frame_tick;
+static bool frame_shown;
+
+static ICLED_StreamStats stream_stats;
+
+#if ICLED_LATENCY
+static volatile uint32_t idle_cycles;   ///< Time stamp of the last idle line
+static volatile uint16_t idle_head;     ///< DMA write position at the last idle line
+static volatile bool idle_seen;         ///< An idle line was detected since the last poll
+
+static uint32_t rx_end_cycles;          ///< Arrival of the last byte of the current poll
+static const uint8_t *decode_end;       ///< End of the block Stream_Decode() works on
+static uint16_t decode_rest;            ///< Bytes of the current poll after that block
+static const uint8_t *frame_end;        ///< First byte after the frame that completes
+#endif
+
+/**
+ * @brief Prepares the payload pointer for a frame starting at the given byte offset.
+ *
+ * pending[] is kept, so a pixel split between two DDP packets at consecutive
+ * offsets is completed by the second one.
+ *
+ * @param offset Byte offset into the pixel data of the matrix (in the source format).
+ * @param length Number of payload bytes.
+ * @param show   Whether to show the frame once the payload is complete.
+ * @param source Format of the payload.
+ */
+static void Stream_BeginPayload( uint32_t offset, uint32_t length, bool show, ICLED_PixFmt source )
+{
+    uint32_t index;
+
+    // index order, also after an effect scrolled the buffer (ICLED_ScrollColumns())
+    frame = ICLED_GetBuffer( );
+
+    format = source;
+    pixel_bytes = ( uint8_t )ICLED_PIXFMT_BYTES( source );
+    index = offset / pixel_bytes;
+
+    pixel = ( index < ICLED_LED_COUNT ) ? ( uint16_t )( index * 3 ) : ICLED_STREAM_FRAME_BYTES;
+    part = ( uint8_t )( offset % pixel_bytes );
+    payload_left = length;
+    show_on_complete = show;
+    state = STREAM_PAYLOAD;
+}
+
+/**
+ * @brief Shows the received frame and updates the counters.
+ */
+static void Stream_ShowFrame( void )
+{
+#if ICLED_LATENCY
+    // the bytes after the last byte of the frame arrived at the line rate before rx_end_cycles
+    uint32_t rest = ( uint32_t )( decode_end - frame_end ) + decode_rest;
+    ICLED_Latency_Input( ICLED_LATENCY_STREAM, rx_end_cycles - rest * STREAM_CHAR_CYCLES );
+#endif
+
+    ICLED_Interp_Push( );
+    stream_stats.frames[protocol]++;
+    last_frame_tick = HAL_GetTick( );
+    frame_shown = true;
+}
+
+/**
+ * @brief Called when all payload bytes of a frame were written.
+ */
+static void Stream_PayloadDone( void )
+{
+    if( protocol == ICLED_STREAM_TPM2 )
+    {
+        state = STREAM_TRAILER;
+        return;
+    }
+
+    if( show_on_complete )
+    {
+        Stream_ShowFrame( );
+    }
+    state = STREAM_SYNC;
+}
+
+/**
+ * @brief Checks the first header byte and selects the protocol.
+ *
+ * @param value The received byte.
+ */
+static void Stream_Sync( uint8_t value )
+{
+    header[0] = value;
+    header_len = 1;
+
+    if( value == 'A' )
+    {
+        // 'A' (0x41) is also a valid DDP v1 flags byte with PUSH set, the second byte decides
+        protocol = ICLED_STREAM_ADALIGHT;
+        header_needed = ADALIGHT_HEADER_LEN;
+    }
+    else if( value == TPM2_START )
+    {
+        protocol = ICLED_STREAM_TPM2;
+        header_needed = TPM2_HEADER_LEN;
+    }
+    else if( ( value & DDP_VERSION_MASK ) == DDP_VERSION_1 )
+    {
+        protocol = ICLED_STREAM_DDP;
+        header_needed = ( value & DDP_FLAG_TIMECODE ) ? DDP_TC_HEADER_LEN : DDP_HEADER_LEN;
+    }
+    else
+    {
+        state = STREAM_SYNC;
+        return;
+    }
+
+    state = STREAM_HEADER;
+}
+
+/**
+ * @brief Validates a complete header and starts the payload.
+ *
+ * @return false if the header is invalid.
+ */
+static bool Stream_HeaderDone( void )
+{
+    switch( protocol )
+    {
+        case ICLED_STREAM_ADALIGHT:
+        {
+            // LED count - 1, high byte first, checksum = hi ^ lo ^ 0x55
+            if( ( header[1] != 'd' ) || ( header[2] != 'a' ) || ( header[5] != ( header[3] ^ header[4] ^ 0x55 ) ) )
+            {
+                return false;
+            }
+            uint32_t leds = ( ( ( uint32_t )header[3] << 8 ) | header[4] ) + 1;
+            Stream_BeginPayload( 0, leds * ICLED_PIXFMT_BYTES( ICLED_STREAM_FORMAT ), true, ICLED_STREAM_FORMAT );
+            return true;
+        }
+
+        case ICLED_STREAM_TPM2:
+        {
+            // only data frames are shown, command frames are skipped
+            uint32_t size = ( ( uint32_t )header[2] << 8 ) | header[3];
+            Stream_BeginPayload( 0, size, header[1] == TPM2_TYPE_DATA, ICLED_STREAM_FORMAT );
+            return true;
+        }
+
+        case ICLED_STREAM_DDP:
+        {
+            uint8_t flags = header[0];
+            uint8_t type = header[2];
+            uint8_t id = header[3];
+            uint32_t offset = ( ( uint32_t )header[4] << 24 ) | ( ( uint32_t )header[5] << 16 ) |
+                              ( ( uint32_t )header[6] << 8 ) | header[7];
+            uint32_t length = ( ( uint32_t )header[8] << 8 ) | header[9];
+            bool is_pixel_data = ( id == DDP_ID_DISPLAY ) && !( flags & DDP_FLAG_QUERY ) &&
+                                 ( ( type == DDP_TYPE_UNDEFINED ) || ( type == DDP_TYPE_RGB8 ) ||
+                                   ( type == DDP_TYPE_RGBW8 ) );
+
+            if( !is_pixel_data )
+            {
+                // skip the payload without touching the pixel buffer
+                offset = ICLED_STREAM_FRAME_BYTES;
+            }
+            Stream_BeginPayload( offset, length, is_pixel_data && ( flags & DDP_FLAG_PUSH ),
+                                 ( type == DDP_TYPE_RGBW8 ) ? ICLED_PIXFMT_RGBW : ICLED_PIXFMT_RGB );
+            if( length == 0 )
+            {
+                Stream_PayloadDone( );
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Feeds one header byte.
+ *
+ * @param value The received byte.
+ */
+static void Stream_Header( uint8_t value )
+{
+    header[header_len++] = value;
+
+    if( header_len == 2 )
+    {
+        if( ( protocol == ICLED_STREAM_ADALIGHT ) && ( value != 'd' ) )
+        {
+            // not "Ad", the 'A' may still be the flags byte of a DDP header
+            protocol = ICLED_STREAM_DDP;
+            header_needed = DDP_HEADER_LEN;
+        }
+
+        if( ( protocol == ICLED_STREAM_DDP ) && ( value & 0xF0 ) )
+        {
+            // the upper nibble of the DDP sequence number is reserved, this was no header
+            stream_stats.errors++;
+            Stream_Sync( value );
+            return;
+        }
+    }
+
+    if( header_len < header_needed )
+    {
+        return;
+    }
+
+    if( !Stream_HeaderDone( ) )
+    {
+        stream_stats.errors++;
+        Stream_Sync( value );
+    }
+}
+
+/**
+ * @brief Converts whole pixels into the pixel buffer, pixels beyond the matrix are dropped.
+ *
+ * @param data   Source pixels.
+ * @param pixels Number of pixels.
+ */
+static void Stream_StorePixels( const uint8_t *data, uint16_t pixels )
+{
+    uint32_t end = pixel + ( uint32_t )pixels * 3;
+
+    if( pixel < ICLED_STREAM_FRAME_BYTES )
+    {
+        uint16_t room = ( uint16_t )( ( ICLED_STREAM_FRAME_BYTES - pixel ) / 3 );
+        ICLED_PixFmt_Convert( format, &frame[pixel], data, ( pixels < room ) ? pixels : room );
+    }
+
+    pixel = ( end < ICLED_STREAM_FRAME_BYTES ) ? ( uint16_t )end : ICLED_STREAM_FRAME_BYTES;
+}
+
+/**
+ * @brief Writes a run of payload bytes into the pixel buffer.
+ *
+ * @param data   Received bytes.
+ * @param length Number of bytes available.
+ *
+ * @return Number of bytes consumed.
+ */
+static uint16_t Stream_Payload( const uint8_t *data, uint16_t length )
+{
+    uint16_t count = ( payload_left < length ) ? ( uint16_t )payload_left : length;
+    uint16_t i = 0;
+
+    if( part > 0 )
+    {
+        // complete the pixel the previous run ended in
+        while( ( part < pixel_bytes ) && ( i < count ) )
+        {
+            pending[part++] = data[i++];
+        }
+
+        if( part == pixel_bytes )
+        {
+            Stream_StorePixels( pending, 1 );
+            part = 0;
+        }
+    }
+
+    uint16_t whole = ( uint16_t )( ( count - i ) / pixel_bytes );
+    Stream_StorePixels( &data[i], whole );
+    i += ( uint16_t )( whole * pixel_bytes );
+
+    while( i < count )
+    {
+        pending[part++] = data[i++];
+    }
+
+    payload_left -= count;
+    if( payload_left == 0 )
+    {
+#if ICLED_LATENCY
+        frame_end = &data[count];
+#endif
+        Stream_PayloadDone( );
+    }
+
+    return count;
+}
+
+/**
+ * @brief Decodes a contiguous block of received bytes.
+ *
+ * @param data   Received bytes.
+ * @param length Number of bytes.
+ */
+static void Stream_Decode( const uint8_t *data, uint16_t length )
+{
+    uint16_t i = 0;
+
+#if ICLED_LATENCY
+    decode_end = &data[length];
+#endif
+
+    while( i < length )
+    {
+#if ICLED_LATENCY
+        // a frame that completes in this step ends with the byte the step reads, unless it is payload
+        frame_end = &data[i + 1];
+#endif
+
+        switch( state )
+        {
+            case STREAM_SYNC:
+                Stream_Sync( data[i++] );
+                break;
+
+            case STREAM_HEADER:
+                Stream_Header( data[i++] );
+                break;
+
+            case STREAM_PAYLOAD:
+                i += Stream_Payload( &data[i], length - i );
+                break;
+
+            case STREAM_TRAILER:
+                if( data[i++] == TPM2_END )
+                {
+                    if( show_on_complete )
+                    {
+                        Stream_ShowFrame( );
+                    }
+                }
+                else
+                {
+                    stream_stats.errors++;
+                }
+                state = STREAM_SYNC;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Starts the circular DMA reception on USART2.
+ */
+void ICLED_Stream_Init( void )
+{
+    static const uint8_t handshake[] = { 'A', 'd', 'a', '\n' };
+
+    frame = ICLED_GetBuffer( );
+
+    if( huart2.Init.BaudRate != ICLED_STREAM_BAUDRATE )
+    {
+        huart2.Init.BaudRate = ICLED_STREAM_BAUDRATE;
+        // 16x oversampling of the 16 MHz HSI only reaches 1 Mbaud
+        huart2.Init.OverSampling = ( ICLED_STREAM_BAUDRATE > 1000000 ) ? UART_OVERSAMPLING_8 : UART_OVERSAMPLING_16;
+        if( HAL_UART_Init( &huart2 ) != HAL_OK )
+        {
+            Error_Handler( );
+        }
+    }
+
+    if( HAL_UART_Receive_DMA( &huart2, rx_buffer, ICLED_STREAM_RX_SIZE ) != HAL_OK )
+    {
+        Error_Handler( );
+    }
+
+    HAL_UART_Transmit( &huart2, ( uint8_t* )handshake, sizeof( handshake ), 10 );
+
+#if ICLED_LATENCY
+    // the idle line interrupt dates the end of a frame for the latency measurement
+    __HAL_UART_CLEAR_FLAG( &huart2, UART_CLEAR_IDLEF );
+    __HAL_UART_ENABLE_IT( &huart2, UART_IT_IDLE );
+    HAL_NVIC_SetPriority( USART2_IRQn, 1, 0 );
+    HAL_NVIC_EnableIRQ( USART2_IRQn );
+#endif
+}
+
+/**
+ * @brief USART2 interrupt handler (idle line).
+ */
+void ICLED_Stream_IRQHandler( void )
+{
+#if ICLED_LATENCY
+    if( huart2.Instance->ISR & USART_ISR_IDLE )
+    {
+        idle_cycles = ICLED_TELEMETRY_CYCLES( );
+        idle_head = ICLED_STREAM_RX_SIZE - ( uint16_t )__HAL_DMA_GET_COUNTER( huart2.hdmarx );
+        idle_seen = true;
+    }
+
+    // HAL_UART_Receive_DMA() enabled the error interrupts as well, the DMA keeps running after them
+    __HAL_UART_CLEAR_FLAG( &huart2, UART_CLEAR_IDLEF | UART_CLEAR_OREF | UART_CLEAR_NEF | UART_CLEAR_FEF | UART_CLEAR_PEF );
+#endif
+}
+
+/**
+ * @brief Decodes all bytes the DMA wrote since the last call.
+ */
+void ICLED_Stream_Process( void )
+{
+    uint16_t head = ICLED_STREAM_RX_SIZE - ( uint16_t )__HAL_DMA_GET_COUNTER( huart2.hdmarx );
+    uint32_t now = HAL_GetTick( );
+
+    if( head == ICLED_STREAM_RX_SIZE )
+    {
+        head = 0;
+    }
+
+    if( head == rx_tail )
+    {
+        if( ( state != STREAM_SYNC ) && ( ( now - last_byte_tick ) > ICLED_STREAM_TIMEOUT_MS ) )
+        {
+            stream_stats.errors++;
+            state = STREAM_SYNC;
+        }
+        return;
+    }
+
+    last_byte_tick = now;
+
+#if ICLED_LATENCY
+    __disable_irq( );
+    // a line that went idle right after the newest byte dates it one character before the interrupt
+    rx_end_cycles = ( idle_seen && ( idle_head % ICLED_STREAM_RX_SIZE == head ) ) ?
+                    idle_cycles - STREAM_CHAR_CYCLES : ICLED_TELEMETRY_CYCLES( );
+    idle_seen = false;
+    __enable_irq( );
+    decode_rest = 0;
+#endif
+
+    if( head > rx_tail )
+    {
+        stream_stats.bytes += head - rx_tail;
+        Stream_Decode( &rx_buffer[rx_tail], head - rx_tail );
+    }
+    else
+    {
+        stream_stats.bytes += ICLED_STREAM_RX_SIZE - rx_tail + head;
+#if ICLED_LATENCY
+        decode_rest = head;
+#endif
+        Stream_Decode( &rx_buffer[rx_tail], ICLED_STREAM_RX_SIZE - rx_tail );
+#if ICLED_LATENCY
+        decode_rest = 0;
+#endif
+        Stream_Decode( rx_buffer, head );
+    }
+
+    rx_tail = head;
+}
+
+/**
+ * @brief Decodes bytes that did not arrive on USART2.
+ */
+void ICLED_Stream_Feed( const uint8_t *data, uint16_t length )
+{
+    if( ( data == NULL ) || ( frame == NULL ) ) return;
+
+    stream_stats.bytes += length;
+
+#if ICLED_LATENCY
+    rx_end_cycles = ICLED_TELEMETRY_CYCLES( );
+    decode_rest = 0;
+#endif
+    Stream_Decode( data, length );
+}
+
+/**
+ * @brief Checks whether a host is currently streaming.
+ */
+bool ICLED_Stream_IsActive( void )
+{
+    return frame_shown && ( ( HAL_GetTick( ) - last_frame_tick ) < ICLED_STREAM_HOLD_MS );
+}
+
+/**
+ * @brief Copies the decoder counters.
+ */
+void ICLED_Stream_GetStats( ICLED_StreamStats *stats )
+{
+    if( stats == NULL ) return;
+
+    memcpy( stats, &stream_stats, sizeof( stream_stats ) );
+}
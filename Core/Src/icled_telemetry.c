@@ -0,0 +1,147 @@
+/**
+ * @file icled_telemetry.c
+ * @author MootSeeker
+ * @brief Memory-mapped telemetry block for debug probes and host tools.
+ *
+ * The stack high-water mark works with a painted stack: at start-up the free
+ * RAM between the heap start and the stack pointer is filled with a pattern,
+ * the deepest overwritten word marks the high-water. Each check only looks at
+ * the words just below the last mark, so it costs a few cycles per pass.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_telemetry.h"
+
+#include "icled_stream.h"
+#include "icled_dmx.h"
+#include "icled_spi.h"
+#include "icled_i2c.h"
+#include "icled_load.h"
+#include "main.h"
+
+#include <string.h>
+
+#define TELEMETRY_STACK_PAINT   0xA5A5A5A5U
+#define TELEMETRY_STACK_PROBE   16          ///< Untouched words below the mark that end a check
+
+extern uint32_t _sdata;     // start of .data (start of RAM)
+extern uint32_t _end;       // end of .bss, heap and stack grow into the space above
+extern uint32_t _estack;    // top of the stack
+
+/**
+ * @brief The block, placed in SRAM2 by the linker script and not cleared by the start-up code.
+ */
+volatile ICLED_Telemetry icled_telemetry __attribute__(( section( ".telemetry" ), used ));
+
+static uint32_t *stack_mark;    ///< Lowest stack word known to be used
+
+/**
+ * @brief Validates the block, counts the start and clears the counters.
+ */
+void ICLED_Telemetry_Init( void )
+{
+    uint32_t boots = 0;
+
+    if( ( icled_telemetry.magic == ICLED_TELEMETRY_MAGIC ) && ( icled_telemetry.version == ICLED_TELEMETRY_VERSION ) &&
+        ( icled_telemetry.size == sizeof( ICLED_Telemetry ) ) )
+    {
+        boots = icled_telemetry.boots;
+    }
+
+    memset( ( void * )&icled_telemetry, 0, sizeof( icled_telemetry ) );
+
+    icled_telemetry.version = ICLED_TELEMETRY_VERSION;
+    icled_telemetry.size = sizeof( ICLED_Telemetry );
+    icled_telemetry.boots = boots + 1;
+    icled_telemetry.reset_flags = RCC->CSR & 0xFF000000U;
+    SET_BIT( RCC->CSR, RCC_CSR_RMVF );
+    icled_telemetry.ram_static = ( uint32_t )( ( uint8_t * )&_end - ( uint8_t * )&_sdata );
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // paint the free RAM below the stack, the probe words right below the stack pointer stay live
+    stack_mark = ( uint32_t * )( uintptr_t )( __get_MSP( ) - 64U );
+    for( uint32_t *word = &_end; word < stack_mark; word++ )
+    {
+        *word = TELEMETRY_STACK_PAINT;
+    }
+
+    // a reader only trusts the block once the magic is set
+    __DMB( );
+    icled_telemetry.magic = ICLED_TELEMETRY_MAGIC;
+}
+
+/**
+ * @brief Deepest stack use since ICLED_Telemetry_Init() in bytes.
+ */
+uint32_t ICLED_Telemetry_StackHighWater( void )
+{
+    if( stack_mark == NULL ) return 0;
+
+    uint32_t *word = stack_mark;
+    uint32_t untouched = 0;
+
+    // locals that are never written leave gaps, so a few untouched words do not end the scan
+    while( ( word > &_end ) && ( untouched < TELEMETRY_STACK_PROBE ) )
+    {
+        word--;
+        if( *word != TELEMETRY_STACK_PAINT )
+        {
+            stack_mark = word;
+            untouched = 0;
+        }
+        else
+        {
+            untouched++;
+        }
+    }
+
+    uint32_t used = ( uint32_t )( ( uint8_t * )&_estack - ( uint8_t * )stack_mark );
+    icled_telemetry.stack_hwm = used;
+
+    return used;
+}
+
+/**
+ * @brief Mirrors the input, CPU and RAM figures into the block.
+ */
+void ICLED_Telemetry_Process( void )
+{
+    ICLED_StreamStats stream;
+    ICLED_DMXStats dmx;
+    ICLED_SPIStats spi;
+    ICLED_I2CStats i2c;
+    ICLED_LoadStats load;
+
+    ICLED_Stream_GetStats( &stream );
+    ICLED_DMX_GetStats( &dmx );
+    ICLED_SPI_GetStats( &spi );
+    ICLED_I2C_GetStats( &i2c );
+    ICLED_Load_GetStats( &load );
+
+    icled_telemetry.uptime_ms = HAL_GetTick( );
+
+    icled_telemetry.uart_bytes = stream.bytes;
+    icled_telemetry.uart_frames = stream.frames[ICLED_STREAM_ADALIGHT] + stream.frames[ICLED_STREAM_TPM2] +
+                                  stream.frames[ICLED_STREAM_DDP];
+    icled_telemetry.uart_errors = stream.errors;
+
+    icled_telemetry.dmx_packets = dmx.breaks;
+    icled_telemetry.dmx_frames = dmx.frames;
+    icled_telemetry.dmx_errors = dmx.errors;
+
+    icled_telemetry.spi_frames = spi.frames;
+    icled_telemetry.spi_errors = spi.errors;
+
+    icled_telemetry.i2c_writes = i2c.writes;
+    icled_telemetry.i2c_errors = i2c.errors;
+
+    icled_telemetry.cpu_load = load.load;
+    icled_telemetry.headroom_us = load.headroom_us;
+
+    ICLED_Telemetry_StackHighWater( );
+}
@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "dma.h"
+#include "i2c.h"
 #include "tim.h"
 #include "usart.h"
 #include "gpio.h"
@@ -26,7 +27,18 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "icled.h"
+#include "icled_stream.h"
+#include "icled_dmx.h"
+#include "icled_spi.h"
+#include "icled_i2c.h"
+#include "icled_quad.h"
 #include "example_app.h"
+#include "icled_bench.h"
+#include "icled_load.h"
+#include "icled_telemetry.h"
+#include "icled_monitor.h"
+#include "icled_interp.h"
+#include "icled_mirror.h"
 
 /* USER CODE END Includes */
 
@@ -63,6 +75,45 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+#if ICLED_BENCH
+/* Benchmark build: cycle counter, output and RAM high-water mark for ICLED_Bench_Run() */
+static uint32_t Bench_Cycles( void )
+{
+	return DWT->CYCCNT;
+}
+
+static void Bench_Write( const char *line, uint16_t length )
+{
+	HAL_UART_Transmit( &huart2, ( const uint8_t * )line, length, 100 );
+}
+
+/**
+ * @brief Static RAM plus the deepest stack use since ICLED_Telemetry_Init().
+ */
+static uint32_t Bench_RamUsed( void )
+{
+	return icled_telemetry.ram_static + ICLED_Telemetry_StackHighWater( );
+}
+
+static void Bench_Start( void )
+{
+	const ICLED_BenchPort port =
+	{
+		.target   = "stm32l432",
+		.clock_hz = SystemCoreClock,
+		.cycles   = Bench_Cycles,
+		.write    = Bench_Write,
+		.ram_used = Bench_RamUsed,
+		.isr_hooks = true,
+	};
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	ICLED_Bench_Run( &port );
+}
+#endif
 
 /* USER CODE END 0 */
 
@@ -98,18 +149,77 @@ int main(void)
   MX_DMA_Init();
   MX_USART2_UART_Init();
   MX_TIM1_Init();
+  MX_USART1_UART_Init();
+  MX_I2C1_Init();
   /* USER CODE BEGIN 2 */
 
+  /* Telemetry block in SRAM2 for debug probes, first so the stack paint covers all of the init */
+  ICLED_Telemetry_Init();
+
   /* Initialize ICLED driver */
   ICLED_Init();
 
+  /* Receive Adalight / TPM2 / DDP frames on the virtual COM port */
+  ICLED_Stream_Init();
+
+  /* Receive DMX512 from a lighting desk on USART1 (PA10) */
+  ICLED_DMX_Init();
+
+  /* Receive frames from a host processor on SPI1 (slave) */
+  ICLED_SPI_Init();
+
+  /* Register map for a host MCU on I2C1 (slave) */
+  ICLED_I2C_Init();
+
+  /* Four chains on the QUADSPI data lines (ICLED_QUAD) */
+  ICLED_Quad_Init();
+
+#if ICLED_BENCH
+  /* Benchmark build: JSON lines on USART2, then the normal main loop */
+  Bench_Start();
+#endif
+
+  /* Idle-time accounting for the CPU load figures */
+  ICLED_Load_Init();
+
+  /* Frame deadline monitor, recovers a stalled LED output (and feeds the IWDG if enabled) */
+  ICLED_Monitor_Init();
+
+  /* Mirror of the shown frames on USART2 TX (ICLED_MIRROR) */
+  ICLED_Mirror_Init();
+
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-	 example_app_run( );
+	 uint32_t frames = ICLED_GetFrameCount( );
+
+	 ICLED_Stream_Process( );
+	 ICLED_DMX_Process( );
+	 ICLED_SPI_Process( );
+	 ICLED_I2C_Process( );
+
+	 /* In-between frames of the frame inputs (ICLED_INTERP) */
+	 ICLED_Interp_Process( );
+
+	 /* The demo effects pause while a host or a desk is sending */
+	 if( !ICLED_Stream_IsActive( ) && !ICLED_DMX_IsActive( ) && !ICLED_SPI_IsActive( ) && !ICLED_I2C_IsActive( ) )
+	 {
+		 example_app_run( );
+	 }
+	 else if( ICLED_GetFrameCount( ) == frames )
+	 {
+		 /* An input holds the matrix and nothing new arrived */
+		 ICLED_Load_Idle( );
+	 }
+
+	 ICLED_Monitor_Process( );
+	 ICLED_Mirror_Process( );
+	 ICLED_Quad_Process( );
+	 ICLED_Load_Process( );
+	 ICLED_Telemetry_Process( );
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -22,6 +22,12 @@
 #include "stm32l4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "icled.h"
+#include "icled_bench.h"
+#include "icled_dmx.h"
+#include "icled_quad.h"
+#include "icled_spi.h"
+#include "icled_stream.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -55,7 +61,13 @@
 /* USER CODE END 0 */
 
 /* External variables --------------------------------------------------------*/
+extern DMA_HandleTypeDef hdma_i2c1_rx;
+extern DMA_HandleTypeDef hdma_i2c1_tx;
+extern I2C_HandleTypeDef hi2c1;
 extern DMA_HandleTypeDef hdma_tim1_ch1;
+extern DMA_HandleTypeDef hdma_usart1_rx;
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern UART_HandleTypeDef huart1;
 /* USER CODE BEGIN EV */
 
 /* USER CODE END EV */
@@ -183,11 +195,11 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+  ICLED_BENCH_ISR_ENTER();
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
-
+  ICLED_BENCH_ISR_EXIT();
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -204,11 +216,11 @@ void SysTick_Handler(void)
 void EXTI4_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI4_IRQn 0 */
-
+  ICLED_BENCH_ISR_ENTER();
   /* USER CODE END EXTI4_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(S2_Pin);
   /* USER CODE BEGIN EXTI4_IRQn 1 */
-
+  ICLED_BENCH_ISR_EXIT();
   /* USER CODE END EXTI4_IRQn 1 */
 }
 
@@ -218,14 +230,161 @@ void EXTI4_IRQHandler(void)
 void DMA1_Channel2_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Channel2_IRQn 0 */
-
+  ICLED_BENCH_ISR_ENTER();
   /* USER CODE END DMA1_Channel2_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_tim1_ch1);
   /* USER CODE BEGIN DMA1_Channel2_IRQn 1 */
-
+  ICLED_BENCH_ISR_EXIT();
   /* USER CODE END DMA1_Channel2_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 channel5 global interrupt.
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel5_IRQn 0 */
+  ICLED_BENCH_ISR_ENTER();
+  /* USER CODE END DMA1_Channel5_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart1_rx);
+  /* USER CODE BEGIN DMA1_Channel5_IRQn 1 */
+  ICLED_BENCH_ISR_EXIT();
+  /* USER CODE END DMA1_Channel5_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel6 global interrupt.
+  */
+void DMA1_Channel6_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel6_IRQn 0 */
+  ICLED_BENCH_ISR_ENTER();
+  /* USER CODE END DMA1_Channel6_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart2_rx);
+  /* USER CODE BEGIN DMA1_Channel6_IRQn 1 */
+  ICLED_BENCH_ISR_EXIT();
+  /* USER CODE END DMA1_Channel6_IRQn 1 */
+}
+
+/**
+  * @brief This function handles I2C1 event interrupt.
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  /* USER CODE BEGIN I2C1_EV_IRQn 0 */
+  ICLED_BENCH_ISR_ENTER();
+  /* USER CODE END I2C1_EV_IRQn 0 */
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+  /* USER CODE BEGIN I2C1_EV_IRQn 1 */
+  ICLED_BENCH_ISR_EXIT();
+  /* USER CODE END I2C1_EV_IRQn 1 */
+}
+
+/**
+  * @brief This function handles I2C1 error interrupt.
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  /* USER CODE BEGIN I2C1_ER_IRQn 0 */
+  ICLED_BENCH_ISR_ENTER();
+  /* USER CODE END I2C1_ER_IRQn 0 */
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+  /* USER CODE BEGIN I2C1_ER_IRQn 1 */
+  ICLED_BENCH_ISR_EXIT();
+  /* USER CODE END I2C1_ER_IRQn 1 */
+}
+
+/**
+  * @brief This function handles USART1 global interrupt.
+  */
+void USART1_IRQHandler(void)
+{
+  /* USER CODE BEGIN USART1_IRQn 0 */
+  /* Break detection of the DMX512 receiver, handles all USART1 events itself */
+  ICLED_BENCH_ISR_ENTER();
+  ICLED_DMX_IRQHandler();
+  ICLED_BENCH_ISR_EXIT();
+  return;
+  /* USER CODE END USART1_IRQn 0 */
+  HAL_UART_IRQHandler(&huart1);
+  /* USER CODE BEGIN USART1_IRQn 1 */
+
+  /* USER CODE END USART1_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA2 channel6 global interrupt.
+  */
+void DMA2_Channel6_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA2_Channel6_IRQn 0 */
+  ICLED_BENCH_ISR_ENTER();
+  /* USER CODE END DMA2_Channel6_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_i2c1_rx);
+  /* USER CODE BEGIN DMA2_Channel6_IRQn 1 */
+  ICLED_BENCH_ISR_EXIT();
+  /* USER CODE END DMA2_Channel6_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA2 channel7 global interrupt.
+  */
+void DMA2_Channel7_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA2_Channel7_IRQn 0 */
+  ICLED_BENCH_ISR_ENTER();
+  /* USER CODE END DMA2_Channel7_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_i2c1_tx);
+  /* USER CODE BEGIN DMA2_Channel7_IRQn 1 */
+  ICLED_BENCH_ISR_EXIT();
+  /* USER CODE END DMA2_Channel7_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles EXTI line0 interrupt (SPI1 chip select rising edge).
+  */
+void EXTI0_IRQHandler(void)
+{
+  __HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_0);
+  ICLED_BENCH_ISR_ENTER();
+  ICLED_SPI_ChipSelectHandler();
+  ICLED_BENCH_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles USART2 global interrupt (stream idle line, ICLED_LATENCY only).
+  */
+void USART2_IRQHandler(void)
+{
+  ICLED_BENCH_ISR_ENTER();
+  ICLED_Stream_IRQHandler();
+  ICLED_BENCH_ISR_EXIT();
+}
+
+#if ICLED_OUTPUT_USART
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (USART1 TX of the LED output).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  ICLED_BENCH_ISR_ENTER();
+  ICLED_USART_IRQHandler();
+  ICLED_BENCH_ISR_EXIT();
+}
+#endif
+
+#if ICLED_QUAD
+/**
+  * @brief This function handles QUADSPI global interrupt (four-lane LED output).
+  */
+void QUADSPI_IRQHandler(void)
+{
+  ICLED_BENCH_ISR_ENTER();
+  ICLED_Quad_IRQHandler();
+  ICLED_BENCH_ISR_EXIT();
+}
+#endif
+
 /* USER CODE END 1 */
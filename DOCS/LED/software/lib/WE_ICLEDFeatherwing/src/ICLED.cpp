@@ -26,6 +26,7 @@
 #include "ICLED.h"
 #include <SPI.h>
 #include "ASCII_character.h"
+#include "UTF8_character.h"
 #include "emoji_symbol.h"
 #include "ConfigPlatform.h"
 #include "debug.h"
@@ -46,10 +47,11 @@ static inline uint8_t calculate_brightness(uint8_t color, uint8_t brightness);
  *              ICLED board by copying the LED buffer to the DMA buffer.
  *
  * @param[in]   column: The starting column from which the LED buffer will be copied.
+ * @param[in]   fraction: Weight of the next column in 1/256, 0 copies the columns unchanged.
  *
  * @return      None
  */
-static void write_ledbuffer_to_DMAbuffer(uint16_t column = 0);
+static void write_ledbuffer_to_DMAbuffer(uint16_t column = 0, uint8_t fraction = 0);
 
 /**
  * @brief           This function ceils the sum of the color coordinates to
@@ -102,6 +104,8 @@ typedef union
 // buffer for LEDs --> will be written into dmaBuf after bit-expansion in
 static Pixel LEDBuf[ICLED_LED_COUNT * ICLED_SCREENSTORUN];
 
+#if ICLED_SPI_SYMBOL_BITS == 4
+
 #define ZEROPATTERN 0x8 // 4-bit
 #define ONEPATTERN 0xE  // 4-bit
 
@@ -110,6 +114,96 @@ static Pixel LEDBuf[ICLED_LED_COUNT * ICLED_SCREENSTORUN];
 #define ONEZEROPATTERN ((ONEPATTERN << 4) | ZEROPATTERN)   // 11101000
 #define ONEONEPATTERN ((ONEPATTERN << 4) | ONEPATTERN)     // 11101110
 
+#define T0H_SYMBOLS 1 // 1000
+#define T1H_SYMBOLS 3 // 1110
+
+#elif ICLED_SPI_SYMBOL_BITS == 3
+
+#define T0H_SYMBOLS 1 // 100
+#define T1H_SYMBOLS 2 // 110
+
+// Each color byte expands to 8 * 3 = 24 SPI bits (MSB first), '0' --> 100 and '1' --> 110
+static const uint8_t SYMBOL3_LUT[256][3] = {
+    {0x92, 0x49, 0x24}, {0x92, 0x49, 0x26}, {0x92, 0x49, 0x34}, {0x92, 0x49, 0x36},
+    {0x92, 0x49, 0xA4}, {0x92, 0x49, 0xA6}, {0x92, 0x49, 0xB4}, {0x92, 0x49, 0xB6},
+    {0x92, 0x4D, 0x24}, {0x92, 0x4D, 0x26}, {0x92, 0x4D, 0x34}, {0x92, 0x4D, 0x36},
+    {0x92, 0x4D, 0xA4}, {0x92, 0x4D, 0xA6}, {0x92, 0x4D, 0xB4}, {0x92, 0x4D, 0xB6},
+    {0x92, 0x69, 0x24}, {0x92, 0x69, 0x26}, {0x92, 0x69, 0x34}, {0x92, 0x69, 0x36},
+    {0x92, 0x69, 0xA4}, {0x92, 0x69, 0xA6}, {0x92, 0x69, 0xB4}, {0x92, 0x69, 0xB6},
+    {0x92, 0x6D, 0x24}, {0x92, 0x6D, 0x26}, {0x92, 0x6D, 0x34}, {0x92, 0x6D, 0x36},
+    {0x92, 0x6D, 0xA4}, {0x92, 0x6D, 0xA6}, {0x92, 0x6D, 0xB4}, {0x92, 0x6D, 0xB6},
+    {0x93, 0x49, 0x24}, {0x93, 0x49, 0x26}, {0x93, 0x49, 0x34}, {0x93, 0x49, 0x36},
+    {0x93, 0x49, 0xA4}, {0x93, 0x49, 0xA6}, {0x93, 0x49, 0xB4}, {0x93, 0x49, 0xB6},
+    {0x93, 0x4D, 0x24}, {0x93, 0x4D, 0x26}, {0x93, 0x4D, 0x34}, {0x93, 0x4D, 0x36},
+    {0x93, 0x4D, 0xA4}, {0x93, 0x4D, 0xA6}, {0x93, 0x4D, 0xB4}, {0x93, 0x4D, 0xB6},
+    {0x93, 0x69, 0x24}, {0x93, 0x69, 0x26}, {0x93, 0x69, 0x34}, {0x93, 0x69, 0x36},
+    {0x93, 0x69, 0xA4}, {0x93, 0x69, 0xA6}, {0x93, 0x69, 0xB4}, {0x93, 0x69, 0xB6},
+    {0x93, 0x6D, 0x24}, {0x93, 0x6D, 0x26}, {0x93, 0x6D, 0x34}, {0x93, 0x6D, 0x36},
+    {0x93, 0x6D, 0xA4}, {0x93, 0x6D, 0xA6}, {0x93, 0x6D, 0xB4}, {0x93, 0x6D, 0xB6},
+    {0x9A, 0x49, 0x24}, {0x9A, 0x49, 0x26}, {0x9A, 0x49, 0x34}, {0x9A, 0x49, 0x36},
+    {0x9A, 0x49, 0xA4}, {0x9A, 0x49, 0xA6}, {0x9A, 0x49, 0xB4}, {0x9A, 0x49, 0xB6},
+    {0x9A, 0x4D, 0x24}, {0x9A, 0x4D, 0x26}, {0x9A, 0x4D, 0x34}, {0x9A, 0x4D, 0x36},
+    {0x9A, 0x4D, 0xA4}, {0x9A, 0x4D, 0xA6}, {0x9A, 0x4D, 0xB4}, {0x9A, 0x4D, 0xB6},
+    {0x9A, 0x69, 0x24}, {0x9A, 0x69, 0x26}, {0x9A, 0x69, 0x34}, {0x9A, 0x69, 0x36},
+    {0x9A, 0x69, 0xA4}, {0x9A, 0x69, 0xA6}, {0x9A, 0x69, 0xB4}, {0x9A, 0x69, 0xB6},
+    {0x9A, 0x6D, 0x24}, {0x9A, 0x6D, 0x26}, {0x9A, 0x6D, 0x34}, {0x9A, 0x6D, 0x36},
+    {0x9A, 0x6D, 0xA4}, {0x9A, 0x6D, 0xA6}, {0x9A, 0x6D, 0xB4}, {0x9A, 0x6D, 0xB6},
+    {0x9B, 0x49, 0x24}, {0x9B, 0x49, 0x26}, {0x9B, 0x49, 0x34}, {0x9B, 0x49, 0x36},
+    {0x9B, 0x49, 0xA4}, {0x9B, 0x49, 0xA6}, {0x9B, 0x49, 0xB4}, {0x9B, 0x49, 0xB6},
+    {0x9B, 0x4D, 0x24}, {0x9B, 0x4D, 0x26}, {0x9B, 0x4D, 0x34}, {0x9B, 0x4D, 0x36},
+    {0x9B, 0x4D, 0xA4}, {0x9B, 0x4D, 0xA6}, {0x9B, 0x4D, 0xB4}, {0x9B, 0x4D, 0xB6},
+    {0x9B, 0x69, 0x24}, {0x9B, 0x69, 0x26}, {0x9B, 0x69, 0x34}, {0x9B, 0x69, 0x36},
+    {0x9B, 0x69, 0xA4}, {0x9B, 0x69, 0xA6}, {0x9B, 0x69, 0xB4}, {0x9B, 0x69, 0xB6},
+    {0x9B, 0x6D, 0x24}, {0x9B, 0x6D, 0x26}, {0x9B, 0x6D, 0x34}, {0x9B, 0x6D, 0x36},
+    {0x9B, 0x6D, 0xA4}, {0x9B, 0x6D, 0xA6}, {0x9B, 0x6D, 0xB4}, {0x9B, 0x6D, 0xB6},
+    {0xD2, 0x49, 0x24}, {0xD2, 0x49, 0x26}, {0xD2, 0x49, 0x34}, {0xD2, 0x49, 0x36},
+    {0xD2, 0x49, 0xA4}, {0xD2, 0x49, 0xA6}, {0xD2, 0x49, 0xB4}, {0xD2, 0x49, 0xB6},
+    {0xD2, 0x4D, 0x24}, {0xD2, 0x4D, 0x26}, {0xD2, 0x4D, 0x34}, {0xD2, 0x4D, 0x36},
+    {0xD2, 0x4D, 0xA4}, {0xD2, 0x4D, 0xA6}, {0xD2, 0x4D, 0xB4}, {0xD2, 0x4D, 0xB6},
+    {0xD2, 0x69, 0x24}, {0xD2, 0x69, 0x26}, {0xD2, 0x69, 0x34}, {0xD2, 0x69, 0x36},
+    {0xD2, 0x69, 0xA4}, {0xD2, 0x69, 0xA6}, {0xD2, 0x69, 0xB4}, {0xD2, 0x69, 0xB6},
+    {0xD2, 0x6D, 0x24}, {0xD2, 0x6D, 0x26}, {0xD2, 0x6D, 0x34}, {0xD2, 0x6D, 0x36},
+    {0xD2, 0x6D, 0xA4}, {0xD2, 0x6D, 0xA6}, {0xD2, 0x6D, 0xB4}, {0xD2, 0x6D, 0xB6},
+    {0xD3, 0x49, 0x24}, {0xD3, 0x49, 0x26}, {0xD3, 0x49, 0x34}, {0xD3, 0x49, 0x36},
+    {0xD3, 0x49, 0xA4}, {0xD3, 0x49, 0xA6}, {0xD3, 0x49, 0xB4}, {0xD3, 0x49, 0xB6},
+    {0xD3, 0x4D, 0x24}, {0xD3, 0x4D, 0x26}, {0xD3, 0x4D, 0x34}, {0xD3, 0x4D, 0x36},
+    {0xD3, 0x4D, 0xA4}, {0xD3, 0x4D, 0xA6}, {0xD3, 0x4D, 0xB4}, {0xD3, 0x4D, 0xB6},
+    {0xD3, 0x69, 0x24}, {0xD3, 0x69, 0x26}, {0xD3, 0x69, 0x34}, {0xD3, 0x69, 0x36},
+    {0xD3, 0x69, 0xA4}, {0xD3, 0x69, 0xA6}, {0xD3, 0x69, 0xB4}, {0xD3, 0x69, 0xB6},
+    {0xD3, 0x6D, 0x24}, {0xD3, 0x6D, 0x26}, {0xD3, 0x6D, 0x34}, {0xD3, 0x6D, 0x36},
+    {0xD3, 0x6D, 0xA4}, {0xD3, 0x6D, 0xA6}, {0xD3, 0x6D, 0xB4}, {0xD3, 0x6D, 0xB6},
+    {0xDA, 0x49, 0x24}, {0xDA, 0x49, 0x26}, {0xDA, 0x49, 0x34}, {0xDA, 0x49, 0x36},
+    {0xDA, 0x49, 0xA4}, {0xDA, 0x49, 0xA6}, {0xDA, 0x49, 0xB4}, {0xDA, 0x49, 0xB6},
+    {0xDA, 0x4D, 0x24}, {0xDA, 0x4D, 0x26}, {0xDA, 0x4D, 0x34}, {0xDA, 0x4D, 0x36},
+    {0xDA, 0x4D, 0xA4}, {0xDA, 0x4D, 0xA6}, {0xDA, 0x4D, 0xB4}, {0xDA, 0x4D, 0xB6},
+    {0xDA, 0x69, 0x24}, {0xDA, 0x69, 0x26}, {0xDA, 0x69, 0x34}, {0xDA, 0x69, 0x36},
+    {0xDA, 0x69, 0xA4}, {0xDA, 0x69, 0xA6}, {0xDA, 0x69, 0xB4}, {0xDA, 0x69, 0xB6},
+    {0xDA, 0x6D, 0x24}, {0xDA, 0x6D, 0x26}, {0xDA, 0x6D, 0x34}, {0xDA, 0x6D, 0x36},
+    {0xDA, 0x6D, 0xA4}, {0xDA, 0x6D, 0xA6}, {0xDA, 0x6D, 0xB4}, {0xDA, 0x6D, 0xB6},
+    {0xDB, 0x49, 0x24}, {0xDB, 0x49, 0x26}, {0xDB, 0x49, 0x34}, {0xDB, 0x49, 0x36},
+    {0xDB, 0x49, 0xA4}, {0xDB, 0x49, 0xA6}, {0xDB, 0x49, 0xB4}, {0xDB, 0x49, 0xB6},
+    {0xDB, 0x4D, 0x24}, {0xDB, 0x4D, 0x26}, {0xDB, 0x4D, 0x34}, {0xDB, 0x4D, 0x36},
+    {0xDB, 0x4D, 0xA4}, {0xDB, 0x4D, 0xA6}, {0xDB, 0x4D, 0xB4}, {0xDB, 0x4D, 0xB6},
+    {0xDB, 0x69, 0x24}, {0xDB, 0x69, 0x26}, {0xDB, 0x69, 0x34}, {0xDB, 0x69, 0x36},
+    {0xDB, 0x69, 0xA4}, {0xDB, 0x69, 0xA6}, {0xDB, 0x69, 0xB4}, {0xDB, 0x69, 0xB6},
+    {0xDB, 0x6D, 0x24}, {0xDB, 0x6D, 0x26}, {0xDB, 0x6D, 0x34}, {0xDB, 0x6D, 0x36},
+    {0xDB, 0x6D, 0xA4}, {0xDB, 0x6D, 0xA6}, {0xDB, 0x6D, 0xB4}, {0xDB, 0x6D, 0xB6},
+};
+
+#endif
+
+// Check the symbol timing against the ICLED data input with the SPI clock the SERCOM really generates
+#define SYMBOL_NS(count) ((uint32_t)(((uint64_t)(count) * 1000000000ULL) / ICLED_SPI_ACTUAL_CLOCK_HZ(ICLED_SPI_CLOCK_HZ)))
+
+static_assert((SYMBOL_NS(T0H_SYMBOLS) >= ICLED_T0H_MIN_NS) && (SYMBOL_NS(T0H_SYMBOLS) <= ICLED_T0H_MAX_NS),
+              "T0H of the SPI symbol is out of the ICLED timing window");
+static_assert((SYMBOL_NS(T1H_SYMBOLS) >= ICLED_T1H_MIN_NS) && (SYMBOL_NS(T1H_SYMBOLS) <= ICLED_T1H_MAX_NS),
+              "T1H of the SPI symbol is out of the ICLED timing window");
+static_assert((SYMBOL_NS(ICLED_SPI_SYMBOL_BITS) >= ICLED_BIT_PERIOD_MIN_NS) && (SYMBOL_NS(ICLED_SPI_SYMBOL_BITS) <= ICLED_BIT_PERIOD_MAX_NS),
+              "Bit period of the SPI symbol is out of the ICLED timing window");
+static_assert(SYMBOL_NS(ICLED_LATCHBYTECOUNT * 8) >= ICLED_LATCH_MIN_NS,
+              "ICLED_LATCHBYTECOUNT is too short for the latch");
+
 bool ICLED_Init(ICLED_Color_System color_system, ICLED_Orientation orientation)
 {
     SERCOM *sercomP;
@@ -173,7 +267,7 @@ bool ICLED_Init(ICLED_Color_System color_system, ICLED_Orientation orientation)
     dma.loop(true);
 
     spi->beginTransaction(
-        SPISettings(3200000, MSBFIRST, SPI_MODE0));
+        SPISettings(ICLED_SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0));
 
     if (dma.startJob() != DMA_STATUS_OK)
     {
@@ -254,17 +348,14 @@ static void HSV_to_RGB(float h, float s, float v, float *r, float *g, float *b)
     }
 }
 
-bool ICLED_set_pixel(uint16_t pixel_number, uint16_t R_H, uint16_t G_S, uint16_t B_V,
-                     uint8_t brightness, bool write_buffer)
+bool ICLED_make_color(ICLED_Color *color, uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness)
 {
-    // Check, if parameters are ok & write LEDBuf
-    if (pixel_number >= ICLED_LED_COUNT)
+    if (color == NULL)
     {
-        WE_DEBUG_PRINT("Pixel index %d is out of the first screen.\r\n", pixel_number);
+        WE_DEBUG_PRINT("color pointer is NULL.\r\n");
         return false;
     }
 
-    uint8_t R = 0, G = 0, B = 0;
     switch (ColorSystem)
     {
     case RGB:
@@ -297,15 +388,43 @@ bool ICLED_set_pixel(uint16_t pixel_number, uint16_t R_H, uint16_t G_S, uint16_t
         return false;
     }
 
-    R = calculate_brightness((uint8_t)R_H, brightness);
-    G = calculate_brightness((uint8_t)G_S, brightness);
-    B = calculate_brightness((uint8_t)B_V, brightness);
+    uint8_t R = calculate_brightness((uint8_t)R_H, brightness);
+    uint8_t G = calculate_brightness((uint8_t)G_S, brightness);
+    uint8_t B = calculate_brightness((uint8_t)B_V, brightness);
 
     ceil_brightness(&R, &G, &B); // checks PWM-levels for safety
 
-    LEDBuf[pixel_number].G = G;
-    LEDBuf[pixel_number].R = R;
-    LEDBuf[pixel_number].B = B;
+    color->R = R;
+    color->G = G;
+    color->B = B;
+
+    return true;
+}
+
+bool ICLED_set_pixel(uint16_t pixel_number, uint16_t R_H, uint16_t G_S, uint16_t B_V,
+                     uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_pixel(pixel_number, color, write_buffer);
+}
+
+bool ICLED_set_pixel(uint16_t pixel_number, ICLED_Color color, bool write_buffer)
+{
+    // Check, if parameters are ok & write LEDBuf
+    if (pixel_number >= ICLED_LED_COUNT)
+    {
+        WE_DEBUG_PRINT("Pixel index %d is out of the first screen.\r\n", pixel_number);
+        return false;
+    }
+
+    LEDBuf[pixel_number].G = color.G;
+    LEDBuf[pixel_number].R = color.R;
+    LEDBuf[pixel_number].B = color.B;
 
     if (write_buffer)
     {
@@ -320,8 +439,11 @@ static inline uint8_t calculate_brightness(uint8_t color, uint8_t brightness)
     return (uint8_t)(((uint16_t)color * (uint16_t)brightness) / ((uint16_t)255));
 }
 
-static void write_ledbuffer_to_DMAbuffer(uint16_t column)
+static void write_ledbuffer_to_DMAbuffer(uint16_t column, uint8_t fraction)
 {
+    // every column is blended with the same fraction, so both weights are computed once per frame
+    const uint16_t weight_next = fraction;
+    const uint16_t weight_this = ICLED_SCROLL_ONE_COLUMN - fraction;
 
     int offset;
     int offset_sign;
@@ -341,11 +463,21 @@ static void write_ledbuffer_to_DMAbuffer(uint16_t column)
 
     for (int i = 0; i < ICLED_LED_COUNT; i++)
     {
+        const Pixel *source = &LEDBuf[(offset + offset_sign * i) + (column * ICLED_ROWS)];
+
         for (uint8_t colorIdx = 0; colorIdx < 3; colorIdx++)
         {
+            uint8_t value = source->GBR[colorIdx];
+            if (fraction != 0)
+            {
+                // the same LED one column further on in the buffer
+                value = (uint8_t)((value * weight_this + source[ICLED_ROWS].GBR[colorIdx] * weight_next) >> 8);
+            }
+
+#if ICLED_SPI_SYMBOL_BITS == 4
             for (uint8_t bitIdx = 0; bitIdx < 4; bitIdx++)
             {
-                switch ((LEDBuf[(offset + offset_sign * i) + (column * ICLED_ROWS)].GBR[colorIdx] << (2 * bitIdx)) & 0xC0)
+                switch ((value << (2 * bitIdx)) & 0xC0)
                 { // mask upper two bit
                 case 0x00:
                     dmaBuf[4 * 3 * i + 4 * colorIdx + bitIdx] = ZEROZEROPATTERN;
@@ -361,6 +493,13 @@ static void write_ledbuffer_to_DMAbuffer(uint16_t column)
                     break;
                 }
             }
+#else
+            const uint8_t *symbols = SYMBOL3_LUT[value];
+            uint8_t *dst = &dmaBuf[3 * 3 * i + 3 * colorIdx];
+            dst[0] = symbols[0];
+            dst[1] = symbols[1];
+            dst[2] = symbols[2];
+#endif
         }
     }
 }
@@ -383,6 +522,17 @@ static void ceil_brightness(uint8_t *R, uint8_t *G, uint8_t *B)
 
 bool ICLED_set_screen_pixel(uint8_t row, uint8_t column, uint16_t R_H,
                             uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_screen_pixel(row, column, color, write_buffer);
+}
+
+bool ICLED_set_screen_pixel(uint8_t row, uint8_t column, ICLED_Color color, bool write_buffer)
 {
     if (column >= ICLED_COLUMNS && row >= ICLED_ROWS)
     {
@@ -391,63 +541,35 @@ bool ICLED_set_screen_pixel(uint8_t row, uint8_t column, uint16_t R_H,
     }
 
     // set corresponding pixel
-    return ICLED_set_pixel(column * ICLED_ROWS + row, R_H, G_S, B_V, brightness, write_buffer);
+    return ICLED_set_pixel(column * ICLED_ROWS + row, color, write_buffer);
 }
 
 bool ICLED_set_expanded_screen_pixel(uint8_t row, uint16_t column, uint16_t R_H,
                                      uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer)
 {
-    // Check, if parameters are ok & write LEDBuf
-    if (column >= (ICLED_COLUMNS * ICLED_SCREENSTORUN) || row >= ICLED_ROWS)
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
     {
-        WE_DEBUG_PRINT("the row should be between (0-%d) and the column should be between (0-%d).\r\n", ICLED_ROWS - 1, (ICLED_COLUMNS * ICLED_SCREENSTORUN) - 1);
         return false;
     }
 
-    uint8_t R = 0, G = 0, B = 0;
-    switch (ColorSystem)
-    {
-    case RGB:
-    {
-        if (R_H > 255 || G_S > 255 || B_V > 255)
-        {
-            WE_DEBUG_PRINT("RGB values should be between (0-255).\r\n");
-            return false;
-        }
-        break;
-    }
-    case HSV:
-    {
-        if (R_H > 360 || G_S > 100 || B_V > 100)
-        {
-            WE_DEBUG_PRINT("H should be between (0-360), S and V between (0-100).\r\n");
-            return false;
-        }
+    return ICLED_set_expanded_screen_pixel(row, column, color, write_buffer);
+}
 
-        // Convert HSV to RGB
-        float r = 0, g = 0, b = 0;
-        HSV_to_RGB((float)R_H / 360, (float)G_S / 100, (float)B_V / 100, &r, &g, &b);
-        R_H = (uint8_t)(r * 255);
-        G_S = (uint8_t)(g * 255);
-        B_V = (uint8_t)(b * 255);
-        break;
-    }
-    default:
-        WE_DEBUG_PRINT("Invalid color system.\r\n");
+bool ICLED_set_expanded_screen_pixel(uint8_t row, uint16_t column, ICLED_Color color, bool write_buffer)
+{
+    // Check, if parameters are ok & write LEDBuf
+    if (column >= (ICLED_COLUMNS * ICLED_SCREENSTORUN) || row >= ICLED_ROWS)
+    {
+        WE_DEBUG_PRINT("the row should be between (0-%d) and the column should be between (0-%d).\r\n", ICLED_ROWS - 1, (ICLED_COLUMNS * ICLED_SCREENSTORUN) - 1);
         return false;
     }
 
-    R = calculate_brightness((uint8_t)R_H, brightness);
-    G = calculate_brightness((uint8_t)G_S, brightness);
-    B = calculate_brightness((uint8_t)B_V, brightness);
-
-    ceil_brightness(&R, &G, &B); // checks PWM-levels for safety
-
     uint16_t pixel_number = column * ICLED_ROWS + row;
 
-    LEDBuf[pixel_number].G = G;
-    LEDBuf[pixel_number].R = R;
-    LEDBuf[pixel_number].B = B;
+    LEDBuf[pixel_number].G = color.G;
+    LEDBuf[pixel_number].R = color.R;
+    LEDBuf[pixel_number].B = color.B;
 
     if (write_buffer)
     {
@@ -458,13 +580,23 @@ bool ICLED_set_expanded_screen_pixel(uint8_t row, uint16_t column, uint16_t R_H,
 }
 
 bool ICLED_set_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_all_pixels(color, write_buffer);
+}
+
+bool ICLED_set_all_pixels(ICLED_Color color, bool write_buffer)
 {
     for (int i = 0; i < ICLED_LED_COUNT; i++)
     {
-        if (!ICLED_set_pixel(i, R_H, G_S, B_V, brightness, false))
-        {
-            return false;
-        }
+        LEDBuf[i].G = color.G;
+        LEDBuf[i].R = color.R;
+        LEDBuf[i].B = color.B;
     }
 
     if (write_buffer)
@@ -477,23 +609,23 @@ bool ICLED_set_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brig
 
 bool ICLED_set_expanded_screen_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer)
 {
-    for (int i = 0; i < ICLED_LED_COUNT; i++)
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
     {
-        if (!ICLED_set_pixel(i, R_H, G_S, B_V, brightness, false))
-        {
-            return false;
-        }
+        return false;
     }
 
-    for (uint16_t i = 0; i < ICLED_COLUMNS * ICLED_SCREENSTORUN; i++)
+    return ICLED_set_expanded_screen_all_pixels(color, write_buffer);
+}
+
+bool ICLED_set_expanded_screen_all_pixels(ICLED_Color color, bool write_buffer)
+{
+    // the first screen is part of the expanded screen
+    for (int i = 0; i < ICLED_LED_COUNT * ICLED_SCREENSTORUN; i++)
     {
-        for (uint16_t j = 0; j < ICLED_ROWS; j++)
-        {
-            if (!ICLED_set_expanded_screen_pixel(j, i, R_H, G_S, B_V, brightness, false))
-            {
-                return false;
-            }
-        }
+        LEDBuf[i].G = color.G;
+        LEDBuf[i].R = color.R;
+        LEDBuf[i].B = color.B;
     }
 
     if (write_buffer)
@@ -516,6 +648,17 @@ void ICLED_clear(bool write_buffer)
 
 bool ICLED_set_char(char c, uint16_t *place, uint16_t R_H, uint8_t G_S,
                     uint8_t B_V, uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_char(c, place, color, write_buffer);
+}
+
+bool ICLED_set_char(char c, uint16_t *place, ICLED_Color color, bool write_buffer)
 {
     if (place == NULL)
     {
@@ -531,7 +674,7 @@ bool ICLED_set_char(char c, uint16_t *place, uint16_t R_H, uint8_t G_S,
         return false; // be sure it's not out of bounds
     }
 
-    if (c > 127)
+    if ((uint8_t)c > 127)
     {
         WE_DEBUG_PRINT("The character is not ASCII 7 bit.\r\n");
         return false;
@@ -552,7 +695,7 @@ bool ICLED_set_char(char c, uint16_t *place, uint16_t R_H, uint8_t G_S,
     {
         if (!ICLED_set_expanded_screen_pixel(ASCII_CHARACTERS_ARRAY[index].pixel_locations[i].pixel_y,
                                              *place + ASCII_CHARACTERS_ARRAY[index].pixel_locations[i].pixel_x,
-                                             R_H, G_S, B_V, brightness, false))
+                                             color, false))
         {
             return false;
         }
@@ -571,6 +714,17 @@ bool ICLED_set_char(char c, uint16_t *place, uint16_t R_H, uint8_t G_S,
 
 bool ICLED_set_emoji(Emoji emoji, uint16_t *place, uint16_t R_H, uint8_t G_S,
                      uint8_t B_V, uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_emoji(emoji, place, color, write_buffer);
+}
+
+bool ICLED_set_emoji(Emoji emoji, uint16_t *place, ICLED_Color color, bool write_buffer)
 {
     if (place == NULL)
     {
@@ -598,7 +752,7 @@ bool ICLED_set_emoji(Emoji emoji, uint16_t *place, uint16_t R_H, uint8_t G_S,
     {
         if (!ICLED_set_expanded_screen_pixel(EMOJI_ARRAY[index].pixel_locations[i].pixel_y,
                                              *place + EMOJI_ARRAY[index].pixel_locations[i].pixel_x,
-                                             R_H, G_S, B_V, brightness, false))
+                                             color, false))
         {
             return false;
         }
@@ -618,29 +772,67 @@ bool ICLED_set_emoji(Emoji emoji, uint16_t *place, uint16_t R_H, uint8_t G_S,
 bool ICLED_set_euro(uint16_t *place, uint16_t R_H, uint8_t G_S,
                     uint8_t B_V, uint8_t brightness, bool write_buffer)
 {
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_euro(place, color, write_buffer);
+}
+
+bool ICLED_set_euro(uint16_t *place, ICLED_Color color, bool write_buffer)
+{
+    return ICLED_set_codepoint(0x20AC, place, color, write_buffer);
+}
+
+bool ICLED_set_codepoint(uint32_t codepoint, uint16_t *place, uint16_t R_H, uint8_t G_S,
+                         uint8_t B_V, uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_codepoint(codepoint, place, color, write_buffer);
+}
+
+bool ICLED_set_codepoint(uint32_t codepoint, uint16_t *place, ICLED_Color color, bool write_buffer)
+{
+    if (codepoint < 128)
+    {
+        return ICLED_set_char((char)codepoint, place, color, write_buffer);
+    }
+
     if (place == NULL)
     {
         WE_DEBUG_PRINT("place pointer is NULL.\r\n");
         return false;
     }
 
-    // starts with left column, sets all necessary pixels and increments place
-    // for next collumn
-    if (*place > (ICLED_SCREENSTORUN * ICLED_COLUMNS) - MAX_CHARACTER_WIDTH)
+    const UTF8_Glyph *glyph = UTF8_find_glyph(codepoint);
+    if (glyph == NULL)
     {
-        WE_DEBUG_PRINT("The euro sign will not fit in the LED buffer.\r\n");
-        return false; // be sure it's not out of bounds
+        WE_DEBUG_PRINT("The character U+%04lX doesn't have pixel representation in table.\r\n", (unsigned long)codepoint);
+        return false;
     }
 
-    uint8_t euro_sign[][2] = {{0, 4}, {0, 2}, {1, 4}, {1, 3}, {1, 2}, {2, 1}, {2, 2}, {2, 4}, {2, 5}, {3, 0}, {3, 2}, {3, 4}, {3, 6}, {4, 0}, {4, 2}, {4, 4}, {4, 6}};
+    if (*place > (ICLED_SCREENSTORUN * ICLED_COLUMNS) - glyph->symbol_width)
+    {
+        WE_DEBUG_PRINT("The character will not fit in the LED buffer.\r\n");
+        return false; // be sure it's not out of bounds
+    }
 
-    for (uint8_t i = 0; i < (sizeof(euro_sign) / (2 * sizeof(uint8_t))); i++)
+    for (uint8_t x = 0; x < glyph->symbol_width; x++)
     {
-        if (!ICLED_set_expanded_screen_pixel(euro_sign[i][1],
-                                             *place + euro_sign[i][0],
-                                             R_H, G_S, B_V, brightness, false))
+        for (uint8_t y = 0; y < ICLED_ROWS; y++)
         {
-            return false;
+            if ((glyph->columns[x] & (1 << y)) &&
+                !ICLED_set_expanded_screen_pixel(y, *place + x, color, false))
+            {
+                return false;
+            }
         }
     }
 
@@ -649,13 +841,24 @@ bool ICLED_set_euro(uint16_t *place, uint16_t R_H, uint8_t G_S,
         write_ledbuffer_to_DMAbuffer();
     }
 
-    *place = *place + 6;
+    *place = *place + glyph->symbol_width + 1;
 
     return true;
 }
 
 bool ICLED_set_string(char c[], uint16_t *place, uint16_t R_H,
                       uint8_t G_S, uint8_t B_V, uint8_t brightness, bool write_buffer)
+{
+    ICLED_Color color;
+    if (!ICLED_make_color(&color, R_H, G_S, B_V, brightness))
+    {
+        return false;
+    }
+
+    return ICLED_set_string(c, place, color, write_buffer);
+}
+
+bool ICLED_set_string(char c[], uint16_t *place, ICLED_Color color, bool write_buffer)
 {
     if ((c == NULL) || (place == NULL))
     {
@@ -663,13 +866,23 @@ bool ICLED_set_string(char c[], uint16_t *place, uint16_t R_H,
         return false;
     }
 
-    // place all characters in row in expanded buffer
-    for (uint16_t cnum = 0; cnum < (uint16_t)strlen(c); cnum++)
+    // place all characters in row in expanded buffer, multi-byte UTF-8 sequences use the glyph index
+    uint16_t cnum = 0;
+    while (c[cnum] != '\0')
     {
-        if (!ICLED_set_char(c[cnum], place, R_H, G_S, B_V, brightness, false))
+        uint32_t codepoint;
+        uint8_t length = UTF8_decode(&c[cnum], &codepoint);
+        if (length == 0)
         {
+            WE_DEBUG_PRINT("Invalid UTF-8 sequence at byte %d.\r\n", cnum);
             return false;
         }
+
+        if (!ICLED_set_codepoint(codepoint, place, color, false))
+        {
+            return false;
+        }
+        cnum += length;
     }
 
     if (write_buffer)
@@ -696,9 +909,30 @@ bool ICLED_set_start_column(uint16_t column, bool write_buffer)
     return true;
 }
 
-bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint16_t *current_columnP, bool *running)
+bool ICLED_set_start_position(uint32_t position, bool write_buffer)
+{
+    uint32_t column = position / ICLED_SCROLL_ONE_COLUMN;
+    uint8_t fraction = (uint8_t)(position % ICLED_SCROLL_ONE_COLUMN);
+
+    // a fraction blends in the next column, which has to be in the buffer as well
+    if ((column > ((ICLED_COLUMNS * (ICLED_SCREENSTORUN - 1)))) ||
+        ((column == ((ICLED_COLUMNS * (ICLED_SCREENSTORUN - 1)))) && (fraction != 0)))
+    {
+        WE_DEBUG_PRINT("The position should be between (0-%d).\r\n", ((ICLED_COLUMNS * (ICLED_SCREENSTORUN - 1))) * ICLED_SCROLL_ONE_COLUMN);
+        return false;
+    }
+
+    if (write_buffer)
+    {
+        write_ledbuffer_to_DMAbuffer((uint16_t)column, fraction);
+    }
+
+    return true;
+}
+
+bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint16_t *current_columnP, bool *running, uint16_t step)
 {
-    uint16_t current_column = 0;
+    uint32_t position = 0; // Q8, relative to start_column
 
     if (current_columnP)
     {
@@ -710,7 +944,7 @@ bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, ui
         }
         else
         {
-            current_column = *current_columnP - start_column;
+            position = (uint32_t)(*current_columnP - start_column) * ICLED_SCROLL_ONE_COLUMN;
         }
     }
 
@@ -731,27 +965,36 @@ bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, ui
         return false;
     }
 
+    if (step == 0)
+    {
+        WE_DEBUG_PRINT("The step can't be 0.\r\n");
+        return false;
+    }
+
+    // after end_column the animation starts over at start_column
+    const uint32_t last = (uint32_t)(end_column - start_column) * ICLED_SCROLL_ONE_COLUMN;
+
     while ((running == NULL) || *running)
     {
-        if (!ICLED_set_start_column(current_column + start_column))
+        if (!ICLED_set_start_position(position + (uint32_t)start_column * ICLED_SCROLL_ONE_COLUMN))
         {
             return false;
         }
-        current_column = ((current_column + 1) % (end_column - start_column + 1));
+        position = (position + step > last) ? 0 : position + step;
         WE_Delay(delay);
     }
 
     if (current_columnP)
     {
-        *current_columnP = current_column + start_column;
+        *current_columnP = (uint16_t)(position / ICLED_SCROLL_ONE_COLUMN) + start_column;
     }
 
     return true;
 }
 
-bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t duration)
+bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t duration, uint16_t step)
 {
-    uint16_t current_column = 0;
+    uint32_t position = 0; // Q8, relative to start_column
 
     if (start_column >= end_column)
     {
@@ -777,13 +1020,21 @@ bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t
         return false;
     }
 
+    if (step == 0)
+    {
+        WE_DEBUG_PRINT("The step can't be 0.\r\n");
+        return false;
+    }
+
+    const uint32_t last = (uint32_t)(end_column - start_column) * ICLED_SCROLL_ONE_COLUMN;
+
     while (duration > delay)
     {
-        if (!ICLED_set_start_column(current_column + start_column))
+        if (!ICLED_set_start_position(position + (uint32_t)start_column * ICLED_SCROLL_ONE_COLUMN))
         {
             return false;
         }
-        current_column = ((current_column + 1) % (end_column - start_column + 1));
+        position = (position + step > last) ? 0 : position + step;
         WE_Delay(delay);
         duration -= delay;
     }
@@ -791,7 +1042,15 @@ bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t
     return true;
 }
 
-bool ICLED_start_iteration_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t iterations)
+bool ICLED_start_iteration_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t iterations, uint16_t step)
 {
-    return ICLED_start_timed_loop(start_column, end_column, delay, iterations * delay * (end_column - start_column + 1));
+    // positions from start_column to end_column in steps of step, both ends included,
+    // invalid arguments are reported by ICLED_start_timed_loop
+    uint32_t steps = 1;
+    if ((start_column < end_column) && (step != 0))
+    {
+        steps = ((uint32_t)(end_column - start_column) * ICLED_SCROLL_ONE_COLUMN) / step + 1;
+    }
+
+    return ICLED_start_timed_loop(start_column, end_column, delay, iterations * delay * steps, step);
 }
@@ -40,13 +40,55 @@
 // set to 1 if no scrolling texts wanted --> saves RAM
 #define ICLED_BYTESPERPIXEL 3 // GRB , each is 8bit = 1 Byte
 
+// Scroll positions are Q8 fixed point columns: column * ICLED_SCROLL_ONE_COLUMN + fraction (0-255).
+// A position between two columns shows a blend of both, so a scroll can move by fractions of a column.
+#define ICLED_SCROLL_ONE_COLUMN 256
+
+// Every LED data bit is sent as one SPI symbol of ICLED_SPI_SYMBOL_BITS bits:
+//   4: 1000 / 1110 at 3.2 MHz (default)
+//   3: 100 / 110 at 2.4 MHz, 25% less DMA buffer and transfer time per frame
+// Select the 3-bit mode with -D ICLED_SPI_SYMBOL_BITS=3 in the build flags.
+#ifndef ICLED_SPI_SYMBOL_BITS
+#define ICLED_SPI_SYMBOL_BITS 4
+#endif
+
+// The SERCOM divides its 48 MHz reference by 2 * (BAUD + 1) with BAUD = 48 MHz / (2 * f) - 1 (integer division).
+// A requested 3.2 MHz therefore ends up at 3.4286 MHz, which matches the measured 3.4299 MHz,
+// while 2.4 MHz is reached exactly.
+#define ICLED_SERCOM_REF_CLOCK_HZ 48000000UL
+#define ICLED_SPI_ACTUAL_CLOCK_HZ(f) (ICLED_SERCOM_REF_CLOCK_HZ / (2 * (ICLED_SERCOM_REF_CLOCK_HZ / (2 * (f)))))
+
+#if ICLED_SPI_SYMBOL_BITS == 4
+
+#define ICLED_SPI_CLOCK_HZ 3200000UL
+
 // If the SPI clock was accurate we would only need 80 bytes since 80 * 8 * 0.3125 = 200 Microsecond
 // but since the SPI clock was measured at 3.4299 Mhz we need to increase the number of bytes to 100 so that 100 *
 // 100 * 8 * 0.29155 = 233 Microsecond which is still more than the minimum latch
 
 #define ICLED_LATCHBYTECOUNT 100 // 100 * 8 * 0.29155 ~= 233 Microsecond latch
 
-#define ICLED_BYTESTOTAL (ICLED_LED_COUNT * ICLED_BYTESPERPIXEL * 4) + ICLED_LATCHBYTECOUNT
+#elif ICLED_SPI_SYMBOL_BITS == 3
+
+#define ICLED_SPI_CLOCK_HZ 2400000UL
+
+#define ICLED_LATCHBYTECOUNT 70 // 70 * 8 * 0.41667 ~= 233 Microsecond latch
+
+#else
+#error "ICLED_SPI_SYMBOL_BITS must be 3 or 4"
+#endif
+
+// Timing window of the ICLED data input the SPI symbols have to hit (nanoseconds)
+#define ICLED_T0H_MIN_NS 200
+#define ICLED_T0H_MAX_NS 500
+#define ICLED_T1H_MIN_NS 550
+#define ICLED_T1H_MAX_NS 1000
+#define ICLED_BIT_PERIOD_MIN_NS 1000
+#define ICLED_BIT_PERIOD_MAX_NS 1600
+#define ICLED_LATCH_MIN_NS 200000
+
+// one SPI byte per symbol bit for every color byte
+#define ICLED_BYTESTOTAL (ICLED_LED_COUNT * ICLED_BYTESPERPIXEL * ICLED_SPI_SYMBOL_BITS) + ICLED_LATCHBYTECOUNT
 
 #define ICLED_MAX_BRIGHTNESS \
     210 // Max Brightness of all 3 colors summed up ; do only change if you
@@ -79,6 +121,14 @@ typedef enum
     Emoji_Total_Count
 } Emoji;
 
+// Color with brightness and PWM ceiling already applied, create it with ICLED_make_color
+typedef struct
+{
+    uint8_t R;
+    uint8_t G;
+    uint8_t B;
+} ICLED_Color;
+
 /**
  * @brief       Intialize the interfaces for ICLEDFeatherWing.
  *
@@ -96,6 +146,22 @@ bool ICLED_Init(ICLED_Color_System color_system = RGB, ICLED_Orientation orienta
  */
 bool ICLED_Deinit();
 
+/**
+ * @brief       Create a color handle that can be passed to the drawing functions.
+ *
+ *              Validation, the HSV conversion (using the current color system), the brightness and the
+ *              PWM ceiling are done once here instead of for every pixel that is drawn.
+ *
+ * @param[out]  color: The color handle.
+ * @param[in]   R_H: R/H-coordinate of color.
+ * @param[in]   G_S: G/S-coordinate of color.
+ * @param[in]   B_V: B/V-coordinate of color.
+ * @param[in]   brightness: Brightness.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_make_color(ICLED_Color *color, uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness);
+
 /**
  * @brief       Set a pixel in the first screen using its index to the given color with the given brightness.
  *
@@ -111,6 +177,17 @@ bool ICLED_Deinit();
 bool ICLED_set_pixel(uint16_t pixel_number, uint16_t R_H, uint16_t G_S,
                      uint16_t B_V, uint8_t brightness, bool write_buffer = true); // sets pixel on given color
 
+/**
+ * @brief       Set a pixel in the first screen using its index to the given color.
+ *
+ * @param[in]   pixel_number: Index of the pixel.
+ * @param[in]   color: Color handle. See ICLED_make_color.
+ * @param[in]   write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_set_pixel(uint16_t pixel_number, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief       Set a pixel in the first screen using its coordinates to the given color with the given brightness.
  *
@@ -127,6 +204,18 @@ bool ICLED_set_pixel(uint16_t pixel_number, uint16_t R_H, uint16_t G_S,
 bool ICLED_set_screen_pixel(uint8_t row, uint8_t column, uint16_t R_H,
                             uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief       Set a pixel in the first screen using its coordinates to the given color.
+ *
+ * @param[in]   row: Row of the pixel.
+ * @param[in]   column: Column of the pixel.
+ * @param[in]   color: Color handle. See ICLED_make_color.
+ * @param[in]   write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_set_screen_pixel(uint8_t row, uint8_t column, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief       Set a pixel using its coordinates to any of the screens (useful for animations)
  *              to the given color with the given brightness.
@@ -144,6 +233,18 @@ bool ICLED_set_screen_pixel(uint8_t row, uint8_t column, uint16_t R_H,
 bool ICLED_set_expanded_screen_pixel(uint8_t row, uint16_t column, uint16_t R_H,
                                      uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief       Set a pixel using its coordinates to any of the screens to the given color.
+ *
+ * @param[in]   row: Row of the pixel.
+ * @param[in]   column: Column of the pixel.
+ * @param[in]   color: Color handle. See ICLED_make_color.
+ * @param[in]   write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_set_expanded_screen_pixel(uint8_t row, uint16_t column, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief       Set all pixels in the first screen to the given color with the given brightness.
  *
@@ -159,6 +260,16 @@ bool ICLED_set_expanded_screen_pixel(uint8_t row, uint16_t column, uint16_t R_H,
  */
 bool ICLED_set_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief       Set all pixels in the first screen to the given color.
+ *
+ * @param[in]   color: Color handle. See ICLED_make_color.
+ * @param[in]   write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_set_all_pixels(ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief       Set all pixels in all screens to the given color with the given brightness.
  *
@@ -172,6 +283,16 @@ bool ICLED_set_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brig
  */
 bool ICLED_set_expanded_screen_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief       Set all pixels in all screens to the given color.
+ *
+ * @param[in]   color: Color handle. See ICLED_make_color.
+ * @param[in]   write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_set_expanded_screen_all_pixels(ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief           Set a specific ASCII (7 bit) character at a certain column.
  *
@@ -188,6 +309,18 @@ bool ICLED_set_expanded_screen_all_pixels(uint16_t R_H, uint16_t G_S, uint16_t B
 bool ICLED_set_char(char c, uint16_t *place, uint16_t R_H, uint8_t G_S,
                     uint8_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief           Set a specific ASCII (7 bit) character at a certain column.
+ *
+ * @param[in]       c: The ASCII (7 bit) character.
+ * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
+ * @param[in]       color: Color handle. See ICLED_make_color.
+ * @param[in]       write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return          True if successful, false otherwise.
+ */
+bool ICLED_set_char(char c, uint16_t *place, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief           Set an emonji at a certain column.
  *
@@ -204,10 +337,50 @@ bool ICLED_set_char(char c, uint16_t *place, uint16_t R_H, uint8_t G_S,
 bool ICLED_set_emoji(Emoji emoji, uint16_t *place, uint16_t R_H, uint8_t G_S,
                      uint8_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief           Set an emoji at a certain column.
+ *
+ * @param[in]       emoji: The emoji. See Emoji.
+ * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
+ * @param[in]       color: Color handle. See ICLED_make_color.
+ * @param[in]       write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return          True if successful, false otherwise.
+ */
+bool ICLED_set_emoji(Emoji emoji, uint16_t *place, ICLED_Color color, bool write_buffer = true);
+
+/**
+ * @brief           Set a character beyond 7-bit ASCII (e.g. umlauts, currency signs, arrows) at a certain column.
+ *
+ * @param[in]       codepoint: The Unicode codepoint. Codepoints below 128 use the ASCII table.
+ * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
+ * @param[in]       R_H: R/H-coordinate of color.
+ * @param[in]       G_S: G/S-coordinate of color.
+ * @param[in]       B_V: B/V-coordinate of color.
+ * @param[in]       brightness: Brightness.
+ * @param[in]       write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return          True if successful, false otherwise (also if the codepoint has no glyph).
+ */
+bool ICLED_set_codepoint(uint32_t codepoint, uint16_t *place, uint16_t R_H, uint8_t G_S,
+                         uint8_t B_V, uint8_t brightness, bool write_buffer = true);
+
+/**
+ * @brief           Set a character beyond 7-bit ASCII (e.g. umlauts, currency signs, arrows) at a certain column.
+ *
+ * @param[in]       codepoint: The Unicode codepoint. Codepoints below 128 use the ASCII table.
+ * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
+ * @param[in]       color: Color handle. See ICLED_make_color.
+ * @param[in]       write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return          True if successful, false otherwise (also if the codepoint has no glyph).
+ */
+bool ICLED_set_codepoint(uint32_t codepoint, uint16_t *place, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief           Set a string at a certain column.
  *
- * @param[in]       c: The string (character array).
+ * @param[in]       c: The UTF-8 encoded string (character array).
  * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
  * @param[in]       R_H: R/H-coordinate of color.
  * @param[in]       G_S: G/S-coordinate of color.
@@ -220,6 +393,18 @@ bool ICLED_set_emoji(Emoji emoji, uint16_t *place, uint16_t R_H, uint8_t G_S,
 bool ICLED_set_string(char c[], uint16_t *place, uint16_t R_H,
                       uint8_t G_S, uint8_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief           Set a string at a certain column.
+ *
+ * @param[in]       c: The UTF-8 encoded string (character array).
+ * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
+ * @param[in]       color: Color handle. See ICLED_make_color.
+ * @param[in]       write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return          True if successful, false otherwise.
+ */
+bool ICLED_set_string(char c[], uint16_t *place, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief           Set a euro sign at a certain column.
  *
@@ -235,6 +420,17 @@ bool ICLED_set_string(char c[], uint16_t *place, uint16_t R_H,
 bool ICLED_set_euro(uint16_t *place, uint16_t R_H, uint8_t G_S,
                     uint8_t B_V, uint8_t brightness, bool write_buffer = true);
 
+/**
+ * @brief           Set a euro sign at a certain column.
+ *
+ * @param[in,out]   place: Pointer to the column where to place the character, this value will be updated with the value after the character was set.
+ * @param[in]       color: Color handle. See ICLED_make_color.
+ * @param[in]       write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return          True if successful, false otherwise.
+ */
+bool ICLED_set_euro(uint16_t *place, ICLED_Color color, bool write_buffer = true);
+
 /**
  * @brief       Set the left most column of the screen (can be used for animations).
  *
@@ -245,6 +441,19 @@ bool ICLED_set_euro(uint16_t *place, uint16_t R_H, uint8_t G_S,
  */
 bool ICLED_set_start_column(uint16_t column, bool write_buffer = true);
 
+/**
+ * @brief       Set the left most position of the screen in fractions of a column (can be used for smooth animations).
+ *
+ *              Each LED shows its column and the next one blended with the fraction as weight (8 bit fixed point),
+ *              the two weights are the same for the whole screen.
+ *
+ * @param[in]   position: The left most position in Q8, see ICLED_SCROLL_ONE_COLUMN.
+ * @param[in]   write_buffer: Optional argument that indicates whether the LED buffer should be applied to the LED screen. Defaults to true.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool ICLED_set_start_position(uint32_t position, bool write_buffer = true);
+
 /**
  * @brief       Set the color system to be used, this will be applied
  *              for the following calls to set_pixel and similar functions.
@@ -299,10 +508,14 @@ void ICLED_clear(bool write_buffer = true);
  *                  this can be used to resume the animation from where it was stopped.
  * @param[in]       running: Optional argument that is a pointer to a boolean that determintes
  *                  if the animation continues or stops, if not passed the animation will loop forever.
+ * @param[in]       step: Optional argument, the distance moved after each delay in Q8 (see ICLED_SCROLL_ONE_COLUMN).
+ *                  Defaults to one column, e.g. ICLED_SCROLL_ONE_COLUMN / 4 with a quarter of the delay moves
+ *                  at the same speed but smoothly. current_columnP is rounded down to whole columns.
  *
  * @return          True if successful, false otherwise.
  */
-bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint16_t *current_columnP = NULL, bool *running = NULL);
+bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint16_t *current_columnP = NULL, bool *running = NULL,
+                                  uint16_t step = ICLED_SCROLL_ONE_COLUMN);
 
 /**
  * @brief           Start a looping animation that lasts for a certain duration.
@@ -311,10 +524,12 @@ bool ICLED_start_conditional_loop(uint16_t start_column, uint16_t end_column, ui
  * @param[in]       end_column: The last column to end the animation on.
  * @param[in]       delay: The delay in milliseconds between each column, it controls the speed of the animation.
  * @param[in]       duration: The duration in milliseconds that the animation should run for.
+ * @param[in]       step: Optional argument, the distance moved after each delay in Q8 (see ICLED_SCROLL_ONE_COLUMN).
  *
  * @return          True if successful, false otherwise.
  */
-bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t duration);
+bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t duration,
+                            uint16_t step = ICLED_SCROLL_ONE_COLUMN);
 
 /**
  * @brief           Start a looping animation that runs for a number of iterations.
@@ -323,9 +538,11 @@ bool ICLED_start_timed_loop(uint16_t start_column, uint16_t end_column, uint32_t
  * @param[in]       end_column: The last column to end the animation on.
  * @param[in]       delay: The delay in milliseconds between each column, it controls the speed of the animation.
  * @param[in]       iterations: The amount of times the animation should run for.
+ * @param[in]       step: Optional argument, the distance moved after each delay in Q8 (see ICLED_SCROLL_ONE_COLUMN).
  *
  * @return          True if successful, false otherwise.
  */
-bool ICLED_start_iteration_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t iterations);
+bool ICLED_start_iteration_loop(uint16_t start_column, uint16_t end_column, uint32_t delay, uint32_t iterations,
+                                uint16_t step = ICLED_SCROLL_ONE_COLUMN);
 
 #endif
@@ -34,6 +34,68 @@ static uint16_t ble_data_current_column = 0;
 static uint16_t prices_current_column = 0;
 static uint16_t show_current_column = 0;
 
+/**
+ * @brief       Convert a sensor value to a fixed-point value with one decimal place.
+ *
+ * @param[in]   value: Sensor value.
+ *
+ * @return      The value in tenths, rounded to the nearest tenth (e.g. 23.46 --> 235).
+ */
+static int32_t to_tenths(float value)
+{
+    return (int32_t)(value * 10.0f + ((value < 0) ? -0.5f : 0.5f));
+}
+
+/**
+ * @brief       Format a fixed-point value with one decimal place without pulling in the float printf.
+ *
+ * @param[out]  string: Output buffer, must hold prefix, suffix and up to 13 characters for the value.
+ * @param[in]   prefix: Text in front of the value.
+ * @param[in]   value_tenths: Value in tenths (e.g. -235 --> "-23.5").
+ * @param[in]   suffix: Text after the value.
+ *
+ * @return      None
+ */
+static void format_tenths(char *string, const char *prefix, int32_t value_tenths, const char *suffix)
+{
+    char digits[10];
+    uint8_t digit_count = 0;
+    uint32_t magnitude = (value_tenths < 0) ? (0u - (uint32_t)value_tenths) : (uint32_t)value_tenths;
+
+    while (*prefix)
+    {
+        *string++ = *prefix++;
+    }
+
+    if (value_tenths < 0)
+    {
+        *string++ = '-';
+    }
+
+    // integer part, least significant digit first
+    uint32_t integer_part = magnitude / 10;
+    do
+    {
+        digits[digit_count++] = (char)('0' + (integer_part % 10));
+        integer_part /= 10;
+    } while (integer_part > 0);
+
+    while (digit_count > 0)
+    {
+        *string++ = digits[--digit_count];
+    }
+
+    *string++ = '.';
+    *string++ = (char)('0' + (magnitude % 10));
+
+    while (*suffix)
+    {
+        *string++ = *suffix++;
+    }
+
+    *string = '\0';
+}
+
 bool ICLED_demo_send_alphabet(uint16_t R_H, uint16_t G_S, uint16_t B_V, uint8_t brightness, uint32_t delay, bool *running)
 {
     uint16_t place = ICLED_COLUMNS;
@@ -193,40 +255,43 @@ bool ICLED_demo_show_temp_sensor_data(float temperature, uint8_t brightness, uin
 
     char string[32];
 
-    sprintf(string, "T:%.1f", temperature);
+    // temperature in 0.1 degree steps, everything below is integer only
+    int32_t temp_tenths = to_tenths(temperature);
+
+    format_tenths(string, "T:", temp_tenths, "");
 
     uint16_t R_H, G_S, B_V;
 
     // choose color depending on temperature
-    if (temperature <= -20)
+    if (temp_tenths <= -200)
     {
         R_H = 0;
         G_S = 0;
         B_V = 50;
     }
-    else if (temperature >= 50)
+    else if (temp_tenths >= 500)
     {
         R_H = 50;
         G_S = 0;
         B_V = 0;
     }
-    else if (temperature < 20)
+    else if (temp_tenths < 200)
     {
-        R_H = (uint8_t)1.25 * (temperature + 20);
-        G_S = (uint8_t)1.25 * (temperature + 20);
+        R_H = (uint16_t)((temp_tenths + 200) / 8); // 1.25 * (T + 20)
+        G_S = (uint16_t)((temp_tenths + 200) / 8);
         B_V = 50;
     }
-    else if (temperature > 30)
+    else if (temp_tenths > 300)
     {
         R_H = 50;
-        G_S = (uint8_t)2.5 * (50 - temperature);
+        G_S = (uint16_t)((500 - temp_tenths) / 4); // 2.5 * (50 - T)
         B_V = 0;
     }
-    else if (temperature > 20)
+    else if (temp_tenths > 200)
     {
         R_H = 50;
         G_S = 50;
-        B_V = (uint8_t)5 * (30 - temperature);
+        B_V = (uint16_t)((300 - temp_tenths) / 2); // 5 * (30 - T)
     }
     else
     {
@@ -266,45 +331,48 @@ bool ICLED_demo_show_hum_sensor_data(float humidity, uint8_t brightness, uint32_
 
     char string[32];
 
-    sprintf(string, "H:%.1f%%", humidity);
+    // humidity in 0.1 % steps, everything below is integer only
+    int32_t hum_tenths = to_tenths(humidity);
+
+    format_tenths(string, "H:", hum_tenths, "%");
 
     uint16_t R_H, G_S, B_V;
 
-    if (humidity <= 20)
+    if (hum_tenths <= 200)
     {
         R_H = 50;
         G_S = 0;
         B_V = 0;
     }
-    else if (humidity >= 80)
+    else if (hum_tenths >= 800)
     {
         R_H = 0;
         G_S = 0;
         B_V = 50;
     }
-    else if (humidity >= 60)
+    else if (hum_tenths >= 600)
     {
         R_H = 0;
-        G_S = (uint8_t)(50 - 2.5 * (humidity - 60));
+        G_S = (uint16_t)(50 - (hum_tenths - 600) / 4); // 50 - 2.5 * (H - 60)
         B_V = 50;
     }
-    else if (humidity > 50)
+    else if (hum_tenths > 500)
     {
-        R_H = (uint8_t)(50 - 5 * (humidity - 40));
+        R_H = (uint16_t)((600 - hum_tenths) / 2); // 50 - 5 * (H - 50)
         G_S = 50;
         B_V = 50;
     }
-    else if (humidity <= 40)
+    else if (hum_tenths <= 400)
     {
         R_H = 50;
-        G_S = (uint8_t)(2.5 * (humidity - 20));
+        G_S = (uint16_t)((hum_tenths - 200) / 4); // 2.5 * (H - 20)
         B_V = 0;
     }
-    else if (humidity < 50)
+    else if (hum_tenths < 500)
     {
         R_H = 50;
         G_S = 50;
-        B_V = (uint8_t)(5 * (humidity - 40));
+        B_V = (uint16_t)((hum_tenths - 400) / 2); // 5 * (H - 40)
     }
     else
     {
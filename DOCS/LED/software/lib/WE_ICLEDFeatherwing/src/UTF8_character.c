@@ -0,0 +1,146 @@
+/**
+***************************************************************************************************
+* This file is part of ICLED SDK:
+*
+*
+* THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE THAT WÜRTH ELEKTRONIK
+* EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY KIND RELATED TO, BUT NOT LIMITED
+* TO THE NON-INFRINGEMENT OF THIRD PARTIES’ INTELLECTUAL PROPERTY RIGHTS OR THE
+* MERCHANTABILITY OR FITNESS FOR YOUR INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT
+* WARRANT OR REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY PATENT
+* RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY RIGHT RELATING TO ANY
+* COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT IS USED. INFORMATION PUBLISHED BY
+* WÜRTH ELEKTRONIK EISOS REGARDING THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE
+* FROM WÜRTH ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR ENDORSEMENT
+* THEREOF
+*
+* THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+* FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+* IN THE ROOT DIRECTORY OF THIS DRIVER PACKAGE.
+*
+* COPYRIGHT (c) 2024 Würth Elektronik eiSos GmbH & Co. KG
+*
+***************************************************************************************************
+**/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "UTF8_character.h"
+
+/*
+ * Sparse glyph index for the characters beyond 7-bit ASCII. The table is
+ * sorted by codepoint, so a lookup is a binary search, and every glyph takes
+ * 10 bytes (a LED_Symbol of ASCII_CHARACTERS_ARRAY takes 87). Further glyphs
+ * can be inserted anywhere as long as the order is kept.
+ */
+const UTF8_Glyph UTF8_GLYPH_ARRAY[] =
+    {
+        {0x00A2, 4, {0x1C, 0x22, 0x7F, 0x22}}, // ¢
+        {0x00A3, 5, {0x48, 0x7E, 0x49, 0x49, 0x42}}, // £
+        {0x00A5, 5, {0x29, 0x2A, 0x7C, 0x2A, 0x29}}, // ¥
+        {0x00A7, 4, {0x0A, 0x55, 0x55, 0x28}}, // §
+        {0x00B0, 3, {0x02, 0x05, 0x02}}, // °
+        {0x00B1, 5, {0x24, 0x24, 0x2E, 0x24, 0x24}}, // ±
+        {0x00B5, 5, {0x7E, 0x20, 0x20, 0x1E, 0x20}}, // µ
+        {0x00C4, 5, {0x78, 0x15, 0x14, 0x15, 0x78}}, // Ä
+        {0x00D6, 5, {0x38, 0x45, 0x44, 0x45, 0x38}}, // Ö
+        {0x00D7, 5, {0x22, 0x14, 0x08, 0x14, 0x22}}, // ×
+        {0x00DC, 5, {0x3C, 0x41, 0x40, 0x41, 0x3C}}, // Ü
+        {0x00DF, 4, {0x7E, 0x01, 0x49, 0x36}}, // ß
+        {0x00E0, 5, {0x10, 0x2B, 0x2A, 0x2A, 0x3C}}, // à
+        {0x00E4, 5, {0x10, 0x2B, 0x2A, 0x2B, 0x3C}}, // ä
+        {0x00E7, 4, {0x1C, 0x22, 0x62, 0x22}}, // ç
+        {0x00E8, 5, {0x1C, 0x2B, 0x2A, 0x2A, 0x0C}}, // è
+        {0x00E9, 5, {0x1C, 0x2A, 0x2A, 0x2B, 0x0C}}, // é
+        {0x00F6, 5, {0x1C, 0x23, 0x22, 0x23, 0x1C}}, // ö
+        {0x00F7, 5, {0x08, 0x08, 0x2A, 0x08, 0x08}}, // ÷
+        {0x00FC, 5, {0x1E, 0x21, 0x20, 0x21, 0x1E}}, // ü
+        {0x20AC, 5, {0x14, 0x1C, 0x36, 0x55, 0x55}}, // €
+        {0x2190, 5, {0x08, 0x1C, 0x2A, 0x08, 0x08}}, // ←
+        {0x2191, 5, {0x04, 0x02, 0x7F, 0x02, 0x04}}, // ↑
+        {0x2192, 5, {0x08, 0x08, 0x2A, 0x1C, 0x08}}, // →
+        {0x2193, 5, {0x10, 0x20, 0x7F, 0x20, 0x10}}, // ↓
+        {0x2665, 5, {0x0C, 0x1E, 0x3C, 0x1E, 0x0C}}, // ♥
+};
+
+const uint16_t UTF8_GLYPH_COUNT = sizeof(UTF8_GLYPH_ARRAY) / sizeof(UTF8_GLYPH_ARRAY[0]);
+
+const UTF8_Glyph *UTF8_find_glyph(uint32_t codepoint)
+{
+    uint16_t low = 0;
+    uint16_t high = UTF8_GLYPH_COUNT;
+
+    while (low < high)
+    {
+        uint16_t middle = (uint16_t)((low + high) / 2);
+
+        if (UTF8_GLYPH_ARRAY[middle].codepoint == codepoint)
+        {
+            return &UTF8_GLYPH_ARRAY[middle];
+        }
+
+        if (UTF8_GLYPH_ARRAY[middle].codepoint < codepoint)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    return NULL;
+}
+
+uint8_t UTF8_decode(const char *s, uint32_t *codepoint)
+{
+    const uint8_t *bytes = (const uint8_t *)s;
+    uint8_t length;
+    uint32_t value;
+
+    if (bytes[0] < 0x80)
+    {
+        *codepoint = bytes[0];
+        return 1;
+    }
+    else if ((bytes[0] & 0xE0) == 0xC0)
+    {
+        length = 2;
+        value = bytes[0] & 0x1F;
+    }
+    else if ((bytes[0] & 0xF0) == 0xE0)
+    {
+        length = 3;
+        value = bytes[0] & 0x0F;
+    }
+    else if ((bytes[0] & 0xF8) == 0xF0)
+    {
+        length = 4;
+        value = bytes[0] & 0x07;
+    }
+    else
+    {
+        // continuation byte or 0xF8..0xFF as first byte
+        return 0;
+    }
+
+    for (uint8_t i = 1; i < length; i++)
+    {
+        // also stops at the terminating zero of a truncated sequence
+        if ((bytes[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+        value = (value << 6) | (bytes[i] & 0x3F);
+    }
+
+    // reject overlong forms, surrogates and values above U+10FFFF
+    static const uint32_t minimum[] = {0, 0, 0x80, 0x800, 0x10000};
+    if ((value < minimum[length]) || (value > 0x10FFFF) || ((value >= 0xD800) && (value <= 0xDFFF)))
+    {
+        return 0;
+    }
+
+    *codepoint = value;
+    return length;
+}
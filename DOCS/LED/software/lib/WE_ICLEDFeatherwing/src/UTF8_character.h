@@ -0,0 +1,34 @@
+#ifndef UTF8_CHARACTER_H
+#define UTF8_CHARACTER_H
+
+#include <stdint.h>
+
+#define UTF8_GLYPH_COLUMNS 6
+
+/* Glyph outside of 7-bit ASCII, one byte per column with bit 0 as the top row */
+typedef struct
+{
+    uint16_t codepoint;
+    uint8_t symbol_width;
+    uint8_t columns[UTF8_GLYPH_COLUMNS];
+} UTF8_Glyph;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    extern const UTF8_Glyph UTF8_GLYPH_ARRAY[];
+    extern const uint16_t UTF8_GLYPH_COUNT;
+
+    /* Returns the glyph of a codepoint or NULL, binary search over UTF8_GLYPH_ARRAY */
+    const UTF8_Glyph *UTF8_find_glyph(uint32_t codepoint);
+
+    /* Decodes one UTF-8 sequence, returns the number of bytes used or 0 for an invalid sequence */
+    uint8_t UTF8_decode(const char *s, uint32_t *codepoint);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -35,14 +35,15 @@
 
 #if SENSORFEATHERWING == true
 #include "sensorBoard.h"
-static float ITDS_acceleration_y;
-static volatile bool check_orientation = false;
 #define HIDS_PART_NUMBER 2525020210002
+#include "sensor_sampler.h"
+#define ORIENTATION_THRESHOLD_MG 50
 static float HIDS_humidity;
 static float TIDS_temp;
 
 void startTimer(int frequencyHz);
 void TC3_Handler();
+static void SensorSampleCallback(const SensorSample *sample);
 #endif
 
 #if PROTEUSIIIFEATHERWING == true
@@ -166,6 +167,11 @@ void setup()
     }
 #endif
 
+    if (!SensorSampler_Init(SensorSampleCallback))
+    {
+        WE_DEBUG_PRINT("Sensor sampler init failed \r\n");
+    }
+
     startTimer(5);
 
 #endif
@@ -184,28 +190,27 @@ void loop()
 {
 #if SENSORFEATHERWING == true
     ICLED_Orientation current_orientation = ICLED_get_orientation();
-    if (check_orientation)
+    SensorSample sample;
+    if (SensorSampler_GetLatest(&sample))
     {
-        if (!TIDS_2521020222501_readSensorData(&TIDS_temp))
+        static uint32_t bus_resets = 0;
+        if (sample.bus_resets != bus_resets)
         {
-            WE_DEBUG_PRINT("error reading TIDS data \r\n");
+            bus_resets = sample.bus_resets;
+            WE_DEBUG_PRINT("Sensor I2C bus reset \r\n");
         }
-#if HIDS_PART_NUMBER == 2525020210001
-        if (!HIDS_2525020210001_readSensorData(&HIDS_humidity, NULL))
+        if (sample.temperature_valid)
         {
-            WE_DEBUG_PRINT("error reading TIDS data \r\n");
+            TIDS_temp = sample.temperature_centi / 100.0f;
         }
-#elif HIDS_PART_NUMBER == 2525020210002
-        if (!HIDS_2525020210002_readSensorData(&HIDS_humidity, NULL))
+        if (sample.humidity_valid)
         {
-            WE_DEBUG_PRINT("error reading TIDS data \r\n");
+            HIDS_humidity = sample.humidity_centi / 100.0f;
         }
-#endif
-        if (ITDS_2533020201601_readSensorData(NULL, &ITDS_acceleration_y, NULL, NULL))
+        if (sample.acceleration_valid)
         {
-            ICLED_set_orientation(ITDS_acceleration_y > 0.05 ? Landscape_UpsideDown : Landscape);
+            ICLED_set_orientation(sample.acceleration_y_mg > ORIENTATION_THRESHOLD_MG ? Landscape_UpsideDown : Landscape);
         }
-        check_orientation = false;
     }
     orientation_changed = (current_orientation != ICLED_get_orientation());
 #endif
@@ -427,8 +432,49 @@ void TC3_Handler()
     if (TC->INTFLAG.bit.MC0 == 1)
     {
         TC->INTFLAG.bit.MC0 = 1;
-        check_orientation = true;
-        running_loop = false;
+        // the I2C transfers run in the background, the display keeps running until a new sample arrives
+        SensorSampler_Start();
+    }
+}
+
+/**
+ * @brief       Called from interrupt context with every new sensor sample.
+ *
+ *              Only interrupts the running animation if the shown content changes:
+ *              the orientation flips or the displayed value of the current test changes.
+ */
+static void SensorSampleCallback(const SensorSample *sample)
+{
+    static int16_t shown_temperature_tenths = INT16_MIN;
+    static int16_t shown_humidity_tenths = INT16_MIN;
+
+    if (sample->acceleration_valid)
+    {
+        ICLED_Orientation orientation = (sample->acceleration_y_mg > ORIENTATION_THRESHOLD_MG) ? Landscape_UpsideDown : Landscape;
+        if (orientation != ICLED_get_orientation())
+        {
+            running_loop = false;
+        }
+    }
+
+    if ((current_mode == TEST10) && sample->temperature_valid)
+    {
+        int16_t tenths = (int16_t)(sample->temperature_centi / 10);
+        if (tenths != shown_temperature_tenths)
+        {
+            shown_temperature_tenths = tenths;
+            running_loop = false;
+        }
+    }
+
+    if ((current_mode == TEST11) && sample->humidity_valid)
+    {
+        int16_t tenths = (int16_t)(sample->humidity_centi / 10);
+        if (tenths != shown_humidity_tenths)
+        {
+            shown_humidity_tenths = tenths;
+            running_loop = false;
+        }
     }
 }
 
@@ -0,0 +1,510 @@
+/**
+ * \file
+ * \brief Non-blocking sampling of the SensorFeatherWing sensors (TIDS, HIDS, ITDS).
+ *
+ * \copyright (c) 2024 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ * \page License
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE
+ * THAT WÜRTH ELEKTRONIK EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY
+ * KIND RELATED TO, BUT NOT LIMITED TO THE NON-INFRINGEMENT OF THIRD PARTIES’
+ * INTELLECTUAL PROPERTY RIGHTS OR THE MERCHANTABILITY OR FITNESS FOR YOUR
+ * INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT WARRANT OR
+ * REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY
+ * PATENT RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY
+ * RIGHT RELATING TO ANY COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT
+ * IS USED. INFORMATION PUBLISHED BY WÜRTH ELEKTRONIK EISOS REGARDING
+ * THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE FROM WÜRTH
+ * ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR
+ * ENDORSEMENT THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS PACKAGE
+ */
+
+/**         Includes         */
+#include "sensor_sampler.h"
+#include "global.h"
+#include "debug.h"
+#include <Wire.h>
+#include <string.h>
+
+// The sensors share the Wire bus (SERCOM3, SDA PA22 / SCL PA23). The Arduino core already owns
+// SERCOM3_Handler for the Wire slave mode, so the sampler installs its own handler in a RAM copy
+// of the vector table. Wire has to stay in master mode without smart mode (the core default).
+#define SAMPLER_SERCOM SERCOM3
+#define SAMPLER_SERCOM_IRQn SERCOM3_IRQn
+
+// Register map of the sensors
+#define TIDS_REG_CTRL 0x04
+#define TIDS_REG_CTRL_IF_ADD_INC 0x08
+#define TIDS_REG_DATA_T_L 0x06
+
+#define ITDS_REG_CTRL_6 0x25
+#define ITDS_REG_OUT_Y_L 0x2A
+
+#if HIDS_PART_NUMBER == 2525020210001
+#define HIDS_REG_H_OUT_L 0x28
+#define HIDS_REG_H0_RH_X2 0x30
+#define HIDS_REG_H0_T0_OUT_L 0x36
+#define HIDS_REG_H1_T0_OUT_L 0x3A
+#define HIDS_AUTO_INCREMENT 0x80
+#elif HIDS_PART_NUMBER == 2525020210002
+#define HIDS_CMD_MEASURE_HIGH_PRECISION 0xFD // result is ready after 8.3 ms, read on the next cycle
+#endif
+
+typedef enum
+{
+    Transfer_HIDS_Read,
+    Transfer_TIDS_Read,
+    Transfer_ITDS_Read,
+#if HIDS_PART_NUMBER == 2525020210002
+    Transfer_HIDS_Trigger,
+#endif
+    Transfer_Count
+} SamplerTransfer;
+
+typedef struct
+{
+    uint8_t address;
+    uint8_t tx[1];
+    uint8_t tx_length;
+    uint8_t rx_length;
+} I2C_Transfer;
+
+static const I2C_Transfer transfers[Transfer_Count] = {
+#if HIDS_PART_NUMBER == 2525020210001
+    [Transfer_HIDS_Read] = {SENSOR_SAMPLER_HIDS_ADDRESS, {HIDS_REG_H_OUT_L | HIDS_AUTO_INCREMENT}, 1, 2},
+#elif HIDS_PART_NUMBER == 2525020210002
+    [Transfer_HIDS_Read] = {SENSOR_SAMPLER_HIDS_ADDRESS, {0}, 0, 6},
+#endif
+    [Transfer_TIDS_Read] = {SENSOR_SAMPLER_TIDS_ADDRESS, {TIDS_REG_DATA_T_L}, 1, 2},
+    [Transfer_ITDS_Read] = {SENSOR_SAMPLER_ITDS_ADDRESS, {ITDS_REG_OUT_Y_L}, 1, 2},
+#if HIDS_PART_NUMBER == 2525020210002
+    [Transfer_HIDS_Trigger] = {SENSOR_SAMPLER_HIDS_ADDRESS, {HIDS_CMD_MEASURE_HIGH_PRECISION}, 1, 0},
+#endif
+};
+
+#define RX_BUFFER_SIZE 6
+
+// A cycle takes a few ms. If it is still running after this many starts, SCL is held low or an
+// MB/SB interrupt got lost, and the SERCOM is reset.
+#define MAX_BUSY_REFUSALS 3
+
+typedef enum
+{
+    Phase_Idle,
+    Phase_Write,
+    Phase_Read,
+} TransferPhase;
+
+static volatile TransferPhase phase = Phase_Idle;
+static uint8_t current_transfer;
+static uint8_t tx_index;
+static uint8_t rx_index;
+static uint8_t rx_buffer[Transfer_Count][RX_BUFFER_SIZE];
+static bool transfer_ok[Transfer_Count];
+
+// Published samples, the interrupt writes the back buffer and then flips the index
+static SensorSample samples[2];
+static volatile uint8_t published_index = 0;
+static uint32_t last_read_sequence = 0;
+static uint32_t sequence = 0;
+static uint32_t bus_resets = 0;
+static uint8_t busy_refusals = 0;
+
+static void (*on_sample)(const SensorSample *sample) = NULL;
+
+static int32_t itds_full_scale_mg = 2000;
+
+#if HIDS_PART_NUMBER == 2525020210001
+static int16_t hids_h0_rh_x2, hids_h1_rh_x2;
+static int16_t hids_h0_t0_out, hids_h1_t0_out;
+#endif
+
+static DeviceVectors ram_vectors __attribute__((aligned(256)));
+
+static void SensorSampler_IRQHandler();
+
+/**
+ * @brief       Blocking register read through Wire, only used during initialization.
+ */
+static bool wire_read(uint8_t address, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    if (Wire.endTransmission(false) != 0)
+    {
+        return false;
+    }
+
+    if (Wire.requestFrom(address, length) != length)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+        data[i] = (uint8_t)Wire.read();
+    }
+
+    return true;
+}
+
+/**
+ * @brief       Blocking register write through Wire, only used during initialization.
+ */
+static bool wire_write(uint8_t address, uint8_t reg, uint8_t value)
+{
+    Wire.beginTransmission(address);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+static inline void sercom_wait_sync()
+{
+    while (SAMPLER_SERCOM->I2CM.SYNCBUSY.bit.SYSOP)
+        ;
+}
+
+static inline void sercom_command(uint8_t command, bool nack)
+{
+    uint32_t ctrlb = SAMPLER_SERCOM->I2CM.CTRLB.reg & ~(SERCOM_I2CM_CTRLB_CMD_Msk | SERCOM_I2CM_CTRLB_ACKACT);
+    if (nack)
+    {
+        ctrlb |= SERCOM_I2CM_CTRLB_ACKACT;
+    }
+    SAMPLER_SERCOM->I2CM.CTRLB.reg = ctrlb | SERCOM_I2CM_CTRLB_CMD(command);
+    sercom_wait_sync();
+}
+
+static inline void sercom_address(uint8_t address, bool read)
+{
+    SAMPLER_SERCOM->I2CM.ADDR.reg = SERCOM_I2CM_ADDR_ADDR((address << 1) | (read ? 1 : 0));
+    sercom_wait_sync();
+}
+
+static void start_transfer(uint8_t index)
+{
+    const I2C_Transfer *transfer = &transfers[index];
+
+    current_transfer = index;
+    tx_index = 0;
+    rx_index = 0;
+
+    if (transfer->tx_length > 0)
+    {
+        phase = Phase_Write;
+        sercom_address(transfer->address, false);
+    }
+    else
+    {
+        phase = Phase_Read;
+        sercom_address(transfer->address, true);
+    }
+}
+
+#if HIDS_PART_NUMBER == 2525020210002
+/**
+ * @brief       CRC-8 (polynomial 0x31, init 0xFF) protecting each word of the HIDS result.
+ */
+static uint8_t hids_crc8(const uint8_t *data)
+{
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+#endif
+
+/**
+ * @brief       Convert the raw transfer results to a sample and publish it to the back buffer.
+ */
+static void publish_sample()
+{
+    SensorSample *sample = &samples[published_index ^ 1];
+
+    // keep the last good values of sensors that failed in this cycle
+    *sample = samples[published_index];
+
+    if (transfer_ok[Transfer_TIDS_Read])
+    {
+        const uint8_t *rx = rx_buffer[Transfer_TIDS_Read];
+        sample->temperature_centi = (int16_t)((rx[1] << 8) | rx[0]);
+        sample->temperature_valid = true;
+    }
+
+    if (transfer_ok[Transfer_ITDS_Read])
+    {
+        const uint8_t *rx = rx_buffer[Transfer_ITDS_Read];
+        int32_t raw = (int16_t)((rx[1] << 8) | rx[0]);
+        sample->acceleration_y_mg = (int16_t)((raw * itds_full_scale_mg) / 32768);
+        sample->acceleration_valid = true;
+    }
+
+    if (transfer_ok[Transfer_HIDS_Read])
+    {
+        const uint8_t *rx = rx_buffer[Transfer_HIDS_Read];
+        int32_t humidity_centi = 0;
+        bool humidity_ok = false;
+#if HIDS_PART_NUMBER == 2525020210001
+        int32_t raw = (int16_t)((rx[1] << 8) | rx[0]);
+        if (hids_h1_t0_out != hids_h0_t0_out)
+        {
+            // linear interpolation between the two calibration points (rH_x2 * 50 = 0.01 %)
+            humidity_centi = (int32_t)hids_h0_rh_x2 * 50 +
+                             (((int32_t)hids_h1_rh_x2 - hids_h0_rh_x2) * 50 * (raw - hids_h0_t0_out)) / (hids_h1_t0_out - hids_h0_t0_out);
+            humidity_ok = true;
+        }
+#elif HIDS_PART_NUMBER == 2525020210002
+        if (hids_crc8(&rx[3]) == rx[5])
+        {
+            uint32_t raw = ((uint32_t)rx[3] << 8) | rx[4];
+            // RH = -6 + 125 * raw / 65535
+            humidity_centi = -600 + (int32_t)((raw * 12500UL) / 65535UL);
+            humidity_ok = true;
+        }
+#endif
+        if (humidity_ok)
+        {
+            if (humidity_centi < 0)
+            {
+                humidity_centi = 0;
+            }
+            else if (humidity_centi > 10000)
+            {
+                humidity_centi = 10000;
+            }
+            sample->humidity_centi = (uint16_t)humidity_centi;
+            sample->humidity_valid = true;
+        }
+    }
+
+    sample->bus_resets = bus_resets;
+    sample->sequence = ++sequence;
+    published_index ^= 1;
+
+    if (on_sample)
+    {
+        on_sample(sample);
+    }
+}
+
+static void finish_transfer(bool ok)
+{
+    transfer_ok[current_transfer] = ok;
+
+    if (current_transfer + 1 < Transfer_Count)
+    {
+        start_transfer(current_transfer + 1);
+        return;
+    }
+
+    phase = Phase_Idle;
+    publish_sample();
+}
+
+/**
+ * @brief       Give up a stuck cycle: STOP, force the bus state back to idle and publish what is left.
+ */
+static void abort_cycle()
+{
+    sercom_command(3, true);
+    SAMPLER_SERCOM->I2CM.STATUS.reg = SERCOM_I2CM_STATUS_BUSSTATE(1);
+    sercom_wait_sync();
+    SAMPLER_SERCOM->I2CM.INTFLAG.reg = SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB | SERCOM_I2CM_INTFLAG_ERROR;
+
+    for (uint8_t i = current_transfer; i < Transfer_Count; i++)
+    {
+        transfer_ok[i] = false;
+    }
+
+    bus_resets++;
+    phase = Phase_Idle;
+    publish_sample();
+}
+
+static void SensorSampler_IRQHandler()
+{
+    uint8_t flags = SAMPLER_SERCOM->I2CM.INTFLAG.reg;
+    uint16_t status = SAMPLER_SERCOM->I2CM.STATUS.reg;
+    const I2C_Transfer *transfer = &transfers[current_transfer];
+
+    if (phase == Phase_Idle)
+    {
+        SAMPLER_SERCOM->I2CM.INTFLAG.reg = flags;
+        return;
+    }
+
+    if ((flags & SERCOM_I2CM_INTFLAG_ERROR) || (status & (SERCOM_I2CM_STATUS_BUSERR | SERCOM_I2CM_STATUS_ARBLOST)))
+    {
+        // clear the error and give up this transfer, the next one restarts the bus
+        SAMPLER_SERCOM->I2CM.STATUS.reg = SERCOM_I2CM_STATUS_BUSERR | SERCOM_I2CM_STATUS_ARBLOST;
+        SAMPLER_SERCOM->I2CM.INTFLAG.reg = SERCOM_I2CM_INTFLAG_ERROR;
+        if (!(status & SERCOM_I2CM_STATUS_ARBLOST))
+        {
+            sercom_command(3, true);
+        }
+        finish_transfer(false);
+        return;
+    }
+
+    if (flags & SERCOM_I2CM_INTFLAG_MB)
+    {
+        if ((status & SERCOM_I2CM_STATUS_RXNACK) || (phase != Phase_Write))
+        {
+            // address or data not acknowledged, e.g. HIDS result not ready on the first cycle
+            sercom_command(3, true);
+            finish_transfer(false);
+        }
+        else if (tx_index < transfer->tx_length)
+        {
+            SAMPLER_SERCOM->I2CM.DATA.reg = transfer->tx[tx_index++];
+            sercom_wait_sync();
+        }
+        else if (transfer->rx_length > 0)
+        {
+            // repeated start for the read part
+            phase = Phase_Read;
+            sercom_address(transfer->address, true);
+        }
+        else
+        {
+            sercom_command(3, false);
+            finish_transfer(true);
+        }
+        return;
+    }
+
+    if (flags & SERCOM_I2CM_INTFLAG_SB)
+    {
+        rx_buffer[current_transfer][rx_index++] = SAMPLER_SERCOM->I2CM.DATA.reg;
+
+        if (rx_index < transfer->rx_length)
+        {
+            sercom_command(2, false); // ACK and read the next byte
+        }
+        else
+        {
+            sercom_command(3, true); // NACK the last byte and STOP
+            finish_transfer(true);
+        }
+    }
+}
+
+bool SensorSampler_Init(void (*sample_callback)(const SensorSample *sample))
+{
+    uint8_t data[2];
+
+    // Let the TIDS increment the register address so both temperature bytes come in one transfer
+    if (!wire_read(SENSOR_SAMPLER_TIDS_ADDRESS, TIDS_REG_CTRL, data, 1) ||
+        !wire_write(SENSOR_SAMPLER_TIDS_ADDRESS, TIDS_REG_CTRL, data[0] | TIDS_REG_CTRL_IF_ADD_INC))
+    {
+        WE_DEBUG_PRINT("TIDS configuration failed \r\n");
+        return false;
+    }
+
+    // Full scale configured by the ITDS driver (CTRL_6 FS[1:0] = 2, 4, 8 or 16 g)
+    if (!wire_read(SENSOR_SAMPLER_ITDS_ADDRESS, ITDS_REG_CTRL_6, data, 1))
+    {
+        WE_DEBUG_PRINT("ITDS configuration failed \r\n");
+        return false;
+    }
+    itds_full_scale_mg = 2000 << ((data[0] >> 4) & 0x03);
+
+#if HIDS_PART_NUMBER == 2525020210001
+    if (!wire_read(SENSOR_SAMPLER_HIDS_ADDRESS, HIDS_REG_H0_RH_X2 | HIDS_AUTO_INCREMENT, data, 2))
+    {
+        WE_DEBUG_PRINT("HIDS calibration read failed \r\n");
+        return false;
+    }
+    hids_h0_rh_x2 = data[0];
+    hids_h1_rh_x2 = data[1];
+    if (!wire_read(SENSOR_SAMPLER_HIDS_ADDRESS, HIDS_REG_H0_T0_OUT_L | HIDS_AUTO_INCREMENT, data, 2))
+    {
+        WE_DEBUG_PRINT("HIDS calibration read failed \r\n");
+        return false;
+    }
+    hids_h0_t0_out = (int16_t)((data[1] << 8) | data[0]);
+    if (!wire_read(SENSOR_SAMPLER_HIDS_ADDRESS, HIDS_REG_H1_T0_OUT_L | HIDS_AUTO_INCREMENT, data, 2))
+    {
+        WE_DEBUG_PRINT("HIDS calibration read failed \r\n");
+        return false;
+    }
+    hids_h1_t0_out = (int16_t)((data[1] << 8) | data[0]);
+#endif
+
+    on_sample = sample_callback;
+
+    // Move the vector table to RAM and install the sampler as SERCOM3 handler
+    noInterrupts();
+    memcpy(&ram_vectors, (const void *)SCB->VTOR, sizeof(ram_vectors));
+    ram_vectors.pfnSERCOM3_Handler = (void *)SensorSampler_IRQHandler;
+    SCB->VTOR = (uint32_t)&ram_vectors;
+    __DSB();
+    interrupts();
+
+    SAMPLER_SERCOM->I2CM.INTFLAG.reg = SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB | SERCOM_I2CM_INTFLAG_ERROR;
+    SAMPLER_SERCOM->I2CM.INTENSET.reg = SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR;
+    NVIC_SetPriority(SAMPLER_SERCOM_IRQn, 3);
+    NVIC_EnableIRQ(SAMPLER_SERCOM_IRQn);
+
+    return true;
+}
+
+bool SensorSampler_Start()
+{
+    if (phase != Phase_Idle)
+    {
+        if (++busy_refusals < MAX_BUSY_REFUSALS)
+        {
+            return false;
+        }
+
+        // keep the SERCOM interrupt out while the cycle is torn down
+        NVIC_DisableIRQ(SAMPLER_SERCOM_IRQn);
+        abort_cycle();
+        NVIC_EnableIRQ(SAMPLER_SERCOM_IRQn);
+        busy_refusals = 0;
+        return false;
+    }
+
+    busy_refusals = 0;
+    start_transfer(0);
+
+    return true;
+}
+
+bool SensorSampler_GetLatest(SensorSample *sample)
+{
+    if (sample == NULL)
+    {
+        return false;
+    }
+
+    // the interrupt may flip the buffers while copying, retry until the copy is consistent
+    uint8_t index;
+    do
+    {
+        index = published_index;
+        *sample = samples[index];
+    } while (index != published_index);
+
+    if (sample->sequence == last_read_sequence)
+    {
+        return false;
+    }
+
+    last_read_sequence = sample->sequence;
+
+    return true;
+}
@@ -0,0 +1,92 @@
+/**
+ * \file
+ * \brief Non-blocking sampling of the SensorFeatherWing sensors (TIDS, HIDS, ITDS).
+ *
+ * \copyright (c) 2024 Würth Elektronik eiSos GmbH & Co. KG
+ *
+ * \page License
+ *
+ * THE SOFTWARE INCLUDING THE SOURCE CODE IS PROVIDED “AS IS”. YOU ACKNOWLEDGE
+ * THAT WÜRTH ELEKTRONIK EISOS MAKES NO REPRESENTATIONS AND WARRANTIES OF ANY
+ * KIND RELATED TO, BUT NOT LIMITED TO THE NON-INFRINGEMENT OF THIRD PARTIES’
+ * INTELLECTUAL PROPERTY RIGHTS OR THE MERCHANTABILITY OR FITNESS FOR YOUR
+ * INTENDED PURPOSE OR USAGE. WÜRTH ELEKTRONIK EISOS DOES NOT WARRANT OR
+ * REPRESENT THAT ANY LICENSE, EITHER EXPRESS OR IMPLIED, IS GRANTED UNDER ANY
+ * PATENT RIGHT, COPYRIGHT, MASK WORK RIGHT, OR OTHER INTELLECTUAL PROPERTY
+ * RIGHT RELATING TO ANY COMBINATION, MACHINE, OR PROCESS IN WHICH THE PRODUCT
+ * IS USED. INFORMATION PUBLISHED BY WÜRTH ELEKTRONIK EISOS REGARDING
+ * THIRD-PARTY PRODUCTS OR SERVICES DOES NOT CONSTITUTE A LICENSE FROM WÜRTH
+ * ELEKTRONIK EISOS TO USE SUCH PRODUCTS OR SERVICES OR A WARRANTY OR
+ * ENDORSEMENT THEREOF
+ *
+ * THIS SOURCE CODE IS PROTECTED BY A LICENSE.
+ * FOR MORE INFORMATION PLEASE CAREFULLY READ THE LICENSE AGREEMENT FILE LOCATED
+ * IN THE ROOT DIRECTORY OF THIS PACKAGE
+ */
+
+#ifndef SENSOR_SAMPLER_H
+#define SENSOR_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef HIDS_PART_NUMBER
+#define HIDS_PART_NUMBER 2525020210002
+#endif
+
+// I2C addresses of the sensors on the SensorFeatherWing
+#define SENSOR_SAMPLER_TIDS_ADDRESS 0x38
+#define SENSOR_SAMPLER_ITDS_ADDRESS 0x19
+#if HIDS_PART_NUMBER == 2525020210001
+#define SENSOR_SAMPLER_HIDS_ADDRESS 0x5F
+#elif HIDS_PART_NUMBER == 2525020210002
+#define SENSOR_SAMPLER_HIDS_ADDRESS 0x44
+#endif
+
+typedef struct
+{
+    uint32_t sequence;         // Incremented with every published sample
+    uint32_t bus_resets;       // SERCOM resets after a cycle got stuck (SCL held low, lost interrupt)
+    int16_t temperature_centi; // TIDS temperature in 0.01 °C
+    uint16_t humidity_centi;   // HIDS relative humidity in 0.01 %
+    int16_t acceleration_y_mg; // ITDS acceleration on the y-axis in mg
+    bool temperature_valid;
+    bool humidity_valid;
+    bool acceleration_valid;
+} SensorSample;
+
+/**
+ * @brief       Take over the I2C bus of the sensors for interrupt driven sampling.
+ *
+ *              Must be called after the sensors were initialized (blocking) through their drivers.
+ *              From now on the sensor drivers must not be used anymore.
+ *
+ * @param[in]   sample_callback: Optional function called from interrupt context whenever a new sample was published.
+ *
+ * @return      True if successful, false otherwise.
+ */
+bool SensorSampler_Init(void (*sample_callback)(const SensorSample *sample) = NULL);
+
+/**
+ * @brief       Start one sampling cycle over all sensors, safe to be called from interrupt context.
+ *
+ *              The I2C transactions are chained in the SERCOM interrupt, the function returns immediately.
+ *
+ *              A cycle still running after several starts is aborted: the SERCOM is reset, the sample
+ *              is published with the failed sensors unchanged and bus_resets incremented.
+ *
+ * @return      True if the cycle was started, false if the previous cycle is still running.
+ */
+bool SensorSampler_Start();
+
+/**
+ * @brief       Get the most recently published sample.
+ *
+ * @param[out]  sample: Copy of the latest sample.
+ *
+ * @return      True if the sample is new since the last call, false otherwise.
+ */
+bool SensorSampler_GetLatest(SensorSample *sample);
+
+#endif
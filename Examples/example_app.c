@@ -3,7 +3,7 @@
  * @brief Contains example LED animation effects for the ICLED matrix.
  *
  * Provides a set of demonstration effects including Knight Rider, Starfield,
- * and Snake animation for 7x15 ICLED matrices.
+ * Snake and Ripple animation for 7x15 ICLED matrices.
  *
  * Created on: Apr 18, 2025
  * Author: MootSeeker
@@ -12,6 +12,8 @@
 #include "example_app.h"
 #include "icled.h"
 #include "main.h"
+#include "icled_telemetry.h"
+#include "icled_ripple.h"
 
 #include <stdlib.h>
 
@@ -31,6 +33,17 @@
  */
 #define MAX_STARS 10
 
+/**
+ * @def RIPPLE_STRENGTH
+ * @brief Depth of a drop in the ripple effect (button, I2C), rain drops are half as deep.
+ */
+#define RIPPLE_STRENGTH     8000
+
+/**
+ * @def RIPPLE_RAIN_CHANCE
+ * @brief Chance of a rain drop per ripple frame in 1/256.
+ */
+#define RIPPLE_RAIN_CHANCE  8
 
 
 /**
@@ -43,6 +56,7 @@ typedef enum
     EFFECT_GLOW   	 = 1,
 	EFFECT_STARFIELD = 2,
 	EFFECT_SNAKE 	 = 3,
+	EFFECT_RIPPLE 	 = 4,
     EFFECT_COUNT
 } ICLED_EffectMode;
 
@@ -53,6 +67,17 @@ typedef enum
  */
 volatile ICLED_EffectMode effectMode = EFFECT_SIMPLE;
 
+/**
+ * @brief Brightness and delay set with example_app_set_params() (0 = effect default).
+ */
+static volatile uint8_t paramBrightness = 0;
+static volatile uint16_t paramDelay = 0;
+
+/**
+ * @brief LED index of the next drop into the ripple effect, -1 = none.
+ */
+static volatile int16_t rippleDrop = -1;
+
 /**
  * @struct Star
  * @brief Represents a temporary star in the starfield animation.
@@ -75,7 +100,8 @@ typedef struct
  * (e.g., GPIO pin falling edge). It handles switching between predefined
  * LED effects by incrementing the global @ref effectMode variable.
  *
- * When the end of the effect list is reached, it wraps back to 0.
+ * When the end of the effect list is reached, it wraps back to 0. The press
+ * that brings up the ripple effect drops a stone into the middle of the matrix.
  *
  * @param GPIO_Pin The pin number that triggered the interrupt.
  *
@@ -85,11 +111,19 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
     if (GPIO_Pin == S2_Pin) // S2 Button
     {
+#if ICLED_LATENCY
+        ICLED_Latency_Input(ICLED_LATENCY_BUTTON, ICLED_TELEMETRY_CYCLES());
+#endif
         effectMode++;
         if (effectMode >= EFFECT_COUNT)
         {
             effectMode = 0;
         }
+
+        if (effectMode == EFFECT_RIPPLE)
+        {
+            rippleDrop = (ICLED_COLUMNS / 2) * ICLED_ROWS + ICLED_ROWS / 2;
+        }
     }
 }
 
@@ -366,6 +400,48 @@ void ICLED_SnakePattern(uint8_t brightness, uint16_t delay)
     }
 }
 
+/**
+ * @brief Water ripples from drops and a light rain.
+ *
+ * The surface is a 2D wave equation (see icled_ripple.h) of one cell per LED:
+ * - Drops from the S2 button or the I2C register map land where requested.
+ * - Rain drops fall at random places with a chance of RIPPLE_RAIN_CHANCE / 256 per frame.
+ * - Heights are coloured through a water palette, troughs dark blue, crests white.
+ *
+ * @param brightness Brightness of the crests (0–255).
+ * @param delay Delay between frames in milliseconds (16 for ~60 fps).
+ *
+ * @note Call this function repeatedly (e.g., from the main loop).
+ */
+void ICLED_RippleEffect(uint8_t brightness, uint16_t delay)
+{
+    static ICLED_Ripple pool;
+    static int16_t fields[2 * ICLED_RIPPLE_CELLS(ICLED_COLUMNS, ICLED_ROWS)];
+    static uint8_t init = 0;
+
+    if (!init)
+    {
+        ICLED_Ripple_Init(&pool, fields, ICLED_COLUMNS, ICLED_ROWS);
+        init = 1;
+    }
+
+    int16_t drop = rippleDrop;
+    if (drop >= 0)
+    {
+        rippleDrop = -1;
+        ICLED_Ripple_Drop(&pool, drop / ICLED_ROWS, drop % ICLED_ROWS, RIPPLE_STRENGTH);
+    }
+
+    ICLED_Ripple_Rain(&pool, RIPPLE_RAIN_CHANCE, RIPPLE_STRENGTH / 2);
+    ICLED_Ripple_Step(&pool);
+
+    // column-major like the pixel buffer, one cell per LED
+    ICLED_Ripple_Render(&pool, ICLED_GetBuffer(), brightness);
+
+    ICLED_Show();
+    HAL_Delay(delay);
+}
+
 /**
  * @brief Executes the currently selected LED effect.
  *
@@ -379,24 +455,31 @@ void ICLED_SnakePattern(uint8_t brightness, uint16_t delay)
  * - EFFECT_GLOW: Color-fading Knight Rider.
  * - EFFECT_STARFIELD: Random blinking stars.
  * - EFFECT_SNAKE: Dynamic snake animation across matrix.
+ * - EFFECT_RIPPLE: Water ripples from drops and rain.
  *
  * @return void
  */
 void example_app_run(void)
 {
+    uint8_t brightness = paramBrightness;
+    uint16_t delay = paramDelay;
+
     switch (effectMode)
     {
         case EFFECT_SIMPLE:
-            ICLED_NightRideDemo(40, 80);
+            ICLED_NightRideDemo(brightness ? brightness : 40, delay ? delay : 80);
             break;
         case EFFECT_GLOW:
-            ICLED_KnightRiderColorFade(40, 100);
+            ICLED_KnightRiderColorFade(brightness ? brightness : 40, delay ? delay : 100);
             break;
         case EFFECT_STARFIELD:
-            ICLED_StarfieldEffect(20, 100);
+            ICLED_StarfieldEffect(brightness ? brightness : 20, delay ? delay : 100);
             break;
         case EFFECT_SNAKE:
-            ICLED_SnakePattern(40, 60);
+            ICLED_SnakePattern(brightness ? brightness : 40, delay ? delay : 60);
+            break;
+        case EFFECT_RIPPLE:
+            ICLED_RippleEffect(brightness ? brightness : 60, delay ? delay : 16);
             break;
         default:
             ICLED_Clear();
@@ -404,3 +487,59 @@ void example_app_run(void)
             break;
     }
 }
+
+/**
+ * @brief Selects the demo effect.
+ *
+ * @param effect Effect index, see @ref ICLED_EffectMode.
+ *
+ * @return true if the effect exists, false otherwise.
+ */
+bool example_app_set_effect(uint8_t effect)
+{
+    if (effect >= EFFECT_COUNT)
+    {
+        return false;
+    }
+
+    effectMode = (ICLED_EffectMode)effect;
+    return true;
+}
+
+/**
+ * @brief Returns the index of the running demo effect.
+ */
+uint8_t example_app_get_effect(void)
+{
+    return (uint8_t)effectMode;
+}
+
+/**
+ * @brief Overrides the brightness and frame delay of the demo effects.
+ *
+ * @param brightness Brightness as the effect expects it, 0 keeps the default.
+ * @param delay Delay between frames in milliseconds, 0 keeps the default.
+ */
+void example_app_set_params(uint8_t brightness, uint16_t delay)
+{
+    paramBrightness = brightness;
+    paramDelay = delay;
+}
+
+/**
+ * @brief Drops a stone into the ripple effect.
+ *
+ * @param index LED index of the drop (column * ICLED_ROWS + row).
+ *
+ * @return true if the index exists, false otherwise.
+ */
+bool example_app_drop(uint16_t index)
+{
+    if (index >= ICLED_LED_COUNT)
+    {
+        return false;
+    }
+
+    rippleDrop = (int16_t)index;
+    return true;
+}
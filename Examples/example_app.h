@@ -12,6 +12,7 @@
 #ifndef EXAMPLE_APP_H
 #define EXAMPLE_APP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -26,6 +27,39 @@ extern "C" {
  */
 void example_app_run(void);
 
+/**
+ * @brief Selects the demo effect (same as pressing S2 until it is reached).
+ *
+ * @param effect Effect index (0 = Knight Rider, 1 = color fade, 2 = starfield, 3 = snake, 4 = ripple).
+ *
+ * @return true if the effect exists, false otherwise.
+ */
+bool example_app_set_effect(uint8_t effect);
+
+/**
+ * @brief Returns the index of the running demo effect.
+ */
+uint8_t example_app_get_effect(void);
+
+/**
+ * @brief Overrides the brightness and frame delay of the demo effects.
+ *
+ * @param brightness Brightness as the effect expects it, 0 keeps the effect's default.
+ * @param delay Delay between frames in milliseconds, 0 keeps the effect's default.
+ */
+void example_app_set_params(uint8_t brightness, uint16_t delay);
+
+/**
+ * @brief Drops a stone into the ripple effect, it lands with the next ripple frame.
+ *
+ * Safe to call from interrupts. Ignored by the other effects.
+ *
+ * @param index LED index of the drop (column * ICLED_ROWS + row).
+ *
+ * @return true if the index exists, false otherwise.
+ */
+bool example_app_drop(uint16_t index);
+
 /**
  * @brief Classic Knight Rider effect with red sweep and glow.
  *
@@ -60,6 +94,14 @@ void ICLED_StarfieldEffect(uint8_t brightness, uint16_t delay);
  */
 void ICLED_SnakePattern(uint8_t brightness, uint16_t delay);
 
+/**
+ * @brief Water ripples from a 2D wave equation, drops from S2, I2C and random rain.
+ *
+ * @param brightness Brightness of the crests (0–255).
+ * @param delay Delay between frames in milliseconds.
+ */
+void ICLED_RippleEffect(uint8_t brightness, uint16_t delay);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,66 @@
+/**
+ * @file icled_bench_host.c
+ * @author MootSeeker
+ * @brief Host build of the frame pipeline benchmark (Core/Src/icled_bench.c).
+ *
+ * Runs the same scenarios as the benchmark firmware against the HAL
+ * stand-in. Cycles are nanoseconds of the monotonic clock, the RAM
+ * high-water mark is the peak resident set of the process. HAL_Delay() does
+ * not wait (manual tick), so the run takes about a second.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled.h"
+#include "icled_bench.h"
+#include "icled_stream.h"
+#include "main.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+
+static uint32_t Bench_HostCycles( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( uint32_t )( ( uint64_t )ts.tv_sec * 1000000000ULL + ( uint64_t )ts.tv_nsec );
+}
+
+static void Bench_HostWrite( const char *line, uint16_t length )
+{
+    fwrite( line, 1, length, stdout );
+    fflush( stdout );
+}
+
+static uint32_t Bench_HostRam( void )
+{
+    struct rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+    return ( uint32_t )usage.ru_maxrss * 1024U;
+}
+
+int main( int argc, char **argv )
+{
+    ICLED_BenchPort port =
+    {
+        .target   = ( argc > 1 ) ? argv[1] : "host",
+        .clock_hz = 1000000000UL,
+        .cycles   = Bench_HostCycles,
+        .write    = Bench_HostWrite,
+        .ram_used = Bench_HostRam,
+    };
+
+    srand( 1 );
+
+    /* Same order as the USER CODE 2 section of main.c */
+    ICLED_Init( );
+    ICLED_Stream_Init( );
+
+    ICLED_Bench_Run( &port );
+
+    return 0;
+}
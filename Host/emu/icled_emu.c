@@ -0,0 +1,355 @@
+/**
+ * @file icled_emu.c
+ * @author MootSeeker
+ * @brief Runs the firmware application as a Linux process with a PTY as USART2.
+ *
+ * The main loop of Core/Src/main.c (stream decoders first, demo effects while
+ * no host is streaming) runs unchanged firmware code: icled.c, icled_stream.c
+ * and example_app.c, built against the HAL stand-in in Host/mock. The PWM
+ * buffer handed to the mocked TIM1 DMA is decoded back into pixels, every
+ * frame is recorded with its timestamp.
+ *
+ * A UART model thread moves the bytes written to the PTY into the circular
+ * DMA buffer at the modelled baud rate (10 bit times per byte). It reads the
+ * PTY only as fast as the model consumes, so a host tool sees the same
+ * back-pressure as on a real serial line. Latency is measured from the
+ * moment the newest byte the decoder had seen finished on the modelled wire
+ * until ICLED_Show().
+ *
+ * The DMX, SPI and I2C inputs program their peripherals on register level
+ * and are not part of the emulation.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include "icled.h"
+#include "icled_stream.h"
+#include "icled_interp.h"
+#include "example_app.h"
+#include "main.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define EMU_MAX_FRAMES      1000000
+#define EMU_STAGING_SIZE    64
+
+static int pty_master = -1;
+static int pty_slave = -1;
+static unsigned baud = ICLED_STREAM_BAUDRATE;
+static uint64_t byte_ns;
+
+static volatile sig_atomic_t stop;
+
+static uint64_t arrival_ns[ICLED_STREAM_RX_SIZE];   ///< Wire end time per DMA buffer index
+
+static FILE *record;
+static uint64_t start_ns;
+static int in_stream;                               ///< ICLED_Show() comes from the decoder
+
+static uint32_t stream_frames;
+static uint32_t local_frames;
+static uint64_t first_stream_ns;
+static uint64_t last_stream_ns;
+static uint32_t *latency_us;
+
+static void Emu_Signal( int signo )
+{
+    ( void )signo;
+    stop = 1;
+}
+
+static void Emu_Sleep( uint64_t ns )
+{
+    struct timespec ts = { ( time_t )( ns / 1000000000ULL ), ( long )( ns % 1000000000ULL ) };
+    nanosleep( &ts, NULL );
+}
+
+/**
+ * @brief Frame hook of the mocked TIM1 DMA: record the decoded pixels.
+ */
+static void Emu_Frame( const uint8_t *grb, uint16_t leds )
+{
+    uint64_t now = HAL_Mock_Now( );
+    int64_t latency = -1;
+
+    if( in_stream )
+    {
+        int seen = HAL_Mock_UartLastSeen( );
+        if( ( seen >= 0 ) && ( arrival_ns[seen] != 0 ) && ( now >= arrival_ns[seen] ) )
+        {
+            latency = ( int64_t )( ( now - arrival_ns[seen] ) / 1000 );
+        }
+
+        if( stream_frames == 0 ) first_stream_ns = now;
+        last_stream_ns = now;
+        if( ( latency >= 0 ) && ( stream_frames < EMU_MAX_FRAMES ) )
+        {
+            latency_us[stream_frames] = ( uint32_t )latency;
+        }
+        stream_frames++;
+    }
+    else
+    {
+        local_frames++;
+    }
+
+    if( record == NULL ) return;
+
+    fprintf( record, "%.6f %s %lld ", ( now - start_ns ) / 1e9, in_stream ? "stream" : "local", ( long long )latency );
+    for( uint16_t i = 0; i < leds; i++ )
+    {
+        fprintf( record, "%02x%02x%02x", grb[i * 3 + 1], grb[i * 3 + 0], grb[i * 3 + 2] );
+    }
+    fputc( '\n', record );
+}
+
+/**
+ * @brief Bytes the firmware sends on USART2 (the Adalight handshake) go to the PTY.
+ */
+static void Emu_UartTx( const uint8_t *data, uint16_t size )
+{
+    ( void )!write( pty_master, data, size );
+}
+
+/**
+ * @brief UART model: moves the PTY bytes into the DMA buffer at the modelled baud rate.
+ */
+static void *Emu_Uart( void *arg )
+{
+    ( void )arg;
+
+    uint8_t staging[EMU_STAGING_SIZE];
+    ssize_t length = 0, pos = 0;
+    uint64_t wire_ns = 0;   // end of the last byte on the modelled wire
+
+    while( !stop )
+    {
+        if( pos == length )
+        {
+            struct pollfd pfd = { .fd = pty_master, .events = POLLIN };
+            if( poll( &pfd, 1, 20 ) <= 0 ) continue;
+
+            length = read( pty_master, staging, sizeof( staging ) );
+            pos = 0;
+            if( length <= 0 )
+            {
+                length = 0;
+                continue;
+            }
+
+            uint64_t now = HAL_Mock_Now( );
+            if( wire_ns < now ) wire_ns = now;   // line was idle
+        }
+
+        uint64_t now = HAL_Mock_Now( );
+        while( ( pos < length ) && ( wire_ns + byte_ns <= now ) )
+        {
+            wire_ns += byte_ns;
+            int index = HAL_Mock_UartReceive( staging[pos++] );
+            if( index >= 0 ) arrival_ns[index] = wire_ns;
+        }
+
+        if( pos < length )
+        {
+            uint64_t wait = wire_ns + byte_ns - now;
+            Emu_Sleep( wait > 20000 ? wait : 20000 );
+        }
+    }
+
+    return NULL;
+}
+
+static int Emu_OpenPty( const char *link )
+{
+    pty_master = posix_openpt( O_RDWR | O_NOCTTY );
+    if( ( pty_master < 0 ) || ( grantpt( pty_master ) != 0 ) || ( unlockpt( pty_master ) != 0 ) )
+    {
+        perror( "posix_openpt" );
+        return -1;
+    }
+
+    const char *path = ptsname( pty_master );
+
+    // keep the slave open, otherwise the master reads EIO whenever no tool is connected
+    pty_slave = open( path, O_RDWR | O_NOCTTY );
+    if( pty_slave < 0 )
+    {
+        perror( path );
+        return -1;
+    }
+
+    struct termios tio;
+    if( tcgetattr( pty_slave, &tio ) == 0 )
+    {
+        cfmakeraw( &tio );
+        tcsetattr( pty_slave, TCSANOW, &tio );
+    }
+
+    if( link != NULL )
+    {
+        unlink( link );
+        if( symlink( path, link ) != 0 )
+        {
+            perror( link );
+            return -1;
+        }
+        path = link;
+    }
+
+    printf( "USART2 on %s (%u baud model)\n", path, baud );
+    fflush( stdout );
+    return 0;
+}
+
+static int Emu_CompareU32( const void *a, const void *b )
+{
+    uint32_t x = *( const uint32_t * )a, y = *( const uint32_t * )b;
+    return ( x > y ) - ( x < y );
+}
+
+static void Emu_Report( void )
+{
+    ICLED_StreamStats stats;
+    ICLED_Stream_GetStats( &stats );
+
+    uint32_t count = ( stream_frames < EMU_MAX_FRAMES ) ? stream_frames : EMU_MAX_FRAMES;
+    double seconds = ( last_stream_ns - first_stream_ns ) / 1e9;
+
+    printf( "\nstream: %u frames", stream_frames );
+    if( ( stream_frames > 1 ) && ( seconds > 0 ) )
+    {
+        printf( ", %.1f fps", ( stream_frames - 1 ) / seconds );
+    }
+    printf( " (Adalight %u, TPM2 %u, DDP %u), local: %u frames\n",
+            stats.frames[ICLED_STREAM_ADALIGHT], stats.frames[ICLED_STREAM_TPM2], stats.frames[ICLED_STREAM_DDP], local_frames );
+    printf( "decoder: %u bytes, %u errors\n", stats.bytes, stats.errors );
+
+    if( count > 0 )
+    {
+        uint64_t sum = 0;
+        qsort( latency_us, count, sizeof( uint32_t ), Emu_CompareU32 );
+        for( uint32_t i = 0; i < count; i++ ) sum += latency_us[i];
+
+        printf( "latency (last byte -> show): avg %.1f us, p50 %u us, p99 %u us, max %u us\n",
+                ( double )sum / count, latency_us[count / 2], latency_us[( count * 99 ) / 100], latency_us[count - 1] );
+    }
+}
+
+static void Emu_Usage( const char *name )
+{
+    fprintf( stderr,
+             "usage: %s [options]\n"
+             "  -b BAUD  baud rate of the UART model (default %u)\n"
+             "  -l PATH  symlink to the PTY, e.g. /tmp/icled\n"
+             "  -o FILE  record every frame: time, source, latency in us, RGB hex per LED\n"
+             "  -d SEC   stop after SEC seconds (default: until Ctrl+C)\n"
+             "  -q       no demo effects while idle\n",
+             name, ICLED_STREAM_BAUDRATE );
+}
+
+int main( int argc, char **argv )
+{
+    const char *link = NULL, *output = NULL;
+    unsigned duration = 0;
+    int demos = 1;
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "b:l:o:d:qh" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 'b': baud = ( unsigned )atoi( optarg ); break;
+            case 'l': link = optarg; break;
+            case 'o': output = optarg; break;
+            case 'd': duration = ( unsigned )atoi( optarg ); break;
+            case 'q': demos = 0; break;
+            default:  Emu_Usage( argv[0] ); return 1;
+        }
+    }
+
+    if( baud == 0 )
+    {
+        Emu_Usage( argv[0] );
+        return 1;
+    }
+    byte_ns = 10ULL * 1000000000ULL / baud;
+
+    latency_us = calloc( EMU_MAX_FRAMES, sizeof( uint32_t ) );
+    if( latency_us == NULL ) return 1;
+
+    if( output != NULL )
+    {
+        record = fopen( output, "w" );
+        if( record == NULL )
+        {
+            perror( output );
+            return 1;
+        }
+    }
+
+    signal( SIGINT, Emu_Signal );
+    signal( SIGTERM, Emu_Signal );
+
+    if( Emu_OpenPty( link ) != 0 ) return 1;
+
+    HAL_Mock_SetTickMode( HAL_MOCK_TICK_REALTIME );
+    HAL_Mock_SetFrameHook( Emu_Frame );
+    HAL_Mock_SetUartTxHook( Emu_UartTx );
+    start_ns = HAL_Mock_Now( );
+
+    /* Same order as the USER CODE 2 section of main.c */
+    ICLED_Init( );
+    ICLED_Stream_Init( );
+
+    pthread_t uart;
+    pthread_create( &uart, NULL, Emu_Uart, NULL );
+
+    while( !stop )
+    {
+        in_stream = 1;
+        ICLED_Stream_Process( );
+        ICLED_Interp_Process( );
+        in_stream = 0;
+
+        if( !ICLED_Stream_IsActive( ) && demos )
+        {
+            example_app_run( );
+        }
+        else
+        {
+            // the MCU would spin here, give the host CPU back
+            Emu_Sleep( 20000 );
+        }
+
+        if( duration && ( HAL_Mock_Now( ) - start_ns ) >= ( uint64_t )duration * 1000000000ULL )
+        {
+            stop = 1;
+        }
+    }
+
+    pthread_join( uart, NULL );
+
+    Emu_Report( );
+
+    if( record != NULL ) fclose( record );
+    if( link != NULL ) unlink( link );
+    close( pty_slave );
+    close( pty_master );
+    free( latency_us );
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file icled_mirror.c
+ * @author MootSeeker
+ * @brief Shows the frame mirror of a board (icled_mirror.h) in the terminal.
+ *
+ * Usage: icled_mirror [-b baud] [port]
+ *
+ * Reads the packets from the serial port (the ST-LINK VCP) or, without a
+ * port, from stdin, applies key frames and deltas to its copy of the matrix
+ * and redraws it with 24-bit ANSI colours, one LED as two character cells.
+ * After a lost packet (sequence gap or checksum error) the copy is stale
+ * until the next key frame, which is shown in the status line.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include "icled.h"
+#include "icled_mirror.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define MIRROR_BYTES        (ICLED_LED_COUNT * 3)
+
+/**
+ * @enum State
+ * @brief Position of the parser in a packet.
+ */
+typedef enum
+{
+    STATE_SYNC_I = 0,
+    STATE_SYNC_M,
+    STATE_HEADER,
+    STATE_PAYLOAD,
+    STATE_CHECKSUM
+} State;
+
+static uint8_t frame[MIRROR_BYTES];
+static uint8_t packet[ICLED_MIRROR_HEADER + MIRROR_BYTES];
+static uint16_t fill;
+static uint16_t length;
+static State state = STATE_SYNC_I;
+
+static bool synced;             ///< frame[] matches the board
+static bool have_seq;
+static uint8_t next_seq;
+static unsigned keyframes, deltas, lost, errors;
+
+/**
+ * @brief Speed constant of a baud rate, 0 if termios has none.
+ */
+static speed_t Mirror_BaudConstant( unsigned baud )
+{
+    switch( baud )
+    {
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 921600:  return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        default:      return 0;
+    }
+}
+
+/**
+ * @brief Opens a serial port (or a PTY) in raw mode.
+ */
+static int Mirror_OpenPort( const char *path, unsigned baud )
+{
+    int fd = open( path, O_RDONLY | O_NOCTTY );
+    if( fd < 0 )
+    {
+        fprintf( stderr, "%s: %s\n", path, strerror( errno ) );
+        return -1;
+    }
+
+    struct termios tio;
+    if( tcgetattr( fd, &tio ) == 0 )
+    {
+        cfmakeraw( &tio );
+        speed_t speed = Mirror_BaudConstant( baud );
+        if( speed != 0 )
+        {
+            cfsetispeed( &tio, speed );
+            cfsetospeed( &tio, speed );
+        }
+        tcsetattr( fd, TCSANOW, &tio );
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Draws the matrix and the status line.
+ */
+static void Mirror_Draw( void )
+{
+    printf( "\033[H" );
+
+    for( unsigned row = 0; row < ICLED_ROWS; row++ )
+    {
+        for( unsigned col = 0; col < ICLED_COLUMNS; col++ )
+        {
+            const uint8_t *grb = &frame[( col * ICLED_ROWS + row ) * 3];
+            printf( "\033[48;2;%u;%u;%um  ", grb[1], grb[0], grb[2] );
+        }
+        printf( "\033[0m\n" );
+    }
+
+    printf( "key %u, delta %u, lost %u, errors %u%s\033[K\n", keyframes, deltas, lost, errors,
+            synced ? "" : " (waiting for a key frame)" );
+    fflush( stdout );
+}
+
+/**
+ * @brief Applies a checked packet to the copy of the matrix.
+ */
+static void Mirror_Apply( void )
+{
+    uint8_t type = packet[2];
+    uint8_t seq = packet[3];
+    const uint8_t *payload = &packet[ICLED_MIRROR_HEADER];
+
+    if( have_seq && ( seq != next_seq ) )
+    {
+        lost += ( uint8_t )( seq - next_seq );
+        synced = false;
+    }
+    have_seq = true;
+    next_seq = ( uint8_t )( seq + 1 );
+
+    if( ( type == 'K' ) && ( length == MIRROR_BYTES ) )
+    {
+        memcpy( frame, payload, MIRROR_BYTES );
+        synced = true;
+        keyframes++;
+    }
+    else if( type == 'D' )
+    {
+        unsigned pixel = 0;
+
+        for( uint16_t i = 0; i + 2 <= length; )
+        {
+            unsigned count = payload[i + 1];
+
+            pixel += payload[i];
+            i += 2;
+
+            if( ( pixel + count > ICLED_LED_COUNT ) || ( i + count * 3 > length ) )
+            {
+                errors++;
+                synced = false;
+                return;
+            }
+
+            memcpy( &frame[pixel * 3], &payload[i], count * 3 );
+            pixel += count;
+            i += ( uint16_t )( count * 3 );
+        }
+        deltas++;
+    }
+    else
+    {
+        errors++;
+        return;
+    }
+
+    Mirror_Draw( );
+}
+
+/**
+ * @brief Feeds one received byte to the parser.
+ */
+static void Mirror_Parse( uint8_t byte )
+{
+    switch( state )
+    {
+        case STATE_SYNC_I:
+            if( byte == 'I' ) state = STATE_SYNC_M;
+            break;
+
+        case STATE_SYNC_M:
+            state = ( byte == 'M' ) ? STATE_HEADER : ( byte == 'I' ) ? STATE_SYNC_M : STATE_SYNC_I;
+            fill = 2;
+            break;
+
+        case STATE_HEADER:
+            packet[fill++] = byte;
+            if( fill == ICLED_MIRROR_HEADER )
+            {
+                length = ( uint16_t )( packet[4] | ( packet[5] << 8 ) );
+                if( length > MIRROR_BYTES )
+                {
+                    errors++;
+                    state = STATE_SYNC_I;
+                }
+                else
+                {
+                    state = ( length > 0 ) ? STATE_PAYLOAD : STATE_CHECKSUM;
+                }
+            }
+            break;
+
+        case STATE_PAYLOAD:
+            packet[fill++] = byte;
+            if( fill == ICLED_MIRROR_HEADER + length ) state = STATE_CHECKSUM;
+            break;
+
+        case STATE_CHECKSUM:
+        {
+            uint8_t sum = 0;
+            for( uint16_t i = 2; i < fill; i++ )
+            {
+                sum += packet[i];
+            }
+
+            if( sum == byte )
+            {
+                Mirror_Apply( );
+            }
+            else
+            {
+                errors++;
+                synced = false;
+            }
+            state = STATE_SYNC_I;
+            break;
+        }
+    }
+}
+
+int main( int argc, char **argv )
+{
+    unsigned baud = 115200;
+    int fd = STDIN_FILENO;
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "b:h" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 'b': baud = ( unsigned )atoi( optarg ); break;
+            default:
+                fprintf( stderr, "usage: %s [-b baud] [port]\n", argv[0] );
+                return 1;
+        }
+    }
+
+    if( ( optind < argc ) && ( ( fd = Mirror_OpenPort( argv[optind], baud ) ) < 0 ) ) return 1;
+
+    printf( "\033[2J" );
+    Mirror_Draw( );
+
+    uint8_t buffer[512];
+    ssize_t count;
+
+    while( ( count = read( fd, buffer, sizeof( buffer ) ) ) > 0 )
+    {
+        for( ssize_t i = 0; i < count; i++ )
+        {
+            Mirror_Parse( buffer[i] );
+        }
+    }
+
+    return 0;
+}
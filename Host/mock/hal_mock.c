@@ -0,0 +1,452 @@
+/**
+ * @file hal_mock.c
+ * @author MootSeeker
+ * @brief Host stand-in for the HAL functions used by the LED driver and the effects.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "main.h"
+#include "tim.h"
+#include "usart.h"
+
+#include "icled.h"
+#include "icled_telemetry.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+TIM_HandleTypeDef htim1;
+UART_HandleTypeDef huart2;
+
+/**
+ * @brief The telemetry block, plain memory on the host.
+ */
+volatile ICLED_Telemetry icled_telemetry;
+
+static DMA_HandleTypeDef hdma_usart2_rx;
+
+static HAL_Mock_TickMode tick_mode = HAL_MOCK_TICK_MANUAL;
+static uint32_t tick;
+static uint64_t start_ns;
+
+/**
+ * @brief Queued interrupt of the virtual time base.
+ */
+typedef struct
+{
+    uint64_t time;          ///< Simulated time in ns
+    uint64_t sequence;      ///< Queue order, breaks ties deterministically
+    HAL_Mock_Event event;
+    void *context;
+} HAL_Mock_Queued;
+
+static uint64_t virtual_ns;
+static HAL_Mock_Queued queue[HAL_MOCK_EVENTS];     ///< Binary min-heap on (time, sequence)
+static uint16_t queued;
+static uint64_t sequence;
+
+static uint32_t speed;
+static uint64_t pace_virtual_ns;
+static uint64_t pace_host_ns;
+
+/**
+ * @brief Bytes waiting to be sent on the simulated USART2 line.
+ */
+static struct
+{
+    uint8_t *data;
+    size_t size;
+    size_t head;
+    size_t tail;
+    uint64_t byte_ns;
+    bool busy;
+} uart_line;
+
+static HAL_Mock_FrameHook frame_hook;
+static bool pwm_running;
+static uint64_t pwm_done_ns;    ///< End of the running transfer (virtual mode)
+static uint8_t frame[ICLED_LED_COUNT * 3];
+
+static HAL_Mock_UartTxHook uart_tx_hook;
+static uint8_t *uart_rx_buffer;
+static uint16_t uart_rx_size;
+static volatile bool uart_received;
+static volatile int uart_last_seen = -1;
+
+static pthread_mutex_t irq_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void HAL_Mock_SetFrameHook( HAL_Mock_FrameHook hook )
+{
+    frame_hook = hook;
+}
+
+void HAL_Mock_SetTick( uint32_t value )
+{
+    tick = value;
+}
+
+static uint64_t HAL_Mock_HostNow( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( uint64_t )ts.tv_sec * 1000000000ULL + ( uint64_t )ts.tv_nsec;
+}
+
+void HAL_Mock_SetTickMode( HAL_Mock_TickMode mode )
+{
+    tick_mode = mode;
+    start_ns = HAL_Mock_HostNow( );
+    virtual_ns = 0;
+    queued = 0;
+    sequence = 0;
+    pace_virtual_ns = 0;
+    pace_host_ns = start_ns;
+}
+
+uint64_t HAL_Mock_Now( void )
+{
+    if( tick_mode == HAL_MOCK_TICK_VIRTUAL )
+    {
+        return virtual_ns;
+    }
+
+    return HAL_Mock_HostNow( );
+}
+
+void HAL_Mock_SetSpeed( uint32_t factor )
+{
+    speed = factor;
+    pace_virtual_ns = virtual_ns;
+    pace_host_ns = HAL_Mock_HostNow( );
+}
+
+/**
+ * @brief Holds the simulation back until the host clock caught up with the speed factor.
+ */
+static void HAL_Mock_Pace( void )
+{
+    if( speed == 0 ) return;
+
+    uint64_t due = pace_host_ns + ( virtual_ns - pace_virtual_ns ) / speed;
+    uint64_t now = HAL_Mock_HostNow( );
+
+    // sleeping below ~100 µs costs more than it paces
+    if( due > now + 100000ULL )
+    {
+        struct timespec ts = { ( time_t )( ( due - now ) / 1000000000ULL ), ( long )( ( due - now ) % 1000000000ULL ) };
+        nanosleep( &ts, NULL );
+    }
+}
+
+static bool HAL_Mock_Before( const HAL_Mock_Queued *a, const HAL_Mock_Queued *b )
+{
+    return ( a->time < b->time ) || ( ( a->time == b->time ) && ( a->sequence < b->sequence ) );
+}
+
+void HAL_Mock_Schedule( uint64_t delay_ns, HAL_Mock_Event event, void *context )
+{
+    if( queued == HAL_MOCK_EVENTS )
+    {
+        fprintf( stderr, "HAL mock: event queue full\n" );
+        abort( );
+    }
+
+    HAL_Mock_Queued item = { virtual_ns + delay_ns, sequence++, event, context };
+    uint16_t i = queued++;
+
+    while( i > 0 )
+    {
+        uint16_t parent = ( uint16_t )( ( i - 1 ) / 2 );
+        if( !HAL_Mock_Before( &item, &queue[parent] ) ) break;
+        queue[i] = queue[parent];
+        i = parent;
+    }
+    queue[i] = item;
+}
+
+static HAL_Mock_Queued HAL_Mock_Pop( void )
+{
+    HAL_Mock_Queued top = queue[0];
+    HAL_Mock_Queued last = queue[--queued];
+    uint16_t i = 0;
+
+    for( ;; )
+    {
+        uint16_t child = ( uint16_t )( 2 * i + 1 );
+        if( child >= queued ) break;
+        if( ( child + 1 < queued ) && HAL_Mock_Before( &queue[child + 1], &queue[child] ) ) child++;
+        if( !HAL_Mock_Before( &queue[child], &last ) ) break;
+        queue[i] = queue[child];
+        i = child;
+    }
+    queue[i] = last;
+
+    return top;
+}
+
+void HAL_Mock_Advance( uint64_t delay_ns )
+{
+    uint64_t until = virtual_ns + delay_ns;
+
+    while( ( queued > 0 ) && ( queue[0].time <= until ) )
+    {
+        HAL_Mock_Queued item = HAL_Mock_Pop( );
+        virtual_ns = item.time;
+        HAL_Mock_Pace( );
+        item.event( item.context );
+    }
+
+    virtual_ns = until;
+    HAL_Mock_Pace( );
+}
+
+void HAL_Mock_Lock( void )
+{
+    pthread_mutex_lock( &irq_lock );
+}
+
+void HAL_Mock_Unlock( void )
+{
+    pthread_mutex_unlock( &irq_lock );
+}
+
+uint32_t HAL_Mock_Cycles( void )
+{
+    return ( uint32_t )HAL_Mock_Now( );
+}
+
+uint32_t HAL_GetTick( void )
+{
+    if( tick_mode == HAL_MOCK_TICK_REALTIME )
+    {
+        return ( uint32_t )( ( HAL_Mock_HostNow( ) - start_ns ) / 1000000ULL );
+    }
+    if( tick_mode == HAL_MOCK_TICK_VIRTUAL )
+    {
+        return ( uint32_t )( virtual_ns / 1000000ULL );
+    }
+
+    return tick;
+}
+
+void HAL_Delay( uint32_t Delay )
+{
+    if( tick_mode == HAL_MOCK_TICK_REALTIME )
+    {
+        struct timespec ts = { ( time_t )( Delay / 1000 ), ( long )( Delay % 1000 ) * 1000000L };
+        nanosleep( &ts, NULL );
+        return;
+    }
+    if( tick_mode == HAL_MOCK_TICK_VIRTUAL )
+    {
+        HAL_Mock_Advance( ( uint64_t )Delay * 1000000ULL );
+        return;
+    }
+
+    tick += Delay;
+}
+
+void Error_Handler( void )
+{
+    fprintf( stderr, "Error_Handler\n" );
+    abort( );
+}
+
+/**
+ * @brief Transfer complete of the PWM DMA.
+ */
+static void HAL_Mock_PwmDone( void *context )
+{
+    // a stopped or restarted transfer leaves a stale event behind
+    if( !pwm_running || ( HAL_Mock_Now( ) < pwm_done_ns ) ) return;
+
+    pwm_running = false;
+    HAL_TIM_PWM_PulseFinishedCallback( ( TIM_HandleTypeDef * )context );
+}
+
+/**
+ * @brief Decodes the PWM compare values back into GRB bytes and passes them to the hook.
+ */
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA( TIM_HandleTypeDef *htim, uint32_t Channel, const uint32_t *pData, uint16_t Length )
+{
+    ( void )Channel;
+
+    if( Length < ICLED_TIMING_BITS ) return HAL_ERROR;
+
+    pwm_running = true;
+    pwm_done_ns = HAL_Mock_Now( );
+
+    // one PWM slot is 1.25 µs
+    if( tick_mode == HAL_MOCK_TICK_VIRTUAL )
+    {
+        pwm_done_ns += ( uint64_t )Length * 1250U;
+        HAL_Mock_Schedule( ( uint64_t )Length * 1250U, HAL_Mock_PwmDone, htim );
+    }
+    else
+    {
+        HAL_Mock_PwmDone( htim );
+    }
+
+    if( frame_hook == NULL ) return HAL_OK;
+
+    const uint16_t *pwm = ( const uint16_t * )pData;
+
+    for( uint16_t i = 0; i < ICLED_LED_COUNT * 3; i++ )
+    {
+        uint8_t value = 0;
+        for( uint8_t bit = 0; bit < 8; bit++ )
+        {
+            value = ( uint8_t )( ( value << 1 ) | ( *pwm++ == ICLED_PWM_1 ) );
+        }
+        frame[i] = value;
+    }
+
+    frame_hook( frame, ICLED_LED_COUNT );
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA( TIM_HandleTypeDef *htim, uint32_t Channel )
+{
+    ( void )htim;
+    ( void )Channel;
+
+    pwm_running = false;
+
+    return HAL_OK;
+}
+
+/**
+ * @brief Remaining count of the DMA, read with acquire so the written bytes are visible.
+ */
+uint32_t HAL_Mock_GetDmaCounter( DMA_HandleTypeDef *hdma )
+{
+    uint32_t counter = __atomic_load_n( &hdma->Counter, __ATOMIC_ACQUIRE );
+
+    if( ( hdma == &hdma_usart2_rx ) && uart_received )
+    {
+        // the byte before the next write position
+        uart_last_seen = ( int )( ( 2U * uart_rx_size - counter - 1U ) % uart_rx_size );
+    }
+
+    return counter;
+}
+
+HAL_StatusTypeDef HAL_UART_Init( UART_HandleTypeDef *huart )
+{
+    huart->hdmarx = &hdma_usart2_rx;
+    return HAL_OK;
+}
+
+/**
+ * @brief Starts the circular reception, bytes arrive through HAL_Mock_UartReceive().
+ */
+HAL_StatusTypeDef HAL_UART_Receive_DMA( UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size )
+{
+    if( ( pData == NULL ) || ( Size == 0 ) ) return HAL_ERROR;
+
+    huart->hdmarx = &hdma_usart2_rx;
+    uart_rx_buffer = pData;
+    uart_rx_size = Size;
+    __atomic_store_n( &hdma_usart2_rx.Counter, Size, __ATOMIC_RELEASE );
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit( UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout )
+{
+    ( void )huart;
+    ( void )Timeout;
+
+    if( uart_tx_hook != NULL )
+    {
+        uart_tx_hook( pData, Size );
+    }
+    return HAL_OK;
+}
+
+void HAL_Mock_SetUartTxHook( HAL_Mock_UartTxHook hook )
+{
+    uart_tx_hook = hook;
+}
+
+/**
+ * @brief Writes one byte like the circular DMA: at the current position, then count down and reload.
+ */
+int HAL_Mock_UartReceive( uint8_t value )
+{
+    if( uart_rx_size == 0 ) return -1;
+
+    uint32_t counter = __atomic_load_n( &hdma_usart2_rx.Counter, __ATOMIC_RELAXED );
+    int index = ( int )( uart_rx_size - counter );
+
+    uart_rx_buffer[index] = value;
+    uart_received = true;
+    counter = ( counter > 1 ) ? counter - 1 : uart_rx_size;
+    __atomic_store_n( &hdma_usart2_rx.Counter, counter, __ATOMIC_RELEASE );
+
+    return index;
+}
+
+/**
+ * @brief Receive event: the byte at the head of the line has its stop bit done.
+ */
+static void HAL_Mock_UartByte( void *context )
+{
+    ( void )context;
+
+    HAL_Mock_UartReceive( uart_line.data[uart_line.head++] );
+
+    if( uart_line.head == uart_line.tail )
+    {
+        uart_line.head = uart_line.tail = 0;
+        uart_line.busy = false;
+        return;
+    }
+
+    HAL_Mock_Schedule( uart_line.byte_ns, HAL_Mock_UartByte, NULL );
+}
+
+bool HAL_Mock_UartFeed( const uint8_t *data, size_t length, uint32_t baud )
+{
+    if( ( baud == 0 ) || ( tick_mode != HAL_MOCK_TICK_VIRTUAL ) ) return false;
+    if( length == 0 ) return true;
+
+    // compact, then grow the line buffer if the new bytes do not fit behind the queued ones
+    if( uart_line.head > 0 )
+    {
+        memmove( uart_line.data, uart_line.data + uart_line.head, uart_line.tail - uart_line.head );
+        uart_line.tail -= uart_line.head;
+        uart_line.head = 0;
+    }
+    if( uart_line.tail + length > uart_line.size )
+    {
+        size_t size = ( uart_line.tail + length ) * 2;
+        uint8_t *grown = realloc( uart_line.data, size );
+        if( grown == NULL ) return false;
+        uart_line.data = grown;
+        uart_line.size = size;
+    }
+
+    memcpy( uart_line.data + uart_line.tail, data, length );
+    uart_line.tail += length;
+    uart_line.byte_ns = 10ULL * 1000000000ULL / baud;
+
+    if( !uart_line.busy )
+    {
+        uart_line.busy = true;
+        HAL_Mock_Schedule( uart_line.byte_ns, HAL_Mock_UartByte, NULL );
+    }
+
+    return true;
+}
+
+int HAL_Mock_UartLastSeen( void )
+{
+    return uart_last_seen;
+}
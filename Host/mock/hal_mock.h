@@ -0,0 +1,140 @@
+/**
+ * @file hal_mock.h
+ * @author MootSeeker
+ * @brief Control interface of the host HAL stand-in.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#ifndef HAL_MOCK_H
+#define HAL_MOCK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum HAL_Mock_TickMode
+ * @brief Time base behind HAL_GetTick() and HAL_Delay().
+ */
+typedef enum
+{
+    HAL_MOCK_TICK_MANUAL = 0,   ///< HAL_Delay() only advances the tick, nothing waits
+    HAL_MOCK_TICK_REALTIME,     ///< Milliseconds since start, HAL_Delay() sleeps
+    HAL_MOCK_TICK_VIRTUAL       ///< Simulated time driven by the event queue, HAL_Delay() jumps ahead
+} HAL_Mock_TickMode;
+
+/**
+ * @def HAL_MOCK_EVENTS
+ * @brief Capacity of the event queue of the virtual time base.
+ */
+#define HAL_MOCK_EVENTS     256
+
+/**
+ * @brief Called with every frame the LED driver sends.
+ *
+ * @param grb  Pixel data decoded from the PWM buffer, 3 bytes per LED in GRB order.
+ * @param leds Number of LEDs.
+ */
+typedef void (*HAL_Mock_FrameHook)(const uint8_t *grb, uint16_t leds);
+
+/**
+ * @brief Installs the frame hook, NULL skips the PWM decoding.
+ */
+void HAL_Mock_SetFrameHook(HAL_Mock_FrameHook hook);
+
+/**
+ * @brief Sets the millisecond tick returned by HAL_GetTick() (manual mode).
+ */
+void HAL_Mock_SetTick(uint32_t tick);
+
+/**
+ * @brief Selects the time base, the default is HAL_MOCK_TICK_MANUAL.
+ */
+void HAL_Mock_SetTickMode(HAL_Mock_TickMode mode);
+
+/**
+ * @brief Current time in nanoseconds: simulated time in virtual mode, monotonic host time otherwise.
+ */
+uint64_t HAL_Mock_Now(void);
+
+/**
+ * @brief Interrupt stand-in, runs on the firmware thread when its time is reached.
+ */
+typedef void (*HAL_Mock_Event)(void *context);
+
+/**
+ * @brief Queues an event @p delay_ns after the current simulated time (virtual mode).
+ *
+ * Events with the same time run in the order they were queued, so a
+ * simulation gives the same result on every run.
+ */
+void HAL_Mock_Schedule(uint64_t delay_ns, HAL_Mock_Event event, void *context);
+
+/**
+ * @brief Lets @p delay_ns of simulated time pass and runs the events due in it.
+ *
+ * HAL_Delay() uses this in virtual mode, a simulated main loop calls it
+ * directly for the time it would spin.
+ */
+void HAL_Mock_Advance(uint64_t delay_ns);
+
+/**
+ * @brief Paces the virtual time base against the host clock.
+ *
+ * @param factor Simulated time per host time, e.g. 1000; 0 runs as fast as possible (default).
+ */
+void HAL_Mock_SetSpeed(uint32_t factor);
+
+/**
+ * @brief Called with the bytes the firmware sends on USART2.
+ */
+typedef void (*HAL_Mock_UartTxHook)(const uint8_t *data, uint16_t size);
+
+/**
+ * @brief Installs the USART2 transmit hook.
+ */
+void HAL_Mock_SetUartTxHook(HAL_Mock_UartTxHook hook);
+
+/**
+ * @brief Writes one received byte into the USART2 RX DMA buffer.
+ *
+ * Thread safe against the firmware side, like the DMA against the CPU.
+ *
+ * @return Index in the DMA buffer the byte was written to, -1 if no reception is running.
+ */
+int HAL_Mock_UartReceive(uint8_t value);
+
+/**
+ * @brief Sends bytes to USART2 in virtual mode, one receive event per byte at @p baud (8N1).
+ *
+ * The bytes queue up behind those of earlier calls, like on a serial line.
+ *
+ * @return false if the bytes could not be queued.
+ */
+bool HAL_Mock_UartFeed(const uint8_t *data, size_t length, uint32_t baud);
+
+/**
+ * @brief Index of the newest byte the firmware has seen through __HAL_DMA_GET_COUNTER().
+ *
+ * @return Buffer index, -1 if nothing was received yet.
+ */
+int HAL_Mock_UartLastSeen(void);
+
+/**
+ * @brief Stand-ins for __disable_irq() / __enable_irq().
+ */
+void HAL_Mock_Lock(void);
+void HAL_Mock_Unlock(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_MOCK_H */
@@ -0,0 +1,69 @@
+/**
+ * @file main.h
+ * @author MootSeeker
+ * @brief Host stand-in for Core/Inc/main.h, used to build the firmware modules on a PC.
+ *
+ * Provides the small part of the HAL the LED driver, the stream decoders and
+ * the effects use. How HAL_GetTick() and HAL_Delay() behave is selected with
+ * HAL_Mock_SetTickMode(); in virtual mode they run on simulated time.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hal_mock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+/**
+ * @brief DMA channel, only the remaining transfer count is modelled.
+ */
+typedef struct
+{
+    volatile uint32_t Counter;  ///< Like CNDTR, counts down and reloads in circular mode
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)   HAL_Mock_GetDmaCounter(__HANDLE__)
+
+/* Timing fields of the telemetry block count nanoseconds on the host */
+#define ICLED_TELEMETRY_CYCLES()    HAL_Mock_Cycles( )
+
+#define LD3_Pin         (1U << 3)
+#define S2_Pin          (1U << 4)
+
+#define __disable_irq()     HAL_Mock_Lock( )
+#define __enable_irq()      HAL_Mock_Unlock( )
+
+uint32_t HAL_Mock_GetDmaCounter(DMA_HandleTypeDef *hdma);
+uint32_t HAL_Mock_Cycles(void);
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+void Error_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
@@ -0,0 +1,41 @@
+/**
+ * @file tim.h
+ * @author MootSeeker
+ * @brief Host stand-in for Core/Inc/tim.h, the PWM DMA transfer ends in HAL_Mock.
+ *
+ * The transfer completes at once, in virtual mode after its wire time.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#ifndef __TIM_H__
+#define __TIM_H__
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TIM_CHANNEL_1   0x00000000U
+
+typedef struct
+{
+    uint32_t Channel;
+} TIM_HandleTypeDef;
+
+extern TIM_HandleTypeDef htim1;
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t Channel, const uint32_t *pData, uint16_t Length);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t Channel);
+
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_ErrorCallback(TIM_HandleTypeDef *htim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIM_H__ */
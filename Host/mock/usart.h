@@ -0,0 +1,45 @@
+/**
+ * @file usart.h
+ * @author MootSeeker
+ * @brief Host stand-in for Core/Inc/usart.h, USART2 is fed through HAL_Mock_UartReceive().
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#ifndef __USART_H__
+#define __USART_H__
+
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UART_OVERSAMPLING_16    0x00000000U
+#define UART_OVERSAMPLING_8     0x00008000U
+
+typedef struct
+{
+    uint32_t BaudRate;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct
+{
+    UART_InitTypeDef Init;
+    DMA_HandleTypeDef *hdmarx;
+} UART_HandleTypeDef;
+
+extern UART_HandleTypeDef huart2;
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USART_H__ */
@@ -0,0 +1,275 @@
+/**
+ * @file icled_sim.c
+ * @author MootSeeker
+ * @brief Runs the firmware main loop on simulated time, faster than real time.
+ *
+ * The HAL stand-in runs in virtual mode: HAL_Delay() jumps ahead instead of
+ * waiting and interrupts (button S2, USART2 bytes) come from its event queue.
+ * A 10 minute show takes a fraction of a second unpaced, or runs at a fixed
+ * factor such as 1000x. With the same options and seed every run gives the
+ * same frames, the printed checksum covers all pixels and their timestamps.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled.h"
+#include "icled_stream.h"
+#include "icled_interp.h"
+#include "example_app.h"
+#include "main.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_IDLE_NS     20000ULL    ///< Simulated time one idle pass of the main loop takes
+#define SIM_EFFECTS     16          ///< Upper bound for the number of demo effects
+
+static FILE *record;
+static int in_stream;
+
+static uint64_t checksum = 1469598103934665603ULL;  ///< FNV-1a over time and pixels of every frame
+static uint32_t stream_frames;
+static uint32_t effect_frames[SIM_EFFECTS];
+static uint8_t effects;
+static uint32_t presses;
+
+static uint64_t press_ns;
+
+static uint8_t *stream_data;
+static size_t stream_length;
+static uint32_t stream_baud = ICLED_STREAM_BAUDRATE;
+
+static void Sim_Hash( const void *data, size_t length )
+{
+    const uint8_t *bytes = data;
+
+    for( size_t i = 0; i < length; i++ )
+    {
+        checksum = ( checksum ^ bytes[i] ) * 1099511628211ULL;
+    }
+}
+
+/**
+ * @brief Frame hook of the mocked TIM1 DMA.
+ */
+static void Sim_Frame( const uint8_t *grb, uint16_t leds )
+{
+    uint64_t now = HAL_Mock_Now( );
+
+    Sim_Hash( &now, sizeof( now ) );
+    Sim_Hash( grb, ( size_t )leds * 3 );
+
+    if( in_stream )
+    {
+        stream_frames++;
+    }
+    else
+    {
+        effect_frames[example_app_get_effect( )]++;
+    }
+
+    if( record == NULL ) return;
+
+    fprintf( record, "%.6f %s ", now / 1e9, in_stream ? "stream" : "local" );
+    for( uint16_t i = 0; i < leds; i++ )
+    {
+        fprintf( record, "%02x%02x%02x", grb[i * 3 + 1], grb[i * 3 + 0], grb[i * 3 + 2] );
+    }
+    fputc( '\n', record );
+}
+
+/**
+ * @brief Button S2 interrupt, switches to the next effect and re-arms itself.
+ */
+static void Sim_Press( void *context )
+{
+    ( void )context;
+
+    presses++;
+    HAL_GPIO_EXTI_Callback( S2_Pin );
+    HAL_Mock_Schedule( press_ns, Sim_Press, NULL );
+}
+
+/**
+ * @brief Host starts streaming: the captured bytes go out on USART2.
+ */
+static void Sim_Stream( void *context )
+{
+    ( void )context;
+
+    if( !HAL_Mock_UartFeed( stream_data, stream_length, stream_baud ) )
+    {
+        fprintf( stderr, "cannot queue the stream\n" );
+    }
+}
+
+static bool Sim_Load( const char *path )
+{
+    FILE *file = fopen( path, "rb" );
+    if( file == NULL )
+    {
+        perror( path );
+        return false;
+    }
+
+    fseek( file, 0, SEEK_END );
+    long size = ftell( file );
+    rewind( file );
+
+    stream_data = malloc( size > 0 ? ( size_t )size : 1 );
+    stream_length = ( stream_data != NULL ) ? fread( stream_data, 1, ( size_t )size, file ) : 0;
+    fclose( file );
+
+    return stream_length > 0;
+}
+
+/**
+ * @brief Number of demo effects, probed through example_app_set_effect().
+ */
+static uint8_t Sim_EffectCount( void )
+{
+    uint8_t current = example_app_get_effect( );
+    uint8_t count = 0;
+
+    while( ( count < SIM_EFFECTS ) && example_app_set_effect( count ) ) count++;
+    example_app_set_effect( current );
+
+    return count;
+}
+
+static void Sim_Usage( const char *name )
+{
+    fprintf( stderr,
+             "usage: %s [options]\n"
+             "  -t SEC   simulated show length (default 600)\n"
+             "  -x N     speed, simulated time per host time; 0 = as fast as possible (default 0)\n"
+             "  -e N     first effect 0..%d (default 0)\n"
+             "  -c SEC   press S2 every SEC seconds, 0 = never (default 30)\n"
+             "  -i FILE  raw USART2 bytes (Adalight, TPM2, DDP) a host sends ...\n"
+             "  -a SEC   ... starting at this simulated time (default 10)\n"
+             "  -b BAUD  ... at this baud rate (default %u)\n"
+             "  -o FILE  record every frame: time in s, source, RGB hex per LED\n"
+             "  -q       no demo effects while idle\n"
+             "  -s SEED  seed of the effects' rand() (default 1)\n",
+             name, effects - 1, ICLED_STREAM_BAUDRATE );
+}
+
+int main( int argc, char **argv )
+{
+    double seconds = 600, cycle = 30, stream_at = 10;
+    unsigned speed = 0, effect = 0, seed = 1;
+    int demos = 1;
+    const char *input = NULL, *output = NULL;
+    int opt;
+
+    effects = Sim_EffectCount( );
+
+    while( ( opt = getopt( argc, argv, "t:x:e:c:i:a:b:o:qs:h" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 't': seconds = atof( optarg ); break;
+            case 'x': speed = ( unsigned )atoi( optarg ); break;
+            case 'e': effect = ( unsigned )atoi( optarg ); break;
+            case 'c': cycle = atof( optarg ); break;
+            case 'i': input = optarg; break;
+            case 'a': stream_at = atof( optarg ); break;
+            case 'b': stream_baud = ( uint32_t )atoi( optarg ); break;
+            case 'o': output = optarg; break;
+            case 'q': demos = 0; break;
+            case 's': seed = ( unsigned )atoi( optarg ); break;
+            default:  Sim_Usage( argv[0] ); return 1;
+        }
+    }
+
+    if( ( seconds <= 0 ) || ( stream_baud == 0 ) || !example_app_set_effect( ( uint8_t )effect ) )
+    {
+        Sim_Usage( argv[0] );
+        return 1;
+    }
+
+    if( ( input != NULL ) && !Sim_Load( input ) ) return 1;
+
+    if( output != NULL )
+    {
+        record = fopen( output, "w" );
+        if( record == NULL )
+        {
+            perror( output );
+            return 1;
+        }
+    }
+
+    srand( seed );
+
+    HAL_Mock_SetTickMode( HAL_MOCK_TICK_VIRTUAL );
+    HAL_Mock_SetSpeed( speed );
+    HAL_Mock_SetFrameHook( Sim_Frame );
+
+    if( cycle > 0 )
+    {
+        press_ns = ( uint64_t )( cycle * 1e9 );
+        HAL_Mock_Schedule( press_ns, Sim_Press, NULL );
+    }
+    if( input != NULL )
+    {
+        HAL_Mock_Schedule( ( uint64_t )( stream_at * 1e9 ), Sim_Stream, NULL );
+    }
+
+    struct timespec t0, t1;
+    clock_gettime( CLOCK_MONOTONIC, &t0 );
+
+    /* Same order as the USER CODE 2 section of main.c */
+    ICLED_Init( );
+    ICLED_Stream_Init( );
+
+    uint64_t end_ns = ( uint64_t )( seconds * 1e9 );
+
+    while( HAL_Mock_Now( ) < end_ns )
+    {
+        uint32_t shown = stream_frames;
+
+        in_stream = 1;
+        ICLED_Stream_Process( );
+        ICLED_Interp_Process( );
+        in_stream = 0;
+
+        if( !ICLED_Stream_IsActive( ) && demos )
+        {
+            example_app_run( );
+        }
+        else if( stream_frames == shown )
+        {
+            HAL_Mock_Advance( SIM_IDLE_NS );
+        }
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &t1 );
+    double host = ( t1.tv_sec - t0.tv_sec ) + ( t1.tv_nsec - t0.tv_nsec ) / 1e9;
+    double simulated = HAL_Mock_Now( ) / 1e9;
+
+    uint32_t local = 0;
+    printf( "simulated %.3f s in %.3f s host time (%.0fx), %u presses of S2\n", simulated, host, simulated / host, presses );
+    for( uint8_t i = 0; i < effects; i++ )
+    {
+        printf( "effect %u: %u frames\n", i, effect_frames[i] );
+        local += effect_frames[i];
+    }
+
+    ICLED_StreamStats stats;
+    ICLED_Stream_GetStats( &stats );
+    printf( "stream: %u frames (Adalight %u, TPM2 %u, DDP %u), %u bytes, %u errors\n",
+            stream_frames, stats.frames[ICLED_STREAM_ADALIGHT], stats.frames[ICLED_STREAM_TPM2], stats.frames[ICLED_STREAM_DDP],
+            stats.bytes, stats.errors );
+    printf( "frames: %u, checksum %016llx\n", local + stream_frames, ( unsigned long long )checksum );
+
+    if( record != NULL ) fclose( record );
+    free( stream_data );
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file icled_telemetry_dump.c
+ * @author MootSeeker
+ * @brief Prints a telemetry block read from the target by a debug probe.
+ *
+ * Usage: icled_telemetry [file]
+ *
+ * The file is a raw memory dump starting at ICLED_TELEMETRY_ADDRESS, e.g.
+ * `st-flash read telemetry.bin 0x10000000 512` or `dump binary memory` in
+ * GDB. Without a file the dump is read from stdin. A block of a newer layout
+ * is printed as far as this tool knows the fields.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#include "icled_telemetry.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DUMP_FIELD(name)    { #name, offsetof( ICLED_Telemetry, name ) }
+
+static const struct
+{
+    const char *name;
+    size_t offset;
+} dump_fields[] =
+{
+    DUMP_FIELD( boots ),
+    DUMP_FIELD( reset_flags ),
+    DUMP_FIELD( uptime_ms ),
+    DUMP_FIELD( frames ),
+    DUMP_FIELD( frames_completed ),
+    DUMP_FIELD( frames_dropped ),
+    DUMP_FIELD( dma_errors ),
+    DUMP_FIELD( encode_cycles ),
+    DUMP_FIELD( encode_cycles_max ),
+    DUMP_FIELD( transmit_cycles ),
+    DUMP_FIELD( uart_bytes ),
+    DUMP_FIELD( uart_frames ),
+    DUMP_FIELD( uart_errors ),
+    DUMP_FIELD( dmx_packets ),
+    DUMP_FIELD( dmx_frames ),
+    DUMP_FIELD( dmx_errors ),
+    DUMP_FIELD( spi_frames ),
+    DUMP_FIELD( spi_errors ),
+    DUMP_FIELD( i2c_writes ),
+    DUMP_FIELD( i2c_errors ),
+    DUMP_FIELD( cpu_load ),
+    DUMP_FIELD( headroom_us ),
+    DUMP_FIELD( ram_static ),
+    DUMP_FIELD( stack_hwm ),
+    DUMP_FIELD( start_errors ),
+    DUMP_FIELD( deadline_misses ),
+    DUMP_FIELD( stuck_states ),
+    DUMP_FIELD( recoveries ),
+    DUMP_FIELD( last_incident_ms ),
+};
+
+static const char *const dump_sources[ICLED_LATENCY_SOURCE_COUNT] = { "stream", "spi", "button" };
+
+/**
+ * @brief Little endian word of the dump, independent of the host byte order.
+ */
+static uint32_t Dump_Word( const uint8_t *data, size_t offset )
+{
+    return ( uint32_t )data[offset] | ( ( uint32_t )data[offset + 1] << 8 ) |
+           ( ( uint32_t )data[offset + 2] << 16 ) | ( ( uint32_t )data[offset + 3] << 24 );
+}
+
+int main( int argc, char **argv )
+{
+    FILE *file = stdin;
+    uint8_t data[1024];
+
+    if( argc > 2 )
+    {
+        fprintf( stderr, "usage: %s [file]\n", argv[0] );
+        return 2;
+    }
+
+    if( ( argc == 2 ) && ( ( file = fopen( argv[1], "rb" ) ) == NULL ) )
+    {
+        perror( argv[1] );
+        return 1;
+    }
+
+    size_t length = fread( data, 1, sizeof( data ), file );
+    if( file != stdin ) fclose( file );
+
+    if( ( length < 8 ) || ( Dump_Word( data, 0 ) != ICLED_TELEMETRY_MAGIC ) )
+    {
+        fprintf( stderr, "no telemetry block (magic missing, firmware not started or wrong address)\n" );
+        return 1;
+    }
+
+    uint16_t version = ( uint16_t )( Dump_Word( data, 4 ) & 0xFFFFU );
+    uint16_t size = ( uint16_t )( Dump_Word( data, 4 ) >> 16 );
+
+    printf( "%-20s %u\n", "version", version );
+    printf( "%-20s %u\n", "size", size );
+
+    if( version > ICLED_TELEMETRY_VERSION )
+    {
+        fprintf( stderr, "block version %u is newer than this tool (%u), printing the known fields\n",
+                 version, ICLED_TELEMETRY_VERSION );
+    }
+
+    for( size_t i = 0; i < sizeof( dump_fields ) / sizeof( dump_fields[0] ); i++ )
+    {
+        // the block only grows, older firmware simply ends earlier
+        if( ( dump_fields[i].offset + 4 > size ) || ( dump_fields[i].offset + 4 > length ) ) break;
+
+        uint32_t value = Dump_Word( data, dump_fields[i].offset );
+
+        if( strcmp( dump_fields[i].name, "reset_flags" ) == 0 )
+        {
+            printf( "%-20s 0x%08X\n", dump_fields[i].name, value );
+        }
+        else
+        {
+            printf( "%-20s %u\n", dump_fields[i].name, value );
+        }
+    }
+
+    // latency per input source, one line of figures and one of histogram buckets
+    for( size_t s = 0; s < ICLED_LATENCY_SOURCE_COUNT; s++ )
+    {
+        size_t base = offsetof( ICLED_Telemetry, latency ) + s * sizeof( ICLED_TelemetryLatency );
+
+        if( ( base + sizeof( ICLED_TelemetryLatency ) > size ) || ( base + sizeof( ICLED_TelemetryLatency ) > length ) ) break;
+
+        printf( "latency.%-12s samples %u, last %u us, max %u us (input to render %u us, render to DMA start %u us)\n",
+                dump_sources[s], Dump_Word( data, base + offsetof( ICLED_TelemetryLatency, samples ) ),
+                Dump_Word( data, base + offsetof( ICLED_TelemetryLatency, last_us ) ),
+                Dump_Word( data, base + offsetof( ICLED_TelemetryLatency, max_us ) ),
+                Dump_Word( data, base + offsetof( ICLED_TelemetryLatency, render_us ) ),
+                Dump_Word( data, base + offsetof( ICLED_TelemetryLatency, start_us ) ) );
+
+        printf( "%-20s", "" );
+        for( uint32_t b = 0; b < ICLED_LATENCY_BUCKETS; b++ )
+        {
+            uint32_t bound = ICLED_LATENCY_BUCKET_US << ( ( b < ICLED_LATENCY_BUCKETS - 1 ) ? b : b - 1 );
+            uint32_t count = Dump_Word( data, base + offsetof( ICLED_TelemetryLatency, histogram ) + b * 4 );
+
+            printf( " %s%u%s:%u", ( b < ICLED_LATENCY_BUCKETS - 1 ) ? "<" : ">=",
+                    ( bound < 1000 ) ? bound : bound / 1000, ( bound < 1000 ) ? "us" : "ms", count );
+        }
+        printf( "\n" );
+    }
+
+    return 0;
+}
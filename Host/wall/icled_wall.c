@@ -0,0 +1,735 @@
+/**
+ * @file icled_wall.c
+ * @author MootSeeker
+ * @brief Renders a wall of ICLED panels on the PC and streams it to one controller per panel.
+ *
+ * The firmware effects (Examples/example_app.c) and the LED driver
+ * (Core/Src/icled.c) are built for the host against the HAL stand-in in
+ * Host/mock. One effect step renders the 15x7 source, which is scaled up to
+ * a canvas of grid_cols x grid_rows panels. A thread pool then handles one
+ * controller per job: render its slice of the canvas, compare it with the
+ * last frame sent to that controller and send only the changed pixel runs as
+ * DDP packets (decoded by icled_stream.c, the last packet carries PUSH).
+ * A full frame goes out at least every keepalive interval.
+ *
+ * Controllers are serial ports (the ST-LINK VCP of each board) or PTYs: with
+ * -p the tool creates its own PTY pairs and drains them, so it runs without
+ * any hardware. The timing of every stage is reported at the end.
+ *
+ * @copyright (c) 2025 MootSeeker
+ * @license MIT License
+ *
+ */
+
+#define _GNU_SOURCE
+
+#include "icled.h"
+#include "example_app.h"
+#include "main.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PANEL_COLS          15
+#define PANEL_ROWS          7
+#define PANEL_BYTES         (ICLED_LED_COUNT * 3)
+
+#define DDP_FLAGS_V1        0x40
+#define DDP_FLAG_PUSH       0x01
+#define DDP_TYPE_RGB8       0x0B
+#define DDP_ID_DISPLAY      1
+#define DDP_HEADER_LEN      10
+
+#define RUN_MERGE_GAP       4       ///< Unchanged pixels cheaper to resend than a new 10 byte header
+#define MAX_CONTROLLERS     256
+
+/**
+ * @enum Stage
+ * @brief Measured stages of the pipeline.
+ */
+typedef enum
+{
+    STAGE_EFFECT = 0,   ///< Firmware effect steps (main thread)
+    STAGE_RENDER,       ///< Scaling the source into a slice (per controller)
+    STAGE_ENCODE,       ///< Delta detection and DDP packets (per controller)
+    STAGE_WRITE,        ///< write() to the port (per controller)
+    STAGE_SLICES,       ///< Wall time of the parallel part
+    STAGE_FRAME,        ///< Wall time of the whole frame without pacing
+    STAGE_COUNT
+} Stage;
+
+static const char *stage_names[STAGE_COUNT] = { "effect", "render", "encode", "write", "slices", "frame" };
+
+/**
+ * @struct Timing
+ * @brief Accumulated durations of one stage.
+ */
+typedef struct
+{
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint64_t count;
+} Timing;
+
+/**
+ * @struct Controller
+ * @brief One panel of the wall and its port.
+ */
+typedef struct
+{
+    int fd;                                     ///< Serial port or PTY slave
+    int pty_master;                             ///< Drained side of an own PTY, -1 for real ports
+    char name[64];
+    uint16_t x0;                                ///< Position of the slice on the canvas
+    uint16_t y0;
+    uint8_t slice[PANEL_BYTES];                 ///< RGB in LED index order
+    uint8_t last[PANEL_BYTES];                  ///< Slice as last sent
+    uint8_t packet[PANEL_BYTES + 8 * DDP_HEADER_LEN * 4];
+    uint16_t packet_len;
+    uint64_t last_full_ns;
+    uint8_t sequence;
+    uint64_t bytes_sent;
+    uint64_t bytes_raw;                         ///< Bytes full frames would have needed
+    uint32_t write_errors;
+    Timing timing[STAGE_COUNT];
+} __attribute__( ( aligned( 64 ) ) ) Controller;
+
+/**
+ * @struct Pool
+ * @brief Fixed set of worker threads that run one job per controller.
+ */
+typedef struct
+{
+    pthread_t threads[64];
+    unsigned count;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    unsigned generation;
+    unsigned next_job;
+    unsigned jobs;
+    unsigned pending;
+    void ( *job )( unsigned index );
+    int stop;
+} Pool;
+
+static Controller controllers[MAX_CONTROLLERS];
+static unsigned controller_count;
+
+static unsigned grid_cols = 2;
+static unsigned grid_rows = 2;
+static unsigned canvas_width;
+static unsigned canvas_height;
+
+static uint8_t source[PANEL_COLS * PANEL_ROWS * 3];     ///< RGB of the effect, row major
+static uint64_t keepalive_ns = 1000000000ULL;
+static uint64_t now_ns;
+
+static volatile int drain_stop;
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ */
+static uint64_t Wall_Now( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( uint64_t )ts.tv_sec * 1000000000ULL + ( uint64_t )ts.tv_nsec;
+}
+
+static void Timing_Add( Timing *timing, uint64_t ns )
+{
+    timing->total_ns += ns;
+    timing->count++;
+    if( ns > timing->max_ns ) timing->max_ns = ns;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Thread pool                                                               */
+/* ------------------------------------------------------------------------- */
+
+static void *Pool_Worker( void *arg )
+{
+    Pool *pool = arg;
+    unsigned seen = 0;
+
+    pthread_mutex_lock( &pool->lock );
+    for( ;; )
+    {
+        while( !pool->stop && ( pool->generation == seen ) )
+        {
+            pthread_cond_wait( &pool->start, &pool->lock );
+        }
+        if( pool->stop ) break;
+        seen = pool->generation;
+
+        while( pool->next_job < pool->jobs )
+        {
+            unsigned index = pool->next_job++;
+
+            pthread_mutex_unlock( &pool->lock );
+            pool->job( index );
+            pthread_mutex_lock( &pool->lock );
+
+            if( --pool->pending == 0 )
+            {
+                pthread_cond_signal( &pool->done );
+            }
+        }
+    }
+    pthread_mutex_unlock( &pool->lock );
+
+    return NULL;
+}
+
+static void Pool_Init( Pool *pool, unsigned count )
+{
+    memset( pool, 0, sizeof( *pool ) );
+    pthread_mutex_init( &pool->lock, NULL );
+    pthread_cond_init( &pool->start, NULL );
+    pthread_cond_init( &pool->done, NULL );
+
+    pool->count = count;
+    for( unsigned i = 0; i < count; i++ )
+    {
+        pthread_create( &pool->threads[i], NULL, Pool_Worker, pool );
+    }
+}
+
+/**
+ * @brief Runs job(0) … job(jobs - 1) on the workers and waits for all of them.
+ */
+static void Pool_Run( Pool *pool, unsigned jobs, void ( *job )( unsigned index ) )
+{
+    pthread_mutex_lock( &pool->lock );
+    pool->job = job;
+    pool->jobs = jobs;
+    pool->next_job = 0;
+    pool->pending = jobs;
+    pool->generation++;
+    pthread_cond_broadcast( &pool->start );
+
+    while( pool->pending > 0 )
+    {
+        pthread_cond_wait( &pool->done, &pool->lock );
+    }
+    pthread_mutex_unlock( &pool->lock );
+}
+
+static void Pool_Stop( Pool *pool )
+{
+    pthread_mutex_lock( &pool->lock );
+    pool->stop = 1;
+    pthread_cond_broadcast( &pool->start );
+    pthread_mutex_unlock( &pool->lock );
+
+    for( unsigned i = 0; i < pool->count; i++ )
+    {
+        pthread_join( pool->threads[i], NULL );
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/* Ports                                                                     */
+/* ------------------------------------------------------------------------- */
+
+static speed_t Wall_BaudConstant( unsigned baud )
+{
+    switch( baud )
+    {
+        case 115200:  return B115200;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 921600:  return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        default:      return 0;
+    }
+}
+
+/**
+ * @brief Opens a serial port (or an existing PTY) in raw mode.
+ */
+static int Wall_OpenPort( Controller *ctrl, const char *path, unsigned baud )
+{
+    int fd = open( path, O_RDWR | O_NOCTTY );
+    if( fd < 0 )
+    {
+        fprintf( stderr, "%s: %s\n", path, strerror( errno ) );
+        return -1;
+    }
+
+    struct termios tio;
+    if( tcgetattr( fd, &tio ) == 0 )
+    {
+        cfmakeraw( &tio );
+        speed_t speed = Wall_BaudConstant( baud );
+        if( speed != 0 )
+        {
+            cfsetispeed( &tio, speed );
+            cfsetospeed( &tio, speed );
+        }
+        tcsetattr( fd, TCSANOW, &tio );
+    }
+
+    ctrl->fd = fd;
+    ctrl->pty_master = -1;
+    snprintf( ctrl->name, sizeof( ctrl->name ), "%s", path );
+    return 0;
+}
+
+/**
+ * @brief Creates a PTY pair, the tool writes to the slave and drains the master.
+ */
+static int Wall_OpenPty( Controller *ctrl )
+{
+    int master = posix_openpt( O_RDWR | O_NOCTTY );
+    if( ( master < 0 ) || ( grantpt( master ) != 0 ) || ( unlockpt( master ) != 0 ) )
+    {
+        perror( "posix_openpt" );
+        return -1;
+    }
+
+    const char *path = ptsname( master );
+    if( ( path == NULL ) || ( Wall_OpenPort( ctrl, path, 0 ) != 0 ) )
+    {
+        close( master );
+        return -1;
+    }
+
+    ctrl->pty_master = master;
+    return 0;
+}
+
+/**
+ * @brief Reads and drops everything written to the own PTYs, like a controller would consume it.
+ */
+static void *Wall_Drain( void *arg )
+{
+    ( void )arg;
+
+    struct pollfd fds[MAX_CONTROLLERS];
+    unsigned count = 0;
+    static uint8_t scratch[4096];
+
+    for( unsigned i = 0; i < controller_count; i++ )
+    {
+        if( controllers[i].pty_master >= 0 )
+        {
+            fds[count].fd = controllers[i].pty_master;
+            fds[count].events = POLLIN;
+            count++;
+        }
+    }
+
+    while( !drain_stop && ( count > 0 ) )
+    {
+        if( poll( fds, count, 100 ) <= 0 ) continue;
+
+        for( unsigned i = 0; i < count; i++ )
+        {
+            if( fds[i].revents & POLLIN )
+            {
+                ( void )!read( fds[i].fd, scratch, sizeof( scratch ) );
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Pipeline                                                                  */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief Copies the effect output (GRB, column major) into the RGB source image.
+ */
+static void Wall_CaptureSource( void )
+{
+    const uint8_t *grb = ICLED_GetBuffer( );
+
+    for( unsigned col = 0; col < PANEL_COLS; col++ )
+    {
+        for( unsigned row = 0; row < PANEL_ROWS; row++ )
+        {
+            const uint8_t *led = &grb[( col * PANEL_ROWS + row ) * 3];
+            uint8_t *px = &source[( row * PANEL_COLS + col ) * 3];
+
+            px[0] = led[1];
+            px[1] = led[0];
+            px[2] = led[2];
+        }
+    }
+}
+
+/**
+ * @brief Bilinear sample of the source at canvas position x, y (8.8 fixed point mapping).
+ */
+static void Wall_Sample( unsigned x, unsigned y, uint8_t *rgb )
+{
+    // centre of the canvas pixel mapped onto the source grid
+    int32_t sx = ( int32_t )( ( ( 2 * x + 1 ) * PANEL_COLS * 256 ) / ( 2 * canvas_width ) ) - 128;
+    int32_t sy = ( int32_t )( ( ( 2 * y + 1 ) * PANEL_ROWS * 256 ) / ( 2 * canvas_height ) ) - 128;
+
+    if( sx < 0 ) sx = 0;
+    if( sy < 0 ) sy = 0;
+
+    int32_t x0 = sx >> 8, y0 = sy >> 8;
+    int32_t fx = sx & 0xFF, fy = sy & 0xFF;
+    int32_t x1 = ( x0 + 1 < PANEL_COLS ) ? x0 + 1 : x0;
+    int32_t y1 = ( y0 + 1 < PANEL_ROWS ) ? y0 + 1 : y0;
+
+    const uint8_t *p00 = &source[( y0 * PANEL_COLS + x0 ) * 3];
+    const uint8_t *p01 = &source[( y0 * PANEL_COLS + x1 ) * 3];
+    const uint8_t *p10 = &source[( y1 * PANEL_COLS + x0 ) * 3];
+    const uint8_t *p11 = &source[( y1 * PANEL_COLS + x1 ) * 3];
+
+    for( int c = 0; c < 3; c++ )
+    {
+        int32_t top = p00[c] * ( 256 - fx ) + p01[c] * fx;
+        int32_t bottom = p10[c] * ( 256 - fx ) + p11[c] * fx;
+        rgb[c] = ( uint8_t )( ( top * ( 256 - fy ) + bottom * fy ) >> 16 );
+    }
+}
+
+/**
+ * @brief Renders the slice of one controller in LED index order.
+ */
+static void Wall_Render( Controller *ctrl )
+{
+    for( unsigned col = 0; col < PANEL_COLS; col++ )
+    {
+        for( unsigned row = 0; row < PANEL_ROWS; row++ )
+        {
+            Wall_Sample( ctrl->x0 + col, ctrl->y0 + row, &ctrl->slice[( col * PANEL_ROWS + row ) * 3] );
+        }
+    }
+}
+
+/**
+ * @brief Appends one DDP packet with the pixels [first, first + count).
+ */
+static void Wall_AppendPacket( Controller *ctrl, unsigned first, unsigned count, int push )
+{
+    uint8_t *p = &ctrl->packet[ctrl->packet_len];
+    uint32_t offset = first * 3;
+    uint16_t length = ( uint16_t )( count * 3 );
+
+    p[0] = DDP_FLAGS_V1 | ( push ? DDP_FLAG_PUSH : 0 );
+    p[1] = ctrl->sequence;
+    p[2] = DDP_TYPE_RGB8;
+    p[3] = DDP_ID_DISPLAY;
+    p[4] = ( uint8_t )( offset >> 24 );
+    p[5] = ( uint8_t )( offset >> 16 );
+    p[6] = ( uint8_t )( offset >> 8 );
+    p[7] = ( uint8_t )( offset );
+    p[8] = ( uint8_t )( length >> 8 );
+    p[9] = ( uint8_t )( length );
+    memcpy( &p[DDP_HEADER_LEN], &ctrl->slice[offset], length );
+
+    ctrl->packet_len += DDP_HEADER_LEN + length;
+}
+
+/**
+ * @brief Builds the DDP packets for the pixels that changed since the last frame.
+ *
+ * Changed pixels closer than RUN_MERGE_GAP are merged into one run. If the
+ * runs together are not smaller than a full frame, a full frame is sent.
+ */
+static void Wall_Encode( Controller *ctrl )
+{
+    unsigned starts[ICLED_LED_COUNT], ends[ICLED_LED_COUNT];
+    unsigned runs = 0;
+    unsigned bytes = 0;
+
+    ctrl->packet_len = 0;
+    ctrl->sequence = ( uint8_t )( ( ctrl->sequence % 15 ) + 1 );  // 1..15, 0 means "no sequence"
+
+    for( unsigned i = 0; i < ICLED_LED_COUNT; i++ )
+    {
+        if( memcmp( &ctrl->slice[i * 3], &ctrl->last[i * 3], 3 ) == 0 ) continue;
+
+        if( ( runs > 0 ) && ( i - ends[runs - 1] <= RUN_MERGE_GAP ) )
+        {
+            ends[runs - 1] = i + 1;
+        }
+        else
+        {
+            starts[runs] = i;
+            ends[runs] = i + 1;
+            runs++;
+        }
+    }
+
+    for( unsigned r = 0; r < runs; r++ )
+    {
+        bytes += DDP_HEADER_LEN + ( ends[r] - starts[r] ) * 3;
+    }
+
+    int keepalive = ( now_ns - ctrl->last_full_ns ) >= keepalive_ns;
+
+    if( keepalive || ( bytes >= DDP_HEADER_LEN + PANEL_BYTES ) )
+    {
+        Wall_AppendPacket( ctrl, 0, ICLED_LED_COUNT, 1 );
+        ctrl->last_full_ns = now_ns;
+    }
+    else
+    {
+        for( unsigned r = 0; r < runs; r++ )
+        {
+            Wall_AppendPacket( ctrl, starts[r], ends[r] - starts[r], r == runs - 1 );
+        }
+    }
+
+    memcpy( ctrl->last, ctrl->slice, PANEL_BYTES );
+    ctrl->bytes_raw += DDP_HEADER_LEN + PANEL_BYTES;
+}
+
+/**
+ * @brief Writes the packets of this frame, blocking at the speed of the port.
+ */
+static void Wall_Write( Controller *ctrl )
+{
+    uint16_t done = 0;
+
+    while( done < ctrl->packet_len )
+    {
+        ssize_t n = write( ctrl->fd, &ctrl->packet[done], ctrl->packet_len - done );
+        if( n < 0 )
+        {
+            if( errno == EINTR ) continue;
+            ctrl->write_errors++;
+            return;
+        }
+        done += ( uint16_t )n;
+    }
+
+    ctrl->bytes_sent += done;
+}
+
+/**
+ * @brief Pool job: render, encode and send the slice of one controller.
+ */
+static void Wall_ControllerJob( unsigned index )
+{
+    Controller *ctrl = &controllers[index];
+    uint64_t t0 = Wall_Now( );
+
+    Wall_Render( ctrl );
+    uint64_t t1 = Wall_Now( );
+
+    Wall_Encode( ctrl );
+    uint64_t t2 = Wall_Now( );
+
+    Wall_Write( ctrl );
+    uint64_t t3 = Wall_Now( );
+
+    Timing_Add( &ctrl->timing[STAGE_RENDER], t1 - t0 );
+    Timing_Add( &ctrl->timing[STAGE_ENCODE], t2 - t1 );
+    Timing_Add( &ctrl->timing[STAGE_WRITE], t3 - t2 );
+}
+
+/* ------------------------------------------------------------------------- */
+/* Report                                                                    */
+/* ------------------------------------------------------------------------- */
+
+static void Wall_Report( const Timing *main_timing, uint64_t elapsed_ns, unsigned frames, unsigned threads )
+{
+    Timing sum[STAGE_COUNT];
+    uint64_t sent = 0, raw = 0;
+    uint32_t errors = 0;
+
+    memcpy( sum, main_timing, sizeof( sum ) );
+
+    for( unsigned i = 0; i < controller_count; i++ )
+    {
+        for( unsigned s = STAGE_RENDER; s <= STAGE_WRITE; s++ )
+        {
+            sum[s].total_ns += controllers[i].timing[s].total_ns;
+            sum[s].count += controllers[i].timing[s].count;
+            if( controllers[i].timing[s].max_ns > sum[s].max_ns ) sum[s].max_ns = controllers[i].timing[s].max_ns;
+        }
+        sent += controllers[i].bytes_sent;
+        raw += controllers[i].bytes_raw;
+        errors += controllers[i].write_errors;
+    }
+
+    printf( "\n%u controllers (%ux%u panels, canvas %ux%u), %u threads, %u frames in %.2f s = %.1f fps\n",
+            controller_count, grid_cols, grid_rows, canvas_width, canvas_height, threads,
+            frames, elapsed_ns / 1e9, frames / ( elapsed_ns / 1e9 ) );
+    printf( "%-8s %10s %10s %12s\n", "stage", "avg us", "max us", "us/frame" );
+
+    for( unsigned s = 0; s < STAGE_COUNT; s++ )
+    {
+        if( sum[s].count == 0 ) continue;
+        printf( "%-8s %10.1f %10.1f %12.1f\n", stage_names[s],
+                sum[s].total_ns / 1e3 / sum[s].count, sum[s].max_ns / 1e3,
+                sum[s].total_ns / 1e3 / ( frames ? frames : 1 ) );
+    }
+
+    printf( "sent %llu bytes, %.1f %% of full frames, %u write errors\n",
+            ( unsigned long long )sent, raw ? 100.0 * sent / raw : 0.0, errors );
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void Wall_Usage( const char *name )
+{
+    fprintf( stderr,
+             "usage: %s [options] [port ...]\n"
+             "  -g CxR   panels per row and rows (default 2x2), one controller each\n"
+             "  -p       create PTYs for controllers without a port\n"
+             "  -e N     firmware effect 0..4 (default 0)\n"
+             "  -f FPS   frame rate, 0 = as fast as possible (default 60)\n"
+             "  -n N     number of frames (default 600)\n"
+             "  -t N     worker threads (default: number of CPUs)\n"
+             "  -b BAUD  baud rate of real serial ports (default 115200)\n"
+             "  -k MS    full frame at least every MS milliseconds (default 1000)\n"
+             "  -s SEED  seed of the effects' rand() (default 1)\n",
+             name );
+}
+
+int main( int argc, char **argv )
+{
+    unsigned effect = 0, fps = 60, frames = 600, baud = 115200, seed = 1;
+    long cpus = sysconf( _SC_NPROCESSORS_ONLN );
+    unsigned threads = ( cpus > 0 ) ? ( unsigned )cpus : 1;
+    int make_ptys = 0;
+    int opt;
+
+    while( ( opt = getopt( argc, argv, "g:pe:f:n:t:b:k:s:h" ) ) != -1 )
+    {
+        switch( opt )
+        {
+            case 'g':
+                if( sscanf( optarg, "%ux%u", &grid_cols, &grid_rows ) != 2 ) { Wall_Usage( argv[0] ); return 1; }
+                break;
+            case 'p': make_ptys = 1; break;
+            case 'e': effect = ( unsigned )atoi( optarg ); break;
+            case 'f': fps = ( unsigned )atoi( optarg ); break;
+            case 'n': frames = ( unsigned )atoi( optarg ); break;
+            case 't': threads = ( unsigned )atoi( optarg ); break;
+            case 'b': baud = ( unsigned )atoi( optarg ); break;
+            case 'k': keepalive_ns = ( uint64_t )atoi( optarg ) * 1000000ULL; break;
+            case 's': seed = ( unsigned )atoi( optarg ); break;
+            default:  Wall_Usage( argv[0] ); return 1;
+        }
+    }
+
+    controller_count = grid_cols * grid_rows;
+    if( ( controller_count == 0 ) || ( controller_count > MAX_CONTROLLERS ) )
+    {
+        fprintf( stderr, "1 to %d controllers\n", MAX_CONTROLLERS );
+        return 1;
+    }
+    if( threads < 1 ) threads = 1;
+    if( threads > 64 ) threads = 64;
+
+    canvas_width = grid_cols * PANEL_COLS;
+    canvas_height = grid_rows * PANEL_ROWS;
+
+    for( unsigned i = 0; i < controller_count; i++ )
+    {
+        Controller *ctrl = &controllers[i];
+        int result;
+
+        ctrl->x0 = ( uint16_t )( ( i % grid_cols ) * PANEL_COLS );
+        ctrl->y0 = ( uint16_t )( ( i / grid_cols ) * PANEL_ROWS );
+
+        if( optind + ( int )i < argc )
+        {
+            result = Wall_OpenPort( ctrl, argv[optind + i], baud );
+        }
+        else if( make_ptys )
+        {
+            result = Wall_OpenPty( ctrl );
+        }
+        else
+        {
+            fprintf( stderr, "%u controllers need %u ports (or -p)\n", controller_count, controller_count );
+            return 1;
+        }
+        if( result != 0 ) return 1;
+
+        printf( "panel %u,%u -> %s\n", i % grid_cols, i / grid_cols, ctrl->name );
+    }
+
+    pthread_t drain;
+    pthread_create( &drain, NULL, Wall_Drain, NULL );
+
+    Pool pool;
+    Pool_Init( &pool, threads );
+
+    srand( seed );
+    ICLED_Init( );
+    if( !example_app_set_effect( ( uint8_t )effect ) )
+    {
+        fprintf( stderr, "no effect %u\n", effect );
+        return 1;
+    }
+
+    Timing main_timing[STAGE_COUNT];
+    memset( main_timing, 0, sizeof( main_timing ) );
+
+    uint64_t start = Wall_Now( );
+    uint64_t effect_ms = 0;
+
+    for( unsigned frame = 0; frame < frames; frame++ )
+    {
+        uint64_t t0 = Wall_Now( );
+        now_ns = t0;
+
+        // advance the effect to the time of this frame, at least one step
+        uint64_t frame_ms = fps ? ( uint64_t )frame * 1000 / fps : effect_ms;
+        do
+        {
+            example_app_run( );
+            effect_ms = HAL_GetTick( );
+        } while( effect_ms < frame_ms );
+        Wall_CaptureSource( );
+
+        uint64_t t1 = Wall_Now( );
+        Pool_Run( &pool, controller_count, Wall_ControllerJob );
+        uint64_t t2 = Wall_Now( );
+
+        Timing_Add( &main_timing[STAGE_EFFECT], t1 - t0 );
+        Timing_Add( &main_timing[STAGE_SLICES], t2 - t1 );
+        Timing_Add( &main_timing[STAGE_FRAME], t2 - t0 );
+
+        if( fps )
+        {
+            uint64_t deadline = start + ( uint64_t )( frame + 1 ) * 1000000000ULL / fps;
+            uint64_t now = Wall_Now( );
+            if( deadline > now )
+            {
+                struct timespec ts = { ( time_t )( ( deadline - now ) / 1000000000ULL ), ( long )( ( deadline - now ) % 1000000000ULL ) };
+                nanosleep( &ts, NULL );
+            }
+        }
+    }
+
+    uint64_t elapsed = Wall_Now( ) - start;
+
+    Pool_Stop( &pool );
+    drain_stop = 1;
+    pthread_join( drain, NULL );
+
+    Wall_Report( main_timing, elapsed, frames, threads );
+
+    for( unsigned i = 0; i < controller_count; i++ )
+    {
+        close( controllers[i].fd );
+        if( controllers[i].pty_master >= 0 ) close( controllers[i].pty_master );
+    }
+
+    return 0;
+}